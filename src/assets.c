@@ -0,0 +1,191 @@
+#include "assets.h"
+#include "hpak.h"
+#include "mapfile.h"
+#include "lz4blk.h"
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+static MapFile  g_pack;
+static const HpakHeader* g_hdr = NULL;
+static const HpakSlot*   g_slots = NULL;
+static Uint64   g_pack_mtime = 0;
+static char     g_base[512];          // SDL_GetBasePath() — один раз, без алокацій на кожен файл
+static bool     g_base_ready = false;
+static SDL_atomic_t g_from_pack, g_from_disk;
+
+static void ensure_base(void) {
+    if (g_base_ready) return;
+    char* base = SDL_GetBasePath();
+    SDL_snprintf(g_base, sizeof(g_base), "%s", base ? base : "");
+    SDL_free(base);
+    g_base_ready = true;
+}
+
+bool assets_open_pack(const char* file) {
+    ensure_base();
+    char path[600];
+    if (file) SDL_snprintf(path, sizeof(path), "%s", file);
+    else      SDL_snprintf(path, sizeof(path), "%sassets.hpak", g_base);
+
+    if (!mapfile_open(&g_pack, path)) return false;
+
+    const HpakHeader* h = (const HpakHeader*)g_pack.data;
+    bool ok = g_pack.size >= sizeof(HpakHeader) && memcmp(h->magic, "HPAK", 4) == 0 &&
+              h->version == HPAK_VERSION && h->slots && (h->slots & (h->slots - 1)) == 0 &&
+              h->index_off + (Uint64)h->slots * sizeof(HpakSlot) <= g_pack.size &&
+              h->names_off <= h->index_off;
+    if (!ok) {
+        SDL_Log("assets: %s is not a valid archive, using loose files", path);
+        mapfile_close(&g_pack);
+        return false;
+    }
+    g_hdr = h;
+    g_slots = (const HpakSlot*)(g_pack.data + h->index_off);
+
+    struct stat st;
+    g_pack_mtime = (stat(path, &st) == 0) ? (Uint64)st.st_mtime : 0;
+    SDL_Log("assets: %s (%u files)", path, h->count);
+    return true;
+}
+
+void assets_close_pack(void) {
+    if (!g_hdr) return;
+    mapfile_close(&g_pack);
+    g_hdr = NULL; g_slots = NULL;
+}
+
+bool assets_have_pack(void) { return g_hdr != NULL; }
+
+static const HpakSlot* pack_find(const char* rel) {
+    if (!g_hdr) return NULL;
+    char norm[256];
+    size_t len = hpak_normalize(rel, norm, sizeof(norm));
+    uint64_t h = hpak_hash(norm, len);
+    const char* names = (const char*)g_pack.data + g_hdr->names_off;
+    uint32_t mask = g_hdr->slots - 1;
+    for (uint32_t i = (uint32_t)h & mask, n = 0; n < g_hdr->slots; i = (i + 1) & mask, ++n) {
+        const HpakSlot* s = &g_slots[i];
+        if (!s->hash) return NULL;
+        if (s->hash == h && s->name_len == len && memcmp(names + s->name_off, norm, len) == 0) {
+            if (s->data_off + s->stored_size > g_pack.size) return NULL;
+            return s;
+        }
+    }
+    return NULL;
+}
+
+// ---- RWops над власним буфером (розпакований LZ4): звільняється при закритті ----
+static Sint64 own_size(SDL_RWops* c) { return (Sint64)(c->hidden.mem.stop - c->hidden.mem.base); }
+static Sint64 own_seek(SDL_RWops* c, Sint64 off, int whence) {
+    Uint8* p = whence == RW_SEEK_SET ? c->hidden.mem.base + off
+             : whence == RW_SEEK_CUR ? c->hidden.mem.here + off
+             :                         c->hidden.mem.stop + off;
+    if (p < c->hidden.mem.base) p = c->hidden.mem.base;
+    if (p > c->hidden.mem.stop) p = c->hidden.mem.stop;
+    c->hidden.mem.here = p;
+    return (Sint64)(p - c->hidden.mem.base);
+}
+static size_t own_read(SDL_RWops* c, void* dst, size_t size, size_t num) {
+    if (!size) return 0;
+    size_t avail = (size_t)(c->hidden.mem.stop - c->hidden.mem.here);
+    size_t n = SDL_min(num, avail / size);
+    memcpy(dst, c->hidden.mem.here, n * size);
+    c->hidden.mem.here += n * size;
+    return n;
+}
+static size_t own_write(SDL_RWops* c, const void* src, size_t size, size_t num) {
+    (void)c; (void)src; (void)size; (void)num;
+    SDL_SetError("asset is read-only");
+    return 0;
+}
+static int own_close(SDL_RWops* c) {
+    if (c) { free(c->hidden.mem.base); SDL_FreeRW(c); }
+    return 0;
+}
+
+static SDL_RWops* rw_from_owned(Uint8* buf, size_t n) {
+    SDL_RWops* c = SDL_AllocRW();
+    if (!c) { free(buf); return NULL; }
+    c->size = own_size; c->seek = own_seek; c->read = own_read; c->write = own_write; c->close = own_close;
+    c->type = SDL_RWOPS_UNKNOWN;
+    c->hidden.mem.base = c->hidden.mem.here = buf;
+    c->hidden.mem.stop = buf + n;
+    return c;
+}
+
+static Uint8* pack_unpack(const HpakSlot* s) {
+    Uint8* buf = (Uint8*)malloc((size_t)s->raw_size + 1);
+    if (!buf) return NULL;
+    int n = lz4_decompress(g_pack.data + s->data_off, (int)s->stored_size, buf, (int)s->raw_size);
+    if (n != (int)s->raw_size) { free(buf); return NULL; }
+    buf[s->raw_size] = 0;
+    return buf;
+}
+
+static void loose_path(const char* rel, char* out, size_t n, bool from_base) {
+    const char* sub = (SDL_strncasecmp(rel, "assets/", 7) == 0) ? rel + 7 : rel;
+    SDL_snprintf(out, n, "%sassets/%s", from_base ? g_base : "", sub);
+}
+
+SDL_RWops* asset_open(const char* rel) {
+    if (!rel || !*rel) return NULL;
+    const HpakSlot* s = pack_find(rel);
+    if (s) {
+        SDL_AtomicAdd(&g_from_pack, 1);
+        if (!(s->flags & HPAK_FLAG_LZ4))
+            return SDL_RWFromConstMem(g_pack.data + s->data_off, (int)s->stored_size);
+        Uint8* buf = pack_unpack(s);
+        return buf ? rw_from_owned(buf, s->raw_size) : NULL;
+    }
+
+    ensure_base();
+    char path[768];
+    loose_path(rel, path, sizeof(path), true);
+    SDL_RWops* rw = SDL_RWFromFile(path, "rb");
+    if (!rw) { // запуск з теки проєкту: assets/ відносно робочої теки
+        loose_path(rel, path, sizeof(path), false);
+        rw = SDL_RWFromFile(path, "rb");
+    }
+    if (rw) SDL_AtomicAdd(&g_from_disk, 1);
+    return rw;
+}
+
+void* asset_load(const char* rel, size_t* size) {
+    const HpakSlot* s = pack_find(rel);
+    if (s && (s->flags & HPAK_FLAG_LZ4)) {
+        SDL_AtomicAdd(&g_from_pack, 1);
+        Uint8* buf = pack_unpack(s);
+        if (buf && size) *size = s->raw_size;
+        return buf;
+    }
+    SDL_RWops* rw = asset_open(rel);
+    if (!rw) return NULL;
+    return SDL_LoadFile_RW(rw, size, 1); // додає '\0' в кінці
+}
+
+bool asset_stamp(const char* rel, Uint64* mtime, Uint64* size) {
+    const HpakSlot* s = pack_find(rel);
+    if (s) {
+        // вміст архіву змінюється лише разом з архівом
+        *mtime = g_pack_mtime ^ s->data_off;
+        *size  = s->raw_size;
+        return true;
+    }
+    ensure_base();
+    char path[768];
+    struct stat st;
+    loose_path(rel, path, sizeof(path), true);
+    if (stat(path, &st) != 0) {
+        loose_path(rel, path, sizeof(path), false);
+        if (stat(path, &st) != 0) return false;
+    }
+    *mtime = (Uint64)st.st_mtime;
+    *size  = (Uint64)st.st_size;
+    return true;
+}
+
+void assets_log_stats(const char* when) {
+    SDL_Log("assets (%s): %d from archive, %d loose file opens",
+            when, SDL_AtomicGet(&g_from_pack), SDL_AtomicGet(&g_from_disk));
+}
@@ -0,0 +1,21 @@
+#ifndef HYDRANGEA_ASSETS_H
+#define HYDRANGEA_ASSETS_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+// Доступ до ассетів: спершу assets.hpak поруч з exe (відображений у пам'ять),
+// якщо його немає або файлу в ньому немає — звичайні файли з assets/ (dev-режим).
+// Шляхи приймаються як "music/calm.mp3" так і "assets/music/calm.mp3".
+
+bool        assets_open_pack(const char* file);   // NULL -> "<base>/assets.hpak"
+void        assets_close_pack(void);              // після звільнення шрифтів і музики
+bool        assets_have_pack(void);
+
+SDL_RWops*  asset_open(const char* rel);
+void*       asset_load(const char* rel, size_t* size);  // + завершальний '\0'; free()
+bool        asset_stamp(const char* rel, Uint64* mtime, Uint64* size);
+
+void        assets_log_stats(const char* when);
+
+#endif /* HYDRANGEA_ASSETS_H */
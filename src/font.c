@@ -0,0 +1,655 @@
+#include "font.h"
+#include "assets.h"
+#include "lz4blk.h"
+#include <SDL2/SDL_ttf.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SDF_VERSION  1
+#define SDF_BASE_PX  64
+#define SDF_PAD      8       // поле в базових px по обидва боки контуру
+#define ATLAS_W      1024
+#define SIZE_SLOTS   4       // скільки розмірів тримаємо одночасно
+#define FONT_SIZE_MIN     6
+#define FONT_SIZE_MAX     256
+
+// латиниця, Latin-1, кирилиця (з Ґґ), типографські лапки/тире/…, №, ™, €
+static const Uint32 RANGES[][2] = {
+    {0x20, 0x7E}, {0xA0, 0xFF}, {0x400, 0x45F}, {0x490, 0x491},
+    {0x2010, 0x2027}, {0x2030, 0x2030}, {0x2039, 0x203A}, {0x20AC, 0x20AC},
+    {0x2116, 0x2116}, {0x2122, 0x2122},
+};
+
+typedef struct {
+    char   magic[4];      // "HSDF"
+    Uint32 version;
+    Uint64 src_mtime, src_size;
+    Sint32 base_px, pad;
+    Sint32 ascent, height, line_skip;
+    Uint32 glyph_n, kern_n;
+    Uint32 atlas_w, atlas_h;
+    Uint32 data_size;     // байтів атласу у файлі; < w*h -> LZ4
+} SdfHeader;
+
+typedef struct {
+    Uint32 cp;
+    Uint16 x, y, w, h;    // клітинка в SDF-атласі
+    Sint16 ox, oy;        // її зсув від пера / верху рядка, базові px
+    Sint16 adv, reserved;
+} SdfGlyph;
+
+typedef struct { Uint32 a, b; Sint32 k; } SdfKern;
+
+typedef struct {
+    Uint16 x, y, w, h;    // клітинка в масці розміру
+    Sint16 ox, oy;        // зсув від пера / верху рядка, px
+} SizeGlyph;
+
+typedef struct {
+    int px;               // 0 = вільний слот
+    Uint32 last_use;
+    SDL_Texture* tex;
+    Uint8* cov;           // CPU-копія маски (для font_render_n)
+    int w, h;
+    SizeGlyph* glyphs;
+} SizeAtlas;
+
+static SDL_Renderer* g_r = NULL;
+static SdfHeader g_hdr;
+static SdfGlyph* g_glyphs = NULL;     // відсортовано за cp
+static SdfKern*  g_kerns = NULL;      // відсортовано за (a, b)
+static Uint8*    g_sdf = NULL;        // atlas_w * atlas_h, 128 = контур, більше = всередині
+static int       g_ascii[128];
+static int       g_fallback = -1;     // '?'
+static SizeAtlas g_sizes[SIZE_SLOTS];
+static Uint32    g_tick = 0;
+
+static SDL_Vertex* g_v = NULL;
+static int*        g_i = NULL;
+static int         g_cap = 0;         // у гліфах
+
+// ---------------- UTF-8 / пошук ----------------
+
+static int utf8_next(const char* s, int n, int p, Uint32* cp) {
+    const unsigned char* u = (const unsigned char*)s;
+    unsigned char c = u[p];
+    int len = c < 0x80 ? 1 : (c & 0xE0) == 0xC0 ? 2 : (c & 0xF0) == 0xE0 ? 3 : (c & 0xF8) == 0xF0 ? 4 : 1;
+    if (p + len > n) len = 1;
+    switch (len) {
+        case 2:  *cp = ((Uint32)(c & 0x1F) << 6) | (u[p+1] & 0x3F); break;
+        case 3:  *cp = ((Uint32)(c & 0x0F) << 12) | ((Uint32)(u[p+1] & 0x3F) << 6) | (u[p+2] & 0x3F); break;
+        case 4:  *cp = ((Uint32)(c & 0x07) << 18) | ((Uint32)(u[p+1] & 0x3F) << 12) | ((Uint32)(u[p+2] & 0x3F) << 6) | (u[p+3] & 0x3F); break;
+        default: *cp = c; break;
+    }
+    return p + len;
+}
+
+static int utf8_put(char* out, Uint32 cp) {
+    if (cp < 0x80)    { out[0] = (char)cp; return 1; }
+    if (cp < 0x800)   { out[0] = (char)(0xC0 | (cp >> 6)); out[1] = (char)(0x80 | (cp & 0x3F)); return 2; }
+    if (cp < 0x10000) { out[0] = (char)(0xE0 | (cp >> 12)); out[1] = (char)(0x80 | ((cp >> 6) & 0x3F)); out[2] = (char)(0x80 | (cp & 0x3F)); return 3; }
+    out[0] = (char)(0xF0 | (cp >> 18)); out[1] = (char)(0x80 | ((cp >> 12) & 0x3F));
+    out[2] = (char)(0x80 | ((cp >> 6) & 0x3F)); out[3] = (char)(0x80 | (cp & 0x3F));
+    return 4;
+}
+
+static int glyph_index(Uint32 cp) {
+    if (cp < 128) return g_ascii[cp] >= 0 ? g_ascii[cp] : g_fallback;
+    int lo = 0, hi = (int)g_hdr.glyph_n - 1;
+    while (lo <= hi) {
+        int m = (lo + hi) / 2;
+        if (g_glyphs[m].cp == cp) return m;
+        if (g_glyphs[m].cp < cp) lo = m + 1; else hi = m - 1;
+    }
+    return g_fallback;
+}
+
+static int kerning(Uint32 a, Uint32 b) {
+    int lo = 0, hi = (int)g_hdr.kern_n - 1;
+    while (lo <= hi) {
+        int m = (lo + hi) / 2;
+        const SdfKern* k = &g_kerns[m];
+        if (k->a == a && k->b == b) return k->k;
+        if (k->a < a || (k->a == a && k->b < b)) lo = m + 1; else hi = m - 1;
+    }
+    return 0;
+}
+
+// ---------------- побудова SDF ----------------
+
+// 1D квадрат відстані (Felzenszwalb–Huttenlocher), f/d довжини n, v/z — робочі
+static void edt1d(const double* f, int n, double* d, int* v, double* z) {
+    int k = 0;
+    v[0] = 0; z[0] = -1e30; z[1] = 1e30;
+    for (int q = 1; q < n; ++q) {
+        double s = ((f[q] + (double)q*q) - (f[v[k]] + (double)v[k]*v[k])) / (2.0*q - 2.0*v[k]);
+        while (s <= z[k]) {
+            --k;
+            s = ((f[q] + (double)q*q) - (f[v[k]] + (double)v[k]*v[k])) / (2.0*q - 2.0*v[k]);
+        }
+        ++k; v[k] = q; z[k] = s; z[k+1] = 1e30;
+    }
+    k = 0;
+    for (int q = 0; q < n; ++q) {
+        while (z[k+1] < q) ++k;
+        d[q] = (double)(q - v[k]) * (q - v[k]) + f[v[k]];
+    }
+}
+
+static void edt2d(double* g, int w, int h) {
+    int n = SDL_max(w, h);
+    double* f = (double*)malloc(sizeof(double) * (size_t)n);
+    double* d = (double*)malloc(sizeof(double) * (size_t)n);
+    double* z = (double*)malloc(sizeof(double) * (size_t)(n + 1));
+    int*    v = (int*)malloc(sizeof(int) * (size_t)n);
+    if (f && d && z && v) {
+        for (int x = 0; x < w; ++x) {
+            for (int y = 0; y < h; ++y) f[y] = g[y*w + x];
+            edt1d(f, h, d, v, z);
+            for (int y = 0; y < h; ++y) g[y*w + x] = d[y];
+        }
+        for (int y = 0; y < h; ++y) {
+            memcpy(f, g + (size_t)y*w, sizeof(double) * (size_t)w);
+            edt1d(f, w, d, v, z);
+            memcpy(g + (size_t)y*w, d, sizeof(double) * (size_t)w);
+        }
+    }
+    free(f); free(d); free(z); free(v);
+}
+
+// покриття (0..255) клітинки cw x ch -> SDF-байти в out (рядок out_pitch)
+static void coverage_to_sdf(const Uint8* cov, int cw, int ch, Uint8* out, int out_pitch) {
+    const size_t n = (size_t)cw * ch;
+    double* din  = (double*)malloc(sizeof(double) * n);
+    double* dout = (double*)malloc(sizeof(double) * n);
+    if (!din || !dout) { free(din); free(dout); return; }
+    for (size_t i = 0; i < n; ++i) {
+        bool inside = cov[i] >= 128;
+        dout[i] = inside ? 0.0 : 1e20;   // до найближчого внутрішнього
+        din[i]  = inside ? 1e20 : 0.0;   // до найближчого зовнішнього
+    }
+    edt2d(dout, cw, ch);
+    edt2d(din, cw, ch);
+    for (int y = 0; y < ch; ++y) {
+        for (int x = 0; x < cw; ++x) {
+            size_t i = (size_t)y*cw + x;
+            double sd = cov[i] >= 128 ? -(sqrt(din[i]) - 0.5) : (sqrt(dout[i]) - 0.5);
+            if (cov[i] > 0 && cov[i] < 255) sd = 0.5 - cov[i] / 255.0;   // край: точніше з покриття
+            int b = (int)lround(128.0 - sd * 127.0 / SDF_PAD);
+            out[(size_t)y*out_pitch + x] = (Uint8)SDL_clamp(b, 0, 255);
+        }
+    }
+    free(din); free(dout);
+}
+
+static bool build_atlas(const char* ttf_rel) {
+    TTF_Font* f = TTF_OpenFontRW(asset_open(ttf_rel), 1, SDF_BASE_PX);
+    if (!f) { SDL_Log("font: can't open %s: %s", ttf_rel, TTF_GetError()); return false; }
+
+    int cap = 0;
+    for (size_t r = 0; r < SDL_arraysize(RANGES); ++r) cap += (int)(RANGES[r][1] - RANGES[r][0] + 1);
+    g_glyphs = (SdfGlyph*)calloc((size_t)cap, sizeof(SdfGlyph));
+    int atlas_h = 0, rows_cap = 512;
+    g_sdf = (Uint8*)calloc((size_t)ATLAS_W * rows_cap, 1);
+    if (!g_glyphs || !g_sdf) { TTF_CloseFont(f); return false; }
+
+    const SDL_Color white = {255, 255, 255, 255};
+    int n = 0, pen_x = 0, pen_y = 0, shelf_h = 0;
+    for (size_t r = 0; r < SDL_arraysize(RANGES); ++r) {
+        for (Uint32 cp = RANGES[r][0]; cp <= RANGES[r][1]; ++cp) {
+            if (!TTF_GlyphIsProvided32(f, cp)) continue;
+            int minx = 0, adv = 0;
+            if (TTF_GlyphMetrics32(f, cp, &minx, NULL, NULL, NULL, &adv) != 0) continue;
+            SdfGlyph* G = &g_glyphs[n];
+            G->cp = cp; G->adv = (Sint16)adv;
+
+            SDL_Surface* s = TTF_RenderGlyph32_Blended(f, cp, white);
+            SDL_Surface* c = s ? SDL_ConvertSurfaceFormat(s, SDL_PIXELFORMAT_ARGB8888, 0) : NULL;
+            if (s) SDL_FreeSurface(s);
+            // межі чорнила в поверхні гліфа
+            int bx0 = 1 << 30, by0 = 1 << 30, bx1 = -1, by1 = -1;
+            if (c) {
+                for (int y = 0; y < c->h; ++y) {
+                    const Uint32* row = (const Uint32*)((const Uint8*)c->pixels + (size_t)y * c->pitch);
+                    for (int x = 0; x < c->w; ++x) if (row[x] >> 24) {
+                        if (x < bx0) bx0 = x;
+                        if (x > bx1) bx1 = x;
+                        if (y < by0) by0 = y;
+                        if (y > by1) by1 = y;
+                    }
+                }
+            }
+            if (bx1 < 0) {            // пробіл і подібні: лише advance
+                if (c) SDL_FreeSurface(c);
+                ++n;
+                continue;
+            }
+            const int cw = bx1 - bx0 + 1 + 2*SDF_PAD, ch = by1 - by0 + 1 + 2*SDF_PAD;
+            // x=0 поверхні — це перо, якщо гліф не виступає вліво (інакше SDL_ttf зсуває на -minx)
+            const int shift = minx < 0 ? -minx : 0;
+            G->ox = (Sint16)(bx0 - shift - SDF_PAD);
+            G->oy = (Sint16)(by0 - SDF_PAD);
+            G->w = (Uint16)cw; G->h = (Uint16)ch;
+
+            if (pen_x + cw > ATLAS_W) { pen_x = 0; pen_y += shelf_h; shelf_h = 0; }
+            if (pen_y + ch > rows_cap) {
+                int nc = rows_cap * 2;
+                while (pen_y + ch > nc) nc *= 2;
+                Uint8* na = (Uint8*)realloc(g_sdf, (size_t)ATLAS_W * nc);
+                if (!na) { SDL_FreeSurface(c); TTF_CloseFont(f); return false; }
+                memset(na + (size_t)ATLAS_W * rows_cap, 0, (size_t)ATLAS_W * (nc - rows_cap));
+                g_sdf = na; rows_cap = nc;
+            }
+            G->x = (Uint16)pen_x; G->y = (Uint16)pen_y;
+
+            Uint8* cov = (Uint8*)calloc((size_t)cw * ch, 1);
+            if (cov) {
+                for (int y = by0; y <= by1; ++y) {
+                    const Uint32* row = (const Uint32*)((const Uint8*)c->pixels + (size_t)y * c->pitch);
+                    for (int x = bx0; x <= bx1; ++x)
+                        cov[(size_t)(y - by0 + SDF_PAD) * cw + (x - bx0 + SDF_PAD)] = (Uint8)(row[x] >> 24);
+                }
+                coverage_to_sdf(cov, cw, ch, g_sdf + (size_t)pen_y * ATLAS_W + pen_x, ATLAS_W);
+                free(cov);
+            }
+            SDL_FreeSurface(c);
+            pen_x += cw + 1;
+            if (ch > shelf_h) shelf_h = ch;
+            if (pen_y + shelf_h > atlas_h) atlas_h = pen_y + shelf_h;
+            ++n;
+        }
+    }
+
+    // кернінг: міряємо пари через TTF_SizeUTF8 — так враховується і GPOS (SDL_ttf шейпить
+    // через HarfBuzz), а не лише таблиця kern. Ширина одиночного гліфа включає виступ вліво
+    // (shift) і вправо, тож k = |AB| - adv(A) - shift(A) - (|B| - shift(B)). Лише ненульові пари.
+    int kcap = 256, kn = 0;
+    g_kerns = (SdfKern*)malloc(sizeof(SdfKern) * (size_t)kcap);
+    int* single = (int*)calloc((size_t)SDL_max(n, 1), sizeof(int));   // |B| - shift(B)
+    int* shift  = (int*)calloc((size_t)SDL_max(n, 1), sizeof(int));
+    if (g_kerns && single && shift && TTF_GetFontKerning(f)) {
+        for (int a = 0; a < n; ++a) {
+            char one[8]; one[utf8_put(one, g_glyphs[a].cp)] = 0;
+            int minx = 0, w = 0;
+            TTF_GlyphMetrics32(f, g_glyphs[a].cp, &minx, NULL, NULL, NULL, NULL);
+            TTF_SizeUTF8(f, one, &w, NULL);
+            shift[a] = minx < 0 ? -minx : 0;
+            single[a] = w - shift[a];
+        }
+        for (int a = 0; a < n; ++a) {
+            if (!g_glyphs[a].w) continue;
+            for (int b = 0; b < n; ++b) {
+                if (!g_glyphs[b].w) continue;
+                char pair[16];
+                int len = utf8_put(pair, g_glyphs[a].cp);
+                len += utf8_put(pair + len, g_glyphs[b].cp);
+                pair[len] = 0;
+                int w = 0;
+                if (TTF_SizeUTF8(f, pair, &w, NULL) != 0) continue;
+                int k = w - g_glyphs[a].adv - shift[a] - single[b];
+                if (!k) continue;
+                if (kn == kcap) {
+                    SdfKern* nk = (SdfKern*)realloc(g_kerns, sizeof(SdfKern) * (size_t)kcap * 2);
+                    if (!nk) break;
+                    g_kerns = nk; kcap *= 2;
+                }
+                g_kerns[kn++] = (SdfKern){ g_glyphs[a].cp, g_glyphs[b].cp, k };
+            }
+        }
+    }
+    free(single); free(shift);
+
+    memset(&g_hdr, 0, sizeof(g_hdr));
+    memcpy(g_hdr.magic, "HSDF", 4);
+    g_hdr.version = SDF_VERSION;
+    g_hdr.base_px = SDF_BASE_PX; g_hdr.pad = SDF_PAD;
+    g_hdr.ascent = TTF_FontAscent(f);
+    g_hdr.height = TTF_FontHeight(f);
+    g_hdr.line_skip = TTF_FontLineSkip(f);
+    g_hdr.glyph_n = (Uint32)n; g_hdr.kern_n = (Uint32)kn;
+    g_hdr.atlas_w = ATLAS_W; g_hdr.atlas_h = (Uint32)SDL_max(atlas_h, 1);
+    TTF_CloseFont(f);
+    return true;
+}
+
+// ---------------- дисковий кеш ----------------
+
+static bool cache_path(const char* ttf_rel, char* out, size_t n) {
+    char* pref = SDL_GetPrefPath("Hydrangea", "fontcache");
+    if (!pref) return false;
+    Uint64 h = 1469598103934665603ull;
+    for (const char* s = ttf_rel; *s; ++s) { h ^= (unsigned char)*s; h *= 1099511628211ull; }
+    SDL_snprintf(out, n, "%s%016llx.sdf", pref, (unsigned long long)h);
+    SDL_free(pref);
+    return true;
+}
+
+static bool cache_load(const char* file, Uint64 mtime, Uint64 size) {
+    size_t len = 0;
+    Uint8* d = (Uint8*)SDL_LoadFile(file, &len);
+    if (!d) return false;
+    SdfHeader h;
+    bool ok = len >= sizeof(h);
+    if (ok) {
+        memcpy(&h, d, sizeof(h));
+        ok = memcmp(h.magic, "HSDF", 4) == 0 && h.version == SDF_VERSION &&
+             h.src_mtime == mtime && h.src_size == size &&
+             h.base_px == SDF_BASE_PX && h.pad == SDF_PAD && h.glyph_n > 0 &&
+             len == sizeof(h) + h.glyph_n * sizeof(SdfGlyph) + h.kern_n * sizeof(SdfKern) + h.data_size;
+    }
+    if (ok) {
+        const size_t raw = (size_t)h.atlas_w * h.atlas_h;
+        const Uint8* p = d + sizeof(h);
+        g_glyphs = (SdfGlyph*)malloc(h.glyph_n * sizeof(SdfGlyph));
+        g_kerns  = (SdfKern*)malloc(SDL_max(1u, h.kern_n) * sizeof(SdfKern));
+        g_sdf    = (Uint8*)malloc(raw);
+        ok = g_glyphs && g_kerns && g_sdf;
+        if (ok) {
+            memcpy(g_glyphs, p, h.glyph_n * sizeof(SdfGlyph)); p += h.glyph_n * sizeof(SdfGlyph);
+            memcpy(g_kerns, p, h.kern_n * sizeof(SdfKern));    p += h.kern_n * sizeof(SdfKern);
+            if (h.data_size == raw) memcpy(g_sdf, p, raw);
+            else ok = lz4_decompress(p, (int)h.data_size, g_sdf, (int)raw) == (int)raw;
+        }
+        if (ok) g_hdr = h;
+        else {
+            free(g_glyphs); free(g_kerns); free(g_sdf);
+            g_glyphs = NULL; g_kerns = NULL; g_sdf = NULL;
+        }
+    }
+    SDL_free(d);
+    return ok;
+}
+
+static void cache_store(const char* file) {
+    const int raw = (int)(g_hdr.atlas_w * g_hdr.atlas_h);
+    int cap = lz4_compress_bound(raw);
+    Uint8* lz = (Uint8*)malloc((size_t)cap);
+    int n = lz ? lz4_compress(g_sdf, raw, lz, cap) : 0;
+    const Uint8* payload = (n > 0 && n < raw) ? lz : g_sdf;
+    g_hdr.data_size = (n > 0 && n < raw) ? (Uint32)n : (Uint32)raw;
+
+    // тимчасовий файл і підміна — як в imgcache
+    char tmp[700];
+    SDL_snprintf(tmp, sizeof(tmp), "%s.%lu.tmp", file, (unsigned long)SDL_ThreadID());
+    FILE* f = fopen(tmp, "wb");
+    bool ok = f && fwrite(&g_hdr, sizeof(g_hdr), 1, f) == 1 &&
+              fwrite(g_glyphs, sizeof(SdfGlyph), g_hdr.glyph_n, f) == g_hdr.glyph_n &&
+              fwrite(g_kerns, sizeof(SdfKern), g_hdr.kern_n, f) == g_hdr.kern_n &&
+              fwrite(payload, 1, g_hdr.data_size, f) == g_hdr.data_size;
+    if (f) ok = (fclose(f) == 0) && ok;
+    if (ok) { remove(file); ok = rename(tmp, file) == 0; }
+    if (!ok) { remove(tmp); SDL_Log("font: can't write cache %s", file); }
+    free(lz);
+}
+
+// ---------------- маски розмірів ----------------
+
+static float sdf_sample(const SdfGlyph* G, float u, float v) {
+    float fx = u - 0.5f, fy = v - 0.5f;
+    int x0 = (int)floorf(fx), y0 = (int)floorf(fy);
+    float tx = fx - (float)x0, ty = fy - (float)y0;
+    float s[4];
+    for (int k = 0; k < 4; ++k) {
+        int x = x0 + (k & 1), y = y0 + (k >> 1);
+        s[k] = (x < 0 || y < 0 || x >= G->w || y >= G->h) ? 0.f
+             : (float)g_sdf[(size_t)(G->y + y) * g_hdr.atlas_w + G->x + x];
+    }
+    return (s[0] * (1.f - tx) + s[1] * tx) * (1.f - ty) + (s[2] * (1.f - tx) + s[3] * tx) * ty;
+}
+
+static void size_free(SizeAtlas* A) {
+    if (A->tex) SDL_DestroyTexture(A->tex);
+    free(A->cov); free(A->glyphs);
+    memset(A, 0, sizeof(*A));
+}
+
+static bool size_build(SizeAtlas* A, int px) {
+    const float k = (float)px / (float)g_hdr.base_px;
+    const int gn = (int)g_hdr.glyph_n;
+    A->glyphs = (SizeGlyph*)calloc((size_t)gn, sizeof(SizeGlyph));
+    if (!A->glyphs) return false;
+
+    // розміщення: чорнило в межах поля -> клітинка з запасом 1 px
+    int aw = SDL_min(ATLAS_W, SDL_max(256, px * 24)), pen_x = 0, pen_y = 0, shelf_h = 0;
+    for (int i = 0; i < gn; ++i) {
+        const SdfGlyph* G = &g_glyphs[i];
+        SizeGlyph* S = &A->glyphs[i];
+        if (!G->w) continue;
+        int x0 = (int)floorf((G->ox + SDF_PAD) * k) - 1, x1 = (int)ceilf((G->ox + G->w - SDF_PAD) * k) + 1;
+        int y0 = (int)floorf((G->oy + SDF_PAD) * k) - 1, y1 = (int)ceilf((G->oy + G->h - SDF_PAD) * k) + 1;
+        S->ox = (Sint16)x0; S->oy = (Sint16)y0;
+        S->w = (Uint16)(x1 - x0); S->h = (Uint16)(y1 - y0);
+        if (pen_x + S->w > aw) { pen_x = 0; pen_y += shelf_h; shelf_h = 0; }
+        S->x = (Uint16)pen_x; S->y = (Uint16)pen_y;
+        pen_x += S->w + 1;
+        if (S->h > shelf_h) shelf_h = S->h;
+    }
+    A->w = aw; A->h = SDL_max(1, pen_y + shelf_h);
+    A->cov = (Uint8*)calloc((size_t)A->w * A->h, 1);
+    Uint32* px32 = (Uint32*)malloc(sizeof(Uint32) * (size_t)A->w * A->h);
+    if (!A->cov || !px32) { free(px32); return false; }
+
+    // поріг: відстань у px цього розміру -> покриття з 1 px згладжування
+    const float to_px = (float)SDF_PAD / 127.f * k;
+    for (int i = 0; i < gn; ++i) {
+        const SdfGlyph* G = &g_glyphs[i];
+        const SizeGlyph* S = &A->glyphs[i];
+        for (int y = 0; y < S->h; ++y) {
+            float v = ((float)(S->oy + y) + 0.5f) / k - (float)G->oy;
+            Uint8* row = A->cov + (size_t)(S->y + y) * A->w + S->x;
+            for (int x = 0; x < S->w; ++x) {
+                float u = ((float)(S->ox + x) + 0.5f) / k - (float)G->ox;
+                float sd = (128.f - sdf_sample(G, u, v)) * to_px;
+                float a = SDL_clamp(0.5f - sd, 0.f, 1.f);
+                row[x] = (Uint8)(a * 255.f + 0.5f);
+            }
+        }
+    }
+    for (size_t i = 0; i < (size_t)A->w * A->h; ++i) px32[i] = ((Uint32)A->cov[i] << 24) | 0x00FFFFFFu;
+
+    A->tex = SDL_CreateTexture(g_r, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, A->w, A->h);
+    if (A->tex) {
+        SDL_UpdateTexture(A->tex, NULL, px32, A->w * 4);
+        SDL_SetTextureBlendMode(A->tex, SDL_BLENDMODE_BLEND);
+        SDL_SetTextureScaleMode(A->tex, SDL_ScaleModeNearest);
+    } else SDL_Log("font: texture %dx%d failed: %s", A->w, A->h, SDL_GetError());
+    free(px32);
+    A->px = px;
+    return A->tex != NULL;
+}
+
+static SizeAtlas* size_get(float size) {
+    if (!g_sdf) return NULL;
+    int px = SDL_clamp((int)lroundf(size), FONT_SIZE_MIN, FONT_SIZE_MAX);
+    ++g_tick;
+    SizeAtlas* lru = &g_sizes[0];
+    for (int i = 0; i < SIZE_SLOTS; ++i) {
+        if (g_sizes[i].px == px) { g_sizes[i].last_use = g_tick; return &g_sizes[i]; }
+        if (g_sizes[i].last_use < lru->last_use) lru = &g_sizes[i];
+    }
+    size_free(lru);
+    if (!size_build(lru, px)) { size_free(lru); return NULL; }
+    lru->last_use = g_tick;
+    return lru;
+}
+
+// ---------------- API ----------------
+
+bool font_init(SDL_Renderer* r, const char* ttf_rel) {
+    g_r = r;
+    Uint64 mtime = 0, size = 0;
+    asset_stamp(ttf_rel, &mtime, &size);
+    char file[640];
+    const bool have_path = cache_path(ttf_rel, file, sizeof(file));
+
+    Uint64 t0 = SDL_GetPerformanceCounter();
+    bool from_cache = have_path && cache_load(file, mtime, size);
+    if (!from_cache) {
+        if (!build_atlas(ttf_rel)) { font_shutdown(); return false; }
+        g_hdr.src_mtime = mtime; g_hdr.src_size = size;
+        if (have_path) cache_store(file);
+    }
+    SDL_Log("font: %u glyphs, %u kerning pairs, SDF atlas %ux%u %s in %.1f ms", g_hdr.glyph_n, g_hdr.kern_n, g_hdr.atlas_w, g_hdr.atlas_h,
+            from_cache ? "from cache" : "built",
+            (double)(SDL_GetPerformanceCounter() - t0) * 1000.0 / (double)SDL_GetPerformanceFrequency());
+
+    for (int c = 0; c < 128; ++c) g_ascii[c] = -1;
+    for (Uint32 i = 0; i < g_hdr.glyph_n; ++i) if (g_glyphs[i].cp < 128) g_ascii[g_glyphs[i].cp] = (int)i;
+    g_fallback = g_ascii['?'];
+    return true;
+}
+
+void font_shutdown(void) {
+    for (int i = 0; i < SIZE_SLOTS; ++i) size_free(&g_sizes[i]);
+    free(g_glyphs); free(g_kerns); free(g_sdf);
+    g_glyphs = NULL; g_kerns = NULL; g_sdf = NULL;
+    free(g_v); free(g_i);
+    g_v = NULL; g_i = NULL; g_cap = 0;
+    memset(&g_hdr, 0, sizeof(g_hdr));
+    g_r = NULL;
+}
+
+// обхід рядка: для кожного кодпоінта — індекс гліфа і x пера (px, до округлення)
+typedef void (*GlyphFn)(void* user, int gi, float pen, int cp_index);
+
+static float walk(float k, const char* txt, int n, GlyphFn fn, void* user) {
+    float pen = 0.f;
+    Uint32 prev = 0;
+    int ci = 0;
+    for (int p = 0; p < n && txt[p]; ) {
+        Uint32 cp;
+        p = utf8_next(txt, n, p, &cp);
+        int gi = glyph_index(cp);
+        if (gi < 0) { ++ci; continue; }
+        if (prev && g_hdr.kern_n) pen += (float)kerning(prev, g_glyphs[gi].cp) * k;
+        if (fn) fn(user, gi, pen, ci);
+        pen += (float)g_glyphs[gi].adv * k;
+        prev = g_glyphs[gi].cp;
+        ++ci;
+    }
+    return pen;
+}
+
+typedef struct { const SizeAtlas* A; int x, y, nq; SDL_Color col; float iw, ih; int ink_r; } DrawCtx;
+
+static bool reserve_quads(int n) {
+    if (n <= g_cap) return true;
+    int cap = SDL_max(64, g_cap * 2);
+    while (cap < n) cap *= 2;
+    SDL_Vertex* v = (SDL_Vertex*)realloc(g_v, sizeof(SDL_Vertex) * 4 * (size_t)cap);
+    if (!v) return false;
+    g_v = v;
+    int* i = (int*)realloc(g_i, sizeof(int) * 6 * (size_t)cap);
+    if (!i) return false;
+    g_i = i; g_cap = cap;
+    return true;
+}
+
+static void emit_quad(void* user, int gi, float pen, int ci) {
+    (void)ci;
+    DrawCtx* c = (DrawCtx*)user;
+    const SizeGlyph* S = &c->A->glyphs[gi];
+    if (!S->w || !reserve_quads(c->nq + 1)) return;
+    const float x = (float)(c->x + (int)lroundf(pen) + S->ox), y = (float)(c->y + S->oy);
+    const float u0 = S->x * c->iw, v0 = S->y * c->ih, u1 = (S->x + S->w) * c->iw, v1 = (S->y + S->h) * c->ih;
+    SDL_Vertex* v = &g_v[c->nq * 4];
+    v[0] = (SDL_Vertex){ {x, y},               c->col, {u0, v0} };
+    v[1] = (SDL_Vertex){ {x + S->w, y},        c->col, {u1, v0} };
+    v[2] = (SDL_Vertex){ {x + S->w, y + S->h}, c->col, {u1, v1} };
+    v[3] = (SDL_Vertex){ {x, y + S->h},        c->col, {u0, v1} };
+    int b = c->nq * 4, *k = &g_i[c->nq * 6];
+    k[0] = b; k[1] = b + 1; k[2] = b + 2; k[3] = b; k[4] = b + 2; k[5] = b + 3;
+    c->nq++;
+}
+
+void font_draw(float size, SDL_Color col, const char* txt, int x, int y) {
+    if (!txt || !*txt) return;
+    SizeAtlas* A = size_get(size);
+    if (!A) return;
+    DrawCtx c = { A, x, y, 0, col, 1.f / (float)A->w, 1.f / (float)A->h, 0 };
+    walk((float)A->px / (float)g_hdr.base_px, txt, (int)strlen(txt), emit_quad, &c);
+    if (c.nq) SDL_RenderGeometry(g_r, A->tex, g_v, c.nq * 4, g_i, c.nq * 6);
+}
+
+static void ink_right(void* user, int gi, float pen, int ci) {
+    (void)ci;
+    DrawCtx* c = (DrawCtx*)user;
+    const SizeGlyph* S = &c->A->glyphs[gi];
+    if (S->w) c->ink_r = SDL_max(c->ink_r, (int)lroundf(pen) + S->ox + S->w);
+}
+
+int font_width_n(float size, const char* txt, int n) {
+    SizeAtlas* A = size_get(size);
+    if (!A || !txt) return 0;
+    DrawCtx c = { A, 0, 0, 0, {0,0,0,0}, 0.f, 0.f, 0 };
+    float pen = walk((float)A->px / (float)g_hdr.base_px, txt, n, ink_right, &c);
+    return SDL_max((int)ceilf(pen), c.ink_r);
+}
+
+void font_size_text(float size, const char* txt, int* w, int* h) {
+    if (w) *w = txt ? font_width_n(size, txt, (int)strlen(txt)) : 0;
+    if (h) *h = g_sdf ? (int)lroundf(g_hdr.height * (float)SDL_clamp((int)lroundf(size), FONT_SIZE_MIN, FONT_SIZE_MAX) / (float)g_hdr.base_px) : 0;
+}
+
+int font_line_skip(float size) {
+    if (!g_sdf) return 0;
+    int px = SDL_clamp((int)lroundf(size), FONT_SIZE_MIN, FONT_SIZE_MAX);
+    return (int)lroundf((float)g_hdr.line_skip * (float)px / (float)g_hdr.base_px);
+}
+
+typedef struct { int* x_end; float k; } EdgeCtx;
+
+static void edge_fn(void* user, int gi, float pen, int ci) {
+    EdgeCtx* e = (EdgeCtx*)user;
+    e->x_end[ci] = (int)lroundf(pen + (float)g_glyphs[gi].adv * e->k);
+}
+
+int font_glyph_edges(float size, const char* txt, int n, int* x_end) {
+    SizeAtlas* A = size_get(size);
+    int cps = 0;
+    for (int p = 0; p < n && txt[p]; ) { Uint32 cp; p = utf8_next(txt, n, p, &cp); x_end[cps++] = 0; }
+    if (!A) return cps;
+    const float k = (float)A->px / (float)g_hdr.base_px;
+    EdgeCtx e = { x_end, k };
+    walk(k, txt, n, edge_fn, &e);
+    // пропущені (без гліфа) беруть край попереднього
+    for (int i = 1; i < cps; ++i) if (x_end[i] < x_end[i-1]) x_end[i] = x_end[i-1];
+    return cps;
+}
+
+typedef struct { const SizeAtlas* A; SDL_Surface* s; } BlitCtx;
+
+static void blit_glyph(void* user, int gi, float pen, int ci) {
+    (void)ci;
+    BlitCtx* b = (BlitCtx*)user;
+    const SizeGlyph* S = &b->A->glyphs[gi];
+    const int gx = (int)lroundf(pen) + S->ox;
+    for (int y = 0; y < S->h; ++y) {
+        int ty = S->oy + y;
+        if (ty < 0 || ty >= b->s->h) continue;
+        const Uint8* src = b->A->cov + (size_t)(S->y + y) * b->A->w + S->x;
+        Uint32* dst = (Uint32*)((Uint8*)b->s->pixels + (size_t)ty * b->s->pitch);
+        for (int x = 0; x < S->w; ++x) {
+            int tx = gx + x;
+            if (tx < 0 || tx >= b->s->w || !src[x]) continue;
+            Uint32 a = dst[tx] >> 24;
+            if (src[x] > a) dst[tx] = ((Uint32)src[x] << 24) | 0x00FFFFFFu;  // перекриття — максимум
+        }
+    }
+}
+
+SDL_Surface* font_render_n(float size, const char* txt, int n) {
+    SizeAtlas* A = size_get(size);
+    if (!A || !txt) return NULL;
+    int w = font_width_n(size, txt, n), h = 0;
+    font_size_text(size, NULL, NULL, &h);
+    if (w <= 0 || h <= 0) return NULL;
+    SDL_Surface* s = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (!s) return NULL;
+    SDL_FillRect(s, NULL, 0x00FFFFFFu);
+    BlitCtx b = { A, s };
+    walk((float)A->px / (float)g_hdr.base_px, txt, n, blit_glyph, &b);
+    return s;
+}
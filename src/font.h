@@ -0,0 +1,28 @@
+#ifndef HYDRANGEA_FONT_H
+#define HYDRANGEA_FONT_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+// Текст через SDF-атлас гліфів (signed distance field).
+// Атлас будується один раз з TTF (64 px, поле ±8 px) і лежить у дисковому кеші поруч з imgcache;
+// наступні запуски FreeType не чіпають. SDL2 без шейдерів, тож поріг рахуємо на CPU:
+// для кожного потрібного розміру з поля виходить маска покриття — одна текстура на розмір.
+// Зміна розміру/роздільності = лише цей дешевий поріг, без растеризації шрифту.
+// Рядок малюється одним RenderGeometry з квадів цієї текстури.
+
+bool font_init(SDL_Renderer* r, const char* ttf_rel);
+void font_shutdown(void);
+
+// розмір — висота шрифту в пікселях (як у TTF_OpenFont)
+void font_draw(float size, SDL_Color col, const char* txt, int x, int y);
+void font_size_text(float size, const char* txt, int* w, int* h);
+int  font_line_skip(float size);
+
+// для розкладки: ширина перших n байтів і правий край кожного кодпоінта (x_end; повертає їх кількість)
+int  font_width_n(float size, const char* txt, int n);
+int  font_glyph_edges(float size, const char* txt, int n, int* x_end);
+// біла ARGB-поверхня з альфою покриття (як TTF_RenderUTF8_Blended білим)
+SDL_Surface* font_render_n(float size, const char* txt, int n);
+
+#endif /* HYDRANGEA_FONT_H */
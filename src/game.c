@@ -6,13 +6,25 @@
 #include <sys/stat.h>
 #include <math.h>
 #include "cJSON.h"
+#include "texcache.h"
+#include "imgcache.h"
+#include "assets.h"
+#include "residency.h"
+#include "vfx.h"
+#include "prim.h"
+#include "swcomp.h"
+#include "stats.h"
+#include "typewriter.h"
+#include "ui.h"
+#include "layer.h"
+#include "font.h"
 #include <string.h>
 #define BALANCE_BIPOLAR 1
+#define FONT_PX 20.f   // базовий розмір тексту (при ui_scale = 1)
 
 static void scene_show_immediate(Game* g, int idx);
 static void save_config(Game* g);
-static void draw_text_col(SDL_Renderer* r, TTF_Font* f, SDL_Color col, const char* txt, int x, int y);
-static char* assets_full_path2(const char* rel);
+static void draw_text_col(float size, SDL_Color col, const char* txt, int x, int y);
 static void set_fullscreen(Game* g, bool fs);
 
 static const int RES_LIST[][2] = {
@@ -20,46 +32,21 @@ static const int RES_LIST[][2] = {
 };
 static const int RES_COUNT = (int)(sizeof(RES_LIST)/sizeof(RES_LIST[0]));
 static const char* LANGS[] = {"ua","ru","en"};
+static const float SCALES[] = {1.0f, 0.75f, 0.5f}; // render_scale у налаштуваннях
+static const int SCALE_COUNT = (int)(sizeof(SCALES)/sizeof(SCALES[0]));
+static const char* SCENES_PATH = "assets/content/scenes_demo.json";
 
 static int lang_to_idx(const char* s) {
     for (int i=0;i<3;i++) if (SDL_strcasecmp(s, LANGS[i]) == 0) return i;
     return 0;
 }
 
-typedef struct {
-    char path[128];
-    SDL_Texture* tex;
-} TexCacheEntry;
-static TexCacheEntry g_tex_cache[16];
-static int g_tex_cache_n = 0;
-
-static SDL_Texture* load_texture_cached(SDL_Renderer* r, const char* relpath) {
-    if (!relpath || !*relpath) return NULL;
-
-    // === prefix "assets/" якщо його немає ===
-    char path[256];
-    if (SDL_strncasecmp(relpath, "assets/", 7) == 0) {
-        SDL_snprintf(path, sizeof(path), "%s", relpath);
-    } else {
-        SDL_snprintf(path, sizeof(path), "assets/%s", relpath);
-    }
-
-    // кеш
-    for (int i=0;i<g_tex_cache_n;i++)
-        if (SDL_strcasecmp(g_tex_cache[i].path, path) == 0)
-            return g_tex_cache[i].tex;
-
-    SDL_Surface* s = IMG_Load(path);
-    if (!s) { SDL_Log("IMG_Load(%s): %s", path, IMG_GetError()); return NULL; }
-    SDL_Texture* t = SDL_CreateTextureFromSurface(r, s);
-    SDL_FreeSurface(s);
-    if (!t) return NULL;
-
-    if (g_tex_cache_n < (int)(sizeof g_tex_cache/sizeof g_tex_cache[0])) {
-        SDL_snprintf(g_tex_cache[g_tex_cache_n].path, sizeof(g_tex_cache[g_tex_cache_n].path), "%s", path);
-        g_tex_cache[g_tex_cache_n].tex = t; g_tex_cache_n++;
-    }
-    return t;
+// У пам'яті — фони й музика сцен поруч з поточною (у меню — зі стартовою); решта вивантажується
+static void residency_refresh(Game* g) {
+    int at = g->rt.cur >= 0 ? g->rt.cur : g->start_scene;
+    residency_focus(g->scenes, g->scenes_count, at, g->rt.visits,
+                    g->menu_bg_path[0] ? g->menu_bg_path : "backgrounds/menu_bg.png",
+                    g->current_music, g->bg);
 }
 
 // ---------- math helpers ----------
@@ -70,14 +57,6 @@ static inline int clampi(int v, int lo, int hi) {
     return (v < lo) ? lo : (v > hi) ? hi : v;
 }
 
-// Плавне «підтягування» до цілі зі швидкістю rate (од./сек)
-static inline float approachf(float cur, float tgt, float rate, float dt) {
-    float diff = tgt - cur;
-    float step = rate * dt;
-    if (diff >  step) return cur + step;
-    if (diff < -step) return cur - step;
-    return tgt;
-}
 static inline int approachi(int cur, int tgt, float rate, float dt) {
     int diff = tgt - cur;
     int step = (int)(rate * dt + 0.5f);
@@ -87,20 +66,6 @@ static inline int approachi(int cur, int tgt, float rate, float dt) {
     return tgt;
 }
 
-static int parse_cmp(const cJSON* j, int* op, int* val) {
-    *op = -1; *val = 0;
-    if (!cJSON_IsString(j)) return 0;
-    const char* s = j->valuestring;
-    if (s[0]=='<' && s[1]=='=') { *op=1; *val=atoi(s+2); return 1; }
-    if (s[0]=='>' && s[1]=='=') { *op=3; *val=atoi(s+2); return 1; }
-    if (s[0]=='<')             { *op=0; *val=atoi(s+1); return 1; }
-    if (s[0]=='>')             { *op=4; *val=atoi(s+1); return 1; }
-    if (s[0]=='=' )            { *op=2; *val=atoi(s+1); return 1; }
-    /* без оператора трактуємо як >= */
-    *op = 3; *val = atoi(s);
-    return 1;
-}
-
 static int test_cmp(int op, int lhs, int rhs) {
     switch(op){
         case 0: return lhs <  rhs;
@@ -134,19 +99,34 @@ static void game_remove_flag(Game* g, const char* name) {
     }
 }
 
-static void push_notif(Game* g, int row, const char* txt, SDL_Color col, float life) {
-    if (g->notif_count >= (int)(sizeof g->notifs / sizeof g->notifs[0])) return;
-    Notif* n = &g->notifs[g->notif_count++];
-    SDL_snprintf(n->text, sizeof(n->text), "%s", txt);
-    n->col = col; n->t = life; n->row = row;
+static void notif_free(Notif* n) {
+    tween_cancel(n->tw_alpha);
+    tween_cancel(n->tw_dy);
+    if (n->tex) SDL_DestroyTexture(n->tex);
+    memset(n, 0, sizeof(*n));
 }
 
-static char* str_dup(const char* s) {
-    if (!s) return NULL;
-    size_t n = strlen(s)+1;
-    char* p = (char*)malloc(n);
-    if (p) memcpy(p, s, n);
-    return p;
+// нова — в рядок row, старіші в ньому з'їжджають на рядок вище; місця нема — витісняємо найстарішу
+static void push_notif(Game* g, int row, const char* txt, SDL_Color col, float life) {
+    Notif* n = NULL;
+    for (int i = 0; i < NOTIF_MAX; ++i) {
+        Notif* c = &g->notifs[i];
+        if (!c->live) { if (!n || n->live) n = c; continue; }
+        if (c->row == row) {
+            float lift = (float)(font_line_skip(g->ui.fs) + 2);
+            tween_cancel(c->tw_dy);
+            c->tw_dy = tween_start(&c->dy, c->dy, c->dy - lift, 0.18f, EASE_OUT_CUBIC);
+        }
+        if (!n || (n->live && c->seq < n->seq)) n = c;
+    }
+    notif_free(n);
+    n->live = true;
+    n->row = row;
+    n->seq = ++g->notif_seq;
+    SDL_snprintf(n->text, sizeof(n->text), "%s", txt);
+    n->col = col;
+    n->tw_alpha = tween_start(&n->alpha, 1.f, 0.f, life, EASE_IN_QUAD);
+    n->tw_dy    = tween_start(&n->dy, 6.f, 0.f, 0.2f, EASE_OUT_CUBIC);
 }
 
 static char* read_file_all(const char* path) {
@@ -163,315 +143,289 @@ static char* read_file_all(const char* path) {
     return buf;
 }
 
-static bool lang_load(Lang* out, const char* path) {
-    memset(out, 0, sizeof(*out));
-    char* json = read_file_all(path);
-    if (!json) return false;
+// з архіву штамп не змінюється, тож hot-reload фактично працює лише з теками (dev-режим)
+static void scenes_watch_stamp(Game* g, const char* scene_path) {
+    Uint64 mt, sz;
+    g->scenes_mtime = 0; g->scenes_size = 0;
+    if (asset_stamp(scene_path, &mt, &sz)) { g->scenes_mtime = (time_t)mt; g->scenes_size = (long)sz; }
+}
 
-    cJSON* root = cJSON_Parse(json);
-    if (!root){ free(json); return false; }
+// лічильники відвідин ростуть разом із таблицею сцен (hot-reload дописує нові в кінець)
+static bool runtime_fit(SceneRuntime* rt, int count) {
+    if (count <= rt->visits_n) return true;
+    int* grown = (int*)realloc(rt->visits, (size_t)count * sizeof(int));
+    if (!grown) { SDL_Log("scene runtime: out of memory for %d scenes", count); return false; }
+    memset(grown + rt->visits_n, 0, (size_t)(count - rt->visits_n) * sizeof(int));
+    rt->visits = grown;
+    rt->visits_n = count;
+    return true;
+}
 
-    int n = cJSON_GetArraySize(root); (void)n;
-    int count = 0;
-    for (cJSON* it = root->child; it; it = it->next)
-        if (cJSON_IsString(it)) count++;
+// нове проходження: сцени ті самі, стан — з нуля
+static void runtime_reset(SceneRuntime* rt) {
+    rt->cur = -1;
+    rt->queued = -1;
+    tween_cancel(rt->auto_tw);
+    rt->auto_tw = 0;
+    rt->auto_left = 0.f;
+    if (rt->visits) memset(rt->visits, 0, (size_t)rt->visits_n * sizeof(int));
+}
 
-    out->kv = (StringKV*)calloc(count, sizeof(StringKV));
-    out->count = 0;
-    for (cJSON* it = root->child; it; it = it->next){
-        if (!cJSON_IsString(it)) continue;
-        out->kv[out->count].key = str_dup(it->string);
-        out->kv[out->count].val = str_dup(cJSON_GetStringValue(it));
-        out->count++;
-    }
+static void runtime_free(SceneRuntime* rt) {
+    tween_cancel(rt->auto_tw);
+    free(rt->visits);
+    memset(rt, 0, sizeof(*rt));
+    rt->cur = rt->queued = -1;
+}
 
-    cJSON_Delete(root);
-    free(json);
-    return true;
+static bool scenes_load(Game* g, const char* scene_path)
+{
+    if (!scenes_parse_file(scene_path, &g->lang, &g->scenes, &g->scenes_count, &g->start_scene, &g->scene_ix)) return false;
+    scenes_watch_stamp(g, scene_path);
+    return runtime_fit(&g->rt, g->scenes_count);
 }
 
-static const char* lang_get(const Lang* lang, const char* key) {
-    if (!lang || !key) return NULL;
-    for (int i=0; i<lang->count; ++i) {
-        if (strcmp(lang->kv[i].key, key)==0) return lang->kv[i].val;
-    }
-    return NULL;
+static void scenes_free(Game* g) {
+    if(!g->scenes) return;
+    for (int i=0;i<g->scenes_count;i++) scene_free_content(&g->scenes[i]);
+    free(g->scenes);
+    g->scenes = NULL; g->scenes_count = 0; g->start_scene = -1;
+    strindex_free(&g->scene_ix);
 }
 
-static void lang_free(Lang* lang) {
-    if (!lang || !lang->kv) return;
-    for (int i=0;i<lang->count;++i){ free(lang->kv[i].key); free(lang->kv[i].val); }
-    free(lang->kv);
-    memset(lang, 0, sizeof(*lang));
+// ===== Старт =====
+static void menu_activate(Game* g, int i);
+
+static double ms_since(Uint64 t0) {
+    return (double)(SDL_GetPerformanceCounter() - t0) * 1000.0 / (double)SDL_GetPerformanceFrequency();
 }
 
-static char* assets_full_path2(const char* rel) {
-    const char* with_assets = rel;
-    char tmp[512];
-    if (SDL_strncasecmp(rel, "assets/", 7) != 0) {
-        SDL_snprintf(tmp, sizeof(tmp), "assets/%s", rel);
-        with_assets = tmp;
+// фоновий потік: рядки -> сюжет (тексти локалізуються при розборі) -> фон стартової сцени
+static int startup_worker(void* ud) {
+    Startup* S = (Startup*)ud;
+    char lp[128];
+    SDL_snprintf(lp, sizeof(lp), "assets/strings/%s.json", S->lang_code[0] ? S->lang_code : "ua");
+    if (!lang_load(&S->lang, lp)) {
+        SDL_Log("lang_load failed, fallback to ua");
+        lang_load(&S->lang, "assets/strings/ua.json");
     }
+    S->scenes_ok = scenes_parse_file(SCENES_PATH, &S->lang, &S->scenes, &S->scenes_count, &S->start_scene, &S->scene_ix);
 
-    char* base = SDL_GetBasePath();
-    if (!base) return SDL_strdup(with_assets);
-
-    size_t nb = SDL_strlen(base), nr = SDL_strlen(with_assets);
-    char* p = (char*)malloc(nb + nr + 1);
-    if (!p) { SDL_free(base); return NULL; }
-    memcpy(p, base, nb);
-    memcpy(p + nb, with_assets, nr + 1);
-    SDL_free(base);
-    return p;
+    if (S->scenes_ok && S->start_scene >= 0 && S->scenes[S->start_scene].background) {
+        SDL_snprintf(S->first_bg, sizeof(S->first_bg), "%s", S->scenes[S->start_scene].background);
+        char path[256]; texcache_key(S->first_bg, path, sizeof(path));
+        S->first_bg_surf = imgcache_load(path); // текстуру створить головний потік
+    }
+    SDL_AtomicSet(&S->done, 1);
+    return 0;
 }
 
-typedef struct { char* id; } IdMap;
+// результати потоку -> Game (головний потік). Блокує, якщо потік ще працює.
+static void startup_adopt(Game* g) {
+    Startup* S = &g->startup;
+    if (S->ready) return;
+    if (S->thread) { SDL_WaitThread(S->thread, NULL); S->thread = NULL; }
+
+    g->lang = S->lang;
+    memset(&S->lang, 0, sizeof(S->lang));
+    if (S->scenes_ok) {
+        g->scenes = S->scenes; g->scenes_count = S->scenes_count; g->start_scene = S->start_scene;
+        g->scene_ix = S->scene_ix;
+        scenes_watch_stamp(g, SCENES_PATH);
+        runtime_fit(&g->rt, g->scenes_count);
+    } else {
+        SDL_Log("scenes_load failed");
+    }
+    S->scenes = NULL;
+    memset(&S->scene_ix, 0, sizeof(S->scene_ix));
+    if (S->first_bg_surf) texcache_adopt(S->first_bg, S->first_bg_surf);
+    S->first_bg_surf = NULL;
+    residency_refresh(g); // поки гравець у меню — підвантажуємо початок сюжету
+
+    S->ready = true;
+    g->ui.valid = false; // підписи меню — уже з каталогу рядків
+    SDL_Log("startup: story ready in %.1f ms (%d scenes)", ms_since(S->t0), g->scenes_count);
+
+    int pending = S->pending;
+    S->pending = -1;
+    if (pending >= 0) menu_activate(g, pending); // «Нова гра», натиснута під час завантаження
+}
 
-static int find_scene_index(Scene* arr, int count, const char* id) {
-    for (int i=0;i<count;++i) if (arr[i].id && strcmp(arr[i].id, id)==0) return i;
-    return -1;
+// раз на кадр: забрати результати, щойно потік закінчив
+static void startup_poll(Game* g) {
+    if (!g->startup.ready && SDL_AtomicGet(&g->startup.done)) startup_adopt(g);
 }
 
-// Підтягнути локалізований рядок: якщо "str:key" -> взяти з lang, інакше повернути як є.
-static char* resolve_str(const Lang* lang, const cJSON* node){
-    if (!cJSON_IsString(node)) return NULL;
-    const char* v = node->valuestring;
-    if (strncmp(v, "str:", 4) == 0){
-        const char* k = v + 4;                      // ключ після "str:"
-        const char* loc = lang_get(lang, k);        // пошук у словнику
-        return str_dup(loc ? loc : k);              // копіюємо рядок
+void game_wait_ready(Game* g) { startup_adopt(g); }
+
+static void startup_begin(Game* g) {
+    Startup* S = &g->startup;
+    SDL_snprintf(S->lang_code, sizeof(S->lang_code), "%s", g->lang_code);
+    SDL_AtomicSet(&S->done, 0);
+    S->thread = SDL_CreateThread(startup_worker, "startup", S);
+    if (!S->thread) {
+        SDL_Log("startup: no worker thread (%s), loading inline", SDL_GetError());
+        startup_worker(S);
     }
-    return str_dup(v);                               // звичайний текст
 }
 
-static bool scenes_load(Game* g, const char* scene_path)
-{
-    bool ok = false;
-    char* json = read_file_all(scene_path);
-    if (!json) return false;
+// таймер auto_next: стоїть на паузі, доки репліка не допечатається (крок 7 у game_update)
+static void auto_start(SceneRuntime* rt, const Scene* s) {
+    tween_cancel(rt->auto_tw);
+    rt->auto_tw = 0;
+    rt->auto_left = s->auto_time;
+    if (s->auto_time <= 0.f || s->auto_next < 0 || s->num_choices != 0) return;
+    rt->auto_tw = tween_start(&rt->auto_left, s->auto_time, 0.f, s->auto_time, EASE_LINEAR);
+    tween_pause(rt->auto_tw, true);
+}
 
-    cJSON* root = cJSON_Parse(json);
-    if (!root) { free(json); return false; }
-
-    const cJSON* jstart = cJSON_GetObjectItemCaseSensitive(root, "start");
-    const cJSON* jscenes = cJSON_GetObjectItemCaseSensitive(root, "scenes");
-    if (!cJSON_IsString(jstart) || !cJSON_IsArray(jscenes)) {
-        cJSON_Delete(root); free(json); return false;
-    }
-
-    const int count = cJSON_GetArraySize(jscenes);
-    g->scenes = (Scene*)calloc(count, sizeof(Scene));
-    g->scenes_count = count;
-
-    // тимчасово збережемо next-id для кожного choice (макс 4 на сцену)
-    char** next_ids = (char**)calloc(count * 4, sizeof(char*));
-    if (!next_ids) { cJSON_Delete(root); free(json); return false; }
-
-    // ---- 1) ПЕРШИЙ ПРОХІД: парсимо сцени
-    int sidx = 0;
-    const cJSON* it = NULL;
-    cJSON_ArrayForEach(it, jscenes) {
-        Scene* S = &g->scenes[sidx];
-
-        const cJSON* jid    = cJSON_GetObjectItemCaseSensitive(it, "id");
-        const cJSON* jsp    = cJSON_GetObjectItemCaseSensitive(it, "speaker");
-        const cJSON* jtext  = cJSON_GetObjectItemCaseSensitive(it, "text");
-        const cJSON* jbg    = cJSON_GetObjectItemCaseSensitive(it, "background");
-        const cJSON* jmu    = cJSON_GetObjectItemCaseSensitive(it, "music");
-        const cJSON* jtitle = cJSON_GetObjectItemCaseSensitive(it, "title");
-        const cJSON* jauto  = cJSON_GetObjectItemCaseSensitive(it, "auto_time");
-        const cJSON* jaNext = cJSON_GetObjectItemCaseSensitive(it, "auto_next");
-        const cJSON* jchoices = cJSON_GetObjectItemCaseSensitive(it, "choices");
-        const cJSON* jcin = cJSON_GetObjectItemCaseSensitive(it, "cinematic");
-        S->cinematic = cJSON_IsTrue(jcin);
-
-
-        if (!cJSON_IsString(jid)) {
-            goto cleanup; // поганий json
-        }
+// Оновити діалог, якщо поточну сцену перезібрано (старі рядки вже звільнені)
+static void dialog_refresh_from_scene(Game* g) {
+    if (g->rt.cur < 0 || g->rt.cur >= g->scenes_count) return;
+    const Scene* s = &g->scenes[g->rt.cur];
+    if (!s->id) { g->dialog.visible = false; g->rt.cur = -1; return; }
+    g->dialog.speaker = s->speaker;
+    g->dialog.text = s->text;
+    typewriter_set_text(s->text, true);
+    g->dialog.num_choices = s->num_choices;
+    for (int i=0;i<s->num_choices;i++){
+        g->dialog.choices[i].text = s->choices[i].text;
+        g->dialog.choices[i].d_clarity = s->choices[i].d_clarity;
+        g->dialog.choices[i].d_anxiety = s->choices[i].d_anxiety;
+        g->dialog.choices[i].d_balance = s->choices[i].d_balance;
+    }
+    auto_start(&g->rt, s); // сцену перезібрано — таймер з нової тривалості
+    g->ui.valid = false;
+    vfx_enter_scene(&s->vfx, false); // без повторного спалаху/трясіння
+}
 
-        // базові поля
-        S->id      = str_dup(jid->valuestring);
-        S->speaker = resolve_str(&g->lang, jsp);
-        S->text    = resolve_str(&g->lang, jtext);
-
-        if (cJSON_IsString(jbg)) S->background = str_dup(jbg->valuestring);
-        if (cJSON_IsString(jmu)) S->music      = str_dup(jmu->valuestring);
-
-        // титри/автоперехід
-        S->title        = resolve_str(&g->lang, jtitle);
-        S->auto_time    = cJSON_IsNumber(jauto) ? (float)jauto->valuedouble : 0.f;
-        S->auto_next_id = cJSON_IsString(jaNext) ? str_dup(jaNext->valuestring) : NULL;
-        S->auto_next    = -1;
-
-        // checks (для автоматичного переходу без кнопок)
-        S->checks_count = 0;
-        const cJSON* jchecks = cJSON_GetObjectItemCaseSensitive(it, "checks");
-        if (cJSON_IsArray(jchecks)) {
-            int idx = 0;
-            const cJSON* chk = NULL;
-            cJSON_ArrayForEach(chk, jchecks) {
-                if (idx >= 4) break;
-                const cJSON* jif   = cJSON_GetObjectItemCaseSensitive(chk, "if");
-                const cJSON* jgoto = cJSON_GetObjectItemCaseSensitive(chk, "goto");
-                if (!cJSON_IsObject(jif) || !cJSON_IsString(jgoto)) continue;
-
-                SceneCheck* C = &S->checks[idx++];
-                memset(C, 0, sizeof(*C));
-                C->op_cl = C->op_anx = C->op_bal = -1;
-                C->goto_id = str_dup(jgoto->valuestring);
-                C->goto_index = -1;
-
-                parse_cmp(cJSON_GetObjectItemCaseSensitive(jif,"clarity"),  &C->op_cl,  &C->val_cl);
-                parse_cmp(cJSON_GetObjectItemCaseSensitive(jif,"anxiety"),  &C->op_anx, &C->val_anx);
-                parse_cmp(cJSON_GetObjectItemCaseSensitive(jif,"balance"),  &C->op_bal, &C->val_bal);
-
-                const cJSON* jf  = cJSON_GetObjectItemCaseSensitive(jif,"flag");
-                const cJSON* jf2 = cJSON_GetObjectItemCaseSensitive(jif,"flag2");
-                const cJSON* jnf = cJSON_GetObjectItemCaseSensitive(jif,"not_flag");
-                if (cJSON_IsString(jf))  C->flag     = str_dup(jf->valuestring);
-                if (cJSON_IsString(jf2)) C->flag2    = str_dup(jf2->valuestring);
-                if (cJSON_IsString(jnf)) C->not_flag = str_dup(jnf->valuestring);
-                S->checks_count = idx;
-            }
-        }
+// Hot-reload: весь файл розбирається й локалізується у fresh, далі латаємо поточні сцени за id.
+// Сцени з тим самим хешем вмісту (src_hash) відкидаємо — заміняються лише змінені.
+// Повний розбір замість розбору лише змінених сцен — свідомо: він дешевий (див. scenes_parse_file),
+// а так зіпсований файл відкидається цілком і не лишає сюжет напівоновленим.
+// Індекси сцен стабільні: нові дописуються в кінець, видалені лишаються порожніми слотами (id == NULL),
+// тож rt.cur, стати й прапорці не чіпаємо. relocalize: мова змінилась — перезібрати всі тексти.
+static bool scenes_reload(Game* g, const char* scene_path, bool relocalize)
+{
+    if (!g->scenes) return scenes_load(g, scene_path);
+
+    // спершу весь файл — у тимчасовий масив: зіпсований файл не чіпає поточних сцен
+    Scene* fresh = NULL;
+    int file_count = 0, file_start = -1;
+    StrIndex fresh_ix;
+    if (!scenes_parse_file(scene_path, &g->lang, &fresh, &file_count, &file_start, &fresh_ix)) {
+        SDL_Log("scenes_reload: can't parse %s, keeping old scenes", scene_path);
+        scenes_watch_stamp(g, scene_path); // не спамимо лог, чекаємо наступного збереження
+        return false;
+    }
+    strindex_free(&fresh_ix); // id у файлі вже унікальні; далі зіставляємо зі старими
+
+    const int old_count = g->scenes_count;
+    bool* seen    = (bool*)calloc(old_count + file_count + 1, sizeof(bool));
+    bool* changed = (bool*)calloc(old_count + file_count + 1, sizeof(bool));
+    int*  target  = (int*)malloc((file_count + 1) * sizeof(int));
+    if (!seen || !changed || !target) {
+        free(seen); free(changed); free(target);
+        for (int i = 0; i < file_count; ++i) scene_free_content(&fresh[i]);
+        free(fresh);
+        return false;
+    }
+    // куди лягає кожна сцена файлу — до будь-яких звільнень: ключі індексу живуть у старих arena
+    int n_new = 0;
+    for (int pos = 0; pos < file_count; ++pos) {
+        target[pos] = strindex_get(&g->scene_ix, fresh[pos].id);
+        if (target[pos] < 0) n_new++;
+    }
+    // нові сцени — одним realloc на всі, а не по одному на кожну
+    bool can_add = true;
+    if (n_new > 0) {
+        Scene* grown = (Scene*)realloc(g->scenes, (size_t)(g->scenes_count + n_new) * sizeof(Scene));
+        if (grown) g->scenes = grown;
+        else { SDL_Log("scenes_reload: out of memory, %d new scenes skipped", n_new); can_add = false; }
+    }
 
-        // choices
-        S->num_choices = 0;
-        if (cJSON_IsArray(jchoices)) {
-            int cidx = 0;
-            const cJSON* jc = NULL;
-            cJSON_ArrayForEach(jc, jchoices) {
-                if (cidx >= 4) break;
-                SceneChoice* C = &S->choices[cidx];
-
-                const cJSON* jt = cJSON_GetObjectItemCaseSensitive(jc, "text");
-                const cJSON* je = cJSON_GetObjectItemCaseSensitive(jc, "effects");
-                const cJSON* jn = cJSON_GetObjectItemCaseSensitive(jc, "next");
-
-                C->text = resolve_str(&g->lang, jt);
-                C->d_clarity = C->d_anxiety = C->d_balance = 0;
-                if (cJSON_IsObject(je)) {
-                    const cJSON* jcl = cJSON_GetObjectItemCaseSensitive(je, "clarity");
-                    const cJSON* jan = cJSON_GetObjectItemCaseSensitive(je, "anxiety");
-                    const cJSON* jba = cJSON_GetObjectItemCaseSensitive(je, "balance");
-                    if (cJSON_IsNumber(jcl)) C->d_clarity = (int)jcl->valuedouble;
-                    if (cJSON_IsNumber(jan)) C->d_anxiety = (int)jan->valuedouble;
-                    if (cJSON_IsNumber(jba)) C->d_balance = (int)jba->valuedouble;
-                }
+    int n_changed = 0, n_added = 0, n_removed = 0, start = -1;
+    bool cur_changed = false;
 
-                // тимчасово збережемо next id
-                const int flat = sidx * 4 + cidx;
-                next_ids[flat] = cJSON_IsString(jn) ? str_dup(jn->valuestring) : NULL;
-                C->next = -1;
-
-                // flags+ / flags-
-                C->add_flags_n = C->rem_flags_n = 0;
-                const cJSON* jadd = cJSON_GetObjectItemCaseSensitive(jc, "flags+");
-                const cJSON* jrem = cJSON_GetObjectItemCaseSensitive(jc, "flags-");
-                if (cJSON_IsArray(jadd)) {
-                    const cJSON* itf = NULL;
-                    cJSON_ArrayForEach(itf, jadd) {
-                        if (!cJSON_IsString(itf)) continue;
-                        if (C->add_flags_n < 4) C->add_flags[C->add_flags_n++] = str_dup(itf->valuestring);
-                    }
-                }
-                if (cJSON_IsArray(jrem)) {
-                    const cJSON* itf = NULL;
-                    cJSON_ArrayForEach(itf, jrem) {
-                        if (!cJSON_IsString(itf)) continue;
-                        if (C->rem_flags_n < 4) C->rem_flags[C->rem_flags_n++] = str_dup(itf->valuestring);
-                    }
-                }
+    for (int pos = 0; pos < file_count; ++pos) {
+        Scene* tmp = &fresh[pos];
+        int idx = target[pos];
 
-                cidx++; S->num_choices = cidx;
-            }
+        if (pos == file_start) start = idx;
+        if (idx >= 0 && !relocalize && g->scenes[idx].src_hash == tmp->src_hash) {
+            seen[idx] = true;
+            scene_free_content(tmp); continue;
         }
 
-        sidx++;
+        if (idx < 0) {
+            if (!can_add) { scene_free_content(tmp); continue; }
+            idx = g->scenes_count++;
+            n_added++;
+            if (pos == file_start) start = idx;
+        } else {
+            scene_free_content(&g->scenes[idx]);
+            n_changed++;
+        }
+        g->scenes[idx] = *tmp; // рядки (arena) переходять разом зі сценою
+        seen[idx] = changed[idx] = true;
+        if (idx == g->rt.cur) cur_changed = true;
+    }
+    free(fresh);
+    free(target);
+
+    // сцени, яких більше немає у файлі -> порожній слот
+    for (int i = 0; i < old_count; ++i) {
+        if (seen[i] || !g->scenes[i].id) continue;
+        scene_free_content(&g->scenes[i]);
+        n_removed++;
+        if (i == g->rt.cur) cur_changed = true;
     }
+    scenes_index(&g->scene_ix, g->scenes, g->scenes_count); // O(N), ключі — уже нові arena
 
-    // ---- 2) ДРУГИЙ ПРОХІД: резолвимо next / auto_next / checks.goto
+    // ребра: повністю — у змінених сценах; в інших — лише ті, що могли «поїхати» через додані/видалені id
     for (int i = 0; i < g->scenes_count; ++i) {
-        for (int c = 0; c < g->scenes[i].num_choices; ++c) {
-            const int flat = i * 4 + c;
-            if (next_ids[flat]) {
-                const int ni = find_scene_index(g->scenes, g->scenes_count, next_ids[flat]);
-                g->scenes[i].choices[c].next = ni; // лишимо -1 якщо не знайдено
-                free(next_ids[flat]);
-                next_ids[flat] = NULL;
-            }
-        }
-        if (g->scenes[i].auto_next_id) {
-            g->scenes[i].auto_next =
-                find_scene_index(g->scenes, g->scenes_count, g->scenes[i].auto_next_id);
-        }
-        if (g->scenes[i].checks_count > 0) {
-            for (int k = 0; k < g->scenes[i].checks_count; ++k) {
-                SceneCheck* C = &g->scenes[i].checks[k];
-                if (C->goto_id) {
-                    C->goto_index = find_scene_index(g->scenes, g->scenes_count, C->goto_id);
-                }
-            }
-        }
+        if (!g->scenes[i].id) continue;
+        if (changed[i]) scene_link(&g->scenes[i], g->scenes, &g->scene_ix, false);
+        else if (n_added || n_removed) scene_link(&g->scenes[i], g->scenes, &g->scene_ix, true);
     }
+    g->start_scene = start;
+    runtime_fit(&g->rt, g->scenes_count);
 
-    // ---- 3) стартова сцена
-    g->start_scene = find_scene_index(g->scenes, g->scenes_count, jstart->valuestring);
-    ok = true;
+    if (cur_changed) dialog_refresh_from_scene(g);
+    if (n_changed || n_added || n_removed) residency_refresh(g);
 
-cleanup:
-    if (next_ids) {
-        // прибери залишки, якщо були ранні виходи
-        for (int i = 0; i < count * 4; ++i) free(next_ids[i]);
-        free(next_ids);
-    }
-    cJSON_Delete(root);
-    free(json);
-    return ok;
-}
+    SDL_Log("scenes_reload: %d changed, %d added, %d removed", n_changed, n_added, n_removed);
 
-static void scenes_free(Game* g) {
-    if(!g->scenes) return;
-    for (int i=0;i<g->scenes_count;i++){
-        Scene* S = &g->scenes[i];
-        free(S->id); free(S->speaker); free(S->text); free(S->background); free(S->music); free(S->title); free(S->auto_next_id);
-        for (int c=0;c<S->num_choices;c++) free(S->choices[c].text);
-        for (int k=0; k<S->checks_count; ++k) {
-            free(S->checks[k].flag);
-            free(S->checks[k].flag2);
-            free(S->checks[k].not_flag);
-            free(S->checks[k].goto_id);
-        }
-        for (int c = 0; c < S->num_choices; ++c) {
-            for (int k = 0; k < S->choices[c].add_flags_n; ++k) free(S->choices[c].add_flags[k]);
-            for (int k = 0; k < S->choices[c].rem_flags_n; ++k) free(S->choices[c].rem_flags[k]);
-        }
-    }
-    free(g->scenes);
-    g->scenes = NULL; g->scenes_count = 0; g->start_scene = -1;
+    free(seen); free(changed);
+    scenes_watch_stamp(g, scene_path);
+    return true;
 }
 
-static SDL_Texture* load_texture(SDL_Renderer* r, const char* path);
+#define FADE_TIME (1.f / 4.5f) // повне затемнення (і стільки ж назад), с
 
-static void start_fade_to(Game* g, int next) { g->fade_dir = +1.f; g->fade_queued_scene = next; }
+// темніє від поточного рівня з тією ж швидкістю — перехід посеред fade не смикається
+static void start_fade_to(Game* g, int next) {
+    tween_cancel(g->fade_tw);
+    g->fade_tw = tween_start(&g->fade, g->fade, 1.f, FADE_TIME * (1.f - g->fade), EASE_LINEAR);
+    g->fade_to_black = true;
+    g->rt.queued = next;
+}
 
 static void scene_show_immediate(Game* g, int idx) {
-    if (idx < 0 || idx >= g->scenes_count){ g->dialog.visible=false; g->cur_scene=-1; return; }
-    g->cur_scene = idx;
+    if (idx < 0 || idx >= g->scenes_count || !g->scenes[idx].id){ g->dialog.visible=false; g->rt.cur=-1; g->ui.valid=false; return; }
+    g->rt.cur = idx;
     g->dialog.visible = true;
-    g->dialog.hovered = -1;
 
-    Scene* s = &g->scenes[idx];
+    const Scene* s = &g->scenes[idx];
     // --- auto-branch за checks ---
     if (s->checks_count > 0) {
         for (int k=0; k<s->checks_count; ++k) {
-            SceneCheck* C = &s->checks[k];
+            const SceneCheck* C = &s->checks[k];
             if (C->goto_index < 0) continue;
 
             int cl  = (int)g->memory_clarity_t; // використовуй цільові значення
             int anx = (int)g->anxiety_t;
-            int bal = g->balance_t;
+            int bal = (int)g->balance_t;
 
             int cond =
                 test_cmp(C->op_cl,  cl,  C->val_cl) &&
@@ -491,64 +445,64 @@ static void scene_show_immediate(Game* g, int idx) {
             }
         }
     }
+    // лічильник і таймер — у стані проходження; сама сцена не змінюється
+    auto_start(&g->rt, s);
+    if (idx < g->rt.visits_n) g->rt.visits[idx]++;
+
     g->dialog.speaker = s->speaker;
     g->dialog.text = s->text;
+    typewriter_set_text(s->text, false);
     g->dialog.num_choices = s->num_choices;
     for (int i=0;i<s->num_choices;i++){
         g->dialog.choices[i].text = s->choices[i].text;
         g->dialog.choices[i].d_clarity = s->choices[i].d_clarity;
         g->dialog.choices[i].d_anxiety = s->choices[i].d_anxiety;
         g->dialog.choices[i].d_balance = s->choices[i].d_balance;
-        g->dialog.choices[i].rect = (SDL_Rect){0,0,0,0};
     }
+    g->ui.valid = false; // прямокутники кнопок — у ui_layout
+    vfx_enter_scene(&s->vfx, true);
     if (s->background) {
-        SDL_Texture* newbg = load_texture_cached(g->renderer, s->background);
+        SDL_Texture* newbg = texcache_get(s->background);
         if (newbg) { g->bg = newbg; } // не знищуємо — кеш володіє ресурсом
     }
 
     if (s->music) {
         if (SDL_strcasecmp(g->current_music, s->music) != 0) {
             if (g->music) { Mix_HaltMusic(); Mix_FreeMusic(g->music); g->music = NULL; }
-            char* mpath = assets_full_path2(s->music);        // <<< ДОДАНО
-            g->music = mpath ? Mix_LoadMUS(mpath) : NULL;
+            g->music = Mix_LoadMUS_RW(residency_music_open(s->music), 1);
             if (!g->music) SDL_Log("Mix_LoadMUS(%s) failed: %s", s->music, Mix_GetError());
             else {
                 SDL_snprintf(g->current_music, sizeof(g->current_music), "%s", s->music);
                 Mix_VolumeMusic(g->music_volume);
                 Mix_PlayMusic(g->music, -1);
             }
-            if (mpath) free(mpath);
         }
     }
+    residency_refresh(g);
 }
 
-static SDL_Texture* load_texture(SDL_Renderer* r, const char* path) {
-    char* full = assets_full_path2(path);
-    SDL_Texture* tex = NULL;
-    if (full) {
-        SDL_Surface* s = IMG_Load(full);
-        if (!s) SDL_Log("IMG_LoadTexture(%s) failed: %s", path, SDL_GetError());
-        else {
-            tex = SDL_CreateTextureFromSurface(r, s);
-            SDL_FreeSurface(s);
-        }
-        free(full);
-    }
-    return tex;
+// dx, dy — зсув (трясіння камери); повертає, куди лягла картинка
+// куди лягає фон, вписаний у вікно зі збереженням пропорцій
+static SDL_Rect bg_fit_rect(SDL_Texture* tex, int win_w, int win_h) {
+    if (!tex) return (SDL_Rect){0,0,0,0};
+    int tw=0, th=0; SDL_QueryTexture(tex, NULL, NULL, &tw, &th);
+    if (tw <= 0 || th <= 0) return (SDL_Rect){0,0,0,0};
+    float s = SDL_min((float)win_w/tw, (float)win_h/th);
+    int w = (int)(tw*s), h = (int)(th*s);
+    return (SDL_Rect){ (win_w - w)/2, (win_h - h)/2, w, h };
 }
 
-static void render_bg_fit(SDL_Renderer* r, SDL_Texture* tex, int win_w, int win_h) {
+static SDL_Rect render_bg_fit(SDL_Renderer* r, SDL_Texture* tex, int win_w, int win_h, int dx, int dy) {
     // завжди чистимо чорним (або темним бекґраундом)
     SDL_SetRenderDrawColor(r, 0, 0, 0, 255);
     SDL_RenderClear(r);
 
-    if (!tex) return;
+    if (!tex) return (SDL_Rect){0,0,0,0};
 
-    int tw=0, th=0; SDL_QueryTexture(tex, NULL, NULL, &tw, &th);
-    float s = SDL_min((float)win_w/tw, (float)win_h/th);
-    int w = (int)(tw*s), h = (int)(th*s);
-    SDL_Rect dst = { (win_w - w)/2, (win_h - h)/2, w, h };
+    SDL_Rect dst = bg_fit_rect(tex, win_w, win_h);
+    dst.x += dx; dst.y += dy;
     SDL_RenderCopy(r, tex, NULL, &dst);
+    return dst;
 }
 
 static void play_music(Game* g, const char* rel) {
@@ -557,167 +511,321 @@ static void play_music(Game* g, const char* rel) {
 
     if (g->music) { Mix_HaltMusic(); Mix_FreeMusic(g->music); g->music = NULL; }
 
-    char* full = assets_full_path2(rel);
-    g->music = full ? Mix_LoadMUS(full) : NULL;
+    g->music = Mix_LoadMUS_RW(residency_music_open(rel), 1);
     if (g->music) {
         SDL_snprintf(g->current_music, sizeof(g->current_music), "%s", rel);
         Mix_VolumeMusic(g->music_volume);
         Mix_PlayMusic(g->music, -1);
     }
-    if (full) free(full);
 }
 
-static void render_settings(Game* g) {
-    SDL_SetRenderDrawColor(g->renderer, 20,24,32,255);
-    SDL_RenderClear(g->renderer);
+// ===== Віджети =====
+// Індекс віджета в дереві = його id: додаємо строго в порядку переліку.
+enum { MW_NEW, MW_CONTINUE, MW_SETTINGS, MW_EXIT };
+enum { SW_TITLE, SW_RES, SW_FS, SW_LANG, SW_SCALE, SW_VOL, SW_VOL_LBL, SW_APPLY, SW_BACK };
+enum { DW_PANEL, DW_SPEAKER, DW_CHOICE0 };
+
+static void ui_build(Game* g) {
+    UiTree* m = &g->ui_menu;
+    ui_tree_init(m);
+    for (int i = MW_NEW; i <= MW_EXIT; ++i) {
+        ui_add(m, UI_BUTTON, i);
+        m->w[i].center = true;
+        m->w[i].font_px = FONT_PX;
+    }
 
-    int cx = g->width/2;
-    draw_text_col(g->renderer, g->font, (SDL_Color){234,239,244,255}, "SETTINGS", cx-60, g->height/2-160);
-
-    // --- Resolution ---
-    SDL_Rect r_res = { 40, g->height/2 - 100, 280, 40 };
-    SDL_SetRenderDrawColor(g->renderer, 28,32,40,255); SDL_RenderFillRect(g->renderer, &r_res);
-    SDL_SetRenderDrawColor(g->renderer, 36,42,51,190); SDL_RenderDrawRect(g->renderer, &r_res);
-    char res_txt[64]; SDL_snprintf(res_txt, sizeof(res_txt), "Resolution: %dx%d",
-           RES_LIST[g->set_sel_res][0], RES_LIST[g->set_sel_res][1]);
-    draw_text_col(g->renderer, g->font, (SDL_Color){210,210,210,255}, res_txt, r_res.x+10, r_res.y+10);
-
-    if (g->set_drop_res_open) {
-        for (int i=0;i<RES_COUNT;i++) {
-            SDL_Rect r = { r_res.x, r_res.y + 40 + i*36, r_res.w, 34 };
-            SDL_SetRenderDrawColor(g->renderer, i==g->set_sel_res?40:28, i==g->set_sel_res?48:32, i==g->set_sel_res?60:40, 255);
-            SDL_RenderFillRect(g->renderer, &r);
-            SDL_SetRenderDrawColor(g->renderer, 36,42,51,190); SDL_RenderDrawRect(g->renderer, &r);
-            char txt[32]; SDL_snprintf(txt, sizeof(txt), "%dx%d", RES_LIST[i][0], RES_LIST[i][1]);
-            draw_text_col(g->renderer, g->font, (SDL_Color){234,239,244,255}, txt, r.x+10, r.y+8);
-        }
+    const SDL_Color c_box = {28,32,40,255}, c_sel = {40,48,60,255}, c_border = {36,42,51,190};
+    UiTree* st = &g->ui_settings;
+    ui_tree_init(st);
+    ui_add(st, UI_LABEL,    SW_TITLE);
+    ui_add(st, UI_DROPDOWN, SW_RES);
+    ui_add(st, UI_TOGGLE,   SW_FS);
+    ui_add(st, UI_BUTTON,   SW_LANG);
+    ui_add(st, UI_BUTTON,   SW_SCALE);
+    ui_add(st, UI_SLIDER,   SW_VOL);
+    ui_add(st, UI_LABEL,    SW_VOL_LBL);
+    ui_add(st, UI_BUTTON,   SW_APPLY);
+    ui_add(st, UI_BUTTON,   SW_BACK);
+    for (int i = 0; i < st->count; ++i) {
+        Widget* w = &st->w[i];
+        w->font_px = FONT_PX;
+        w->bg = w->bg_active = c_box;          // у налаштуваннях без підсвітки під курсором
+        w->border = w->border_active = c_border;
+        w->fg = (SDL_Color){210,210,210,255};
+    }
+    st->w[SW_TITLE].fg = (SDL_Color){234,239,244,255};
+    ui_set_text(st, SW_TITLE, "SETTINGS");
+    st->w[SW_RES].bg_active = c_sel;           // вибраний пункт списку
+    for (int i=0;i<RES_COUNT && i<UI_MAX_ITEMS;i++) {
+        char txt[24]; SDL_snprintf(txt, sizeof(txt), "%dx%d", RES_LIST[i][0], RES_LIST[i][1]);
+        ui_set_item(st, SW_RES, i, txt);
+    }
+    st->w[SW_VOL].bg = (SDL_Color){60,66,76,255};          // доріжка
+    st->w[SW_VOL].bg_active = (SDL_Color){110,178,191,255}; // повзунок
+    st->w[SW_VOL].vmax = 128;
+    st->w[SW_VOL_LBL].fg = (SDL_Color){170,178,190,255};
+    ui_set_text(st, SW_APPLY, "Apply");
+    ui_set_text(st, SW_BACK, "Back");
+    for (int i = SW_APPLY; i <= SW_BACK; ++i) {
+        st->w[i].center = true;
+        st->w[i].fg = (SDL_Color){234,239,244,255};
+    }
+    st->w[SW_APPLY].bg = st->w[SW_APPLY].bg_active = c_sel;
+
+    UiTree* d = &g->ui_dialog;
+    ui_tree_init(d);
+    ui_add(d, UI_PANEL, DW_PANEL);
+    d->w[DW_PANEL].bg = (SDL_Color){20,24,32,200};
+    ui_add(d, UI_LABEL, DW_SPEAKER);
+    for (int i = 0; i < 4; ++i) {
+        Widget* w = &d->w[ui_add(d, UI_BUTTON, DW_CHOICE0 + i)];
+        w->border_active = (SDL_Color){110,178,191,255};
     }
+}
 
-    // --- Fullscreen ---
-    SDL_Rect r_fs = { 40, r_res.y + (g->set_drop_res_open ? 40+RES_COUNT*36 : 50), 220, 40 };
-    SDL_SetRenderDrawColor(g->renderer, 28,32,40,255); SDL_RenderFillRect(g->renderer, &r_fs);
-    SDL_SetRenderDrawColor(g->renderer, 36,42,51,190); SDL_RenderDrawRect(g->renderer, &r_fs);
-    draw_text_col(g->renderer, g->font, (SDL_Color){210,210,210,255},
-                  g->set_fullscreen? "Fullscreen: ON":"Fullscreen: OFF", r_fs.x+10, r_fs.y+10);
-
-    // --- Language (циклічний дропдаун) ---
-    SDL_Rect r_lang = { 40, r_fs.y + 50, 220, 40 };
-    SDL_SetRenderDrawColor(g->renderer, 28,32,40,255); SDL_RenderFillRect(g->renderer, &r_lang);
-    SDL_SetRenderDrawColor(g->renderer, 36,42,51,190); SDL_RenderDrawRect(g->renderer, &r_lang);
-    char ltxt[64]; SDL_snprintf(ltxt, sizeof(ltxt), "Language: %s", LANGS[g->set_lang_idx]);
-    draw_text_col(g->renderer, g->font, (SDL_Color){210,210,210,255}, ltxt, r_lang.x+10, r_lang.y+10);
-
-    // --- Music Volume (slider) ---
-    SDL_Rect r_vol_line = { 40, r_lang.y + 70, 340, 6 };
-    g->set_vol_rect = r_vol_line;
-    SDL_SetRenderDrawColor(g->renderer, 60,66,76,255); SDL_RenderFillRect(g->renderer, &r_vol_line);
-
-    float t = SDL_clamp(g->music_volume/128.0f, 0.f, 1.f);
-    int knob_x = r_vol_line.x + (int)(t*(r_vol_line.w-12));
-    SDL_Rect knob = { knob_x, r_vol_line.y - 7, 12, 20 };
-    SDL_SetRenderDrawColor(g->renderer, 110,178,191,255); SDL_RenderFillRect(g->renderer, &knob);
-
-    char vt[32]; SDL_snprintf(vt, sizeof(vt), "Music: %d/128", g->music_volume);
-    draw_text_col(g->renderer, g->font, (SDL_Color){170,178,190,255}, vt, r_vol_line.x+360, r_vol_line.y-8);
-
-    // --- Apply / Back ---
-    SDL_Rect r_apply = { g->width - 220, g->height - 60, 80, 36 };
-    SDL_Rect r_back  = { g->width - 120, g->height - 60, 80, 36 };
-    SDL_SetRenderDrawColor(g->renderer, 40,48,60,255); SDL_RenderFillRect(g->renderer, &r_apply);
-    SDL_SetRenderDrawColor(g->renderer, 36,42,51,190); SDL_RenderDrawRect(g->renderer, &r_apply);
-    SDL_SetRenderDrawColor(g->renderer, 28,32,40,255); SDL_RenderFillRect(g->renderer, &r_back);
-    SDL_SetRenderDrawColor(g->renderer, 36,42,51,190); SDL_RenderDrawRect(g->renderer, &r_back);
-    draw_text_col(g->renderer, g->font, (SDL_Color){234,239,244,255}, "Apply", r_apply.x+18, r_apply.y+8);
-    draw_text_col(g->renderer, g->font, (SDL_Color){234,239,244,255}, "Back",  r_back.x+22,  r_back.y+8);
+// стан гри -> віджети налаштувань (сеттери нічого не перемальовують, якщо не змінилось)
+static void settings_sync(Game* g) {
+    UiTree* st = &g->ui_settings;
+    char txt[64];
+    SDL_snprintf(txt, sizeof(txt), "Resolution: %dx%d", RES_LIST[g->set_sel_res][0], RES_LIST[g->set_sel_res][1]);
+    ui_set_text(st, SW_RES, txt);
+    ui_set_value(st, SW_RES, g->set_sel_res);
+    ui_set_value(st, SW_FS, g->set_fullscreen);
+    ui_set_text(st, SW_FS, g->set_fullscreen ? "Fullscreen: ON" : "Fullscreen: OFF");
+    SDL_snprintf(txt, sizeof(txt), "Language: %s", LANGS[g->set_lang_idx]);
+    ui_set_text(st, SW_LANG, txt);
+    SDL_snprintf(txt, sizeof(txt), "Render scale: %d%%", (int)(SCALES[g->set_scale_idx] * 100.f + 0.5f));
+    ui_set_text(st, SW_SCALE, txt);
+    ui_set_value(st, SW_VOL, g->music_volume);
+    SDL_snprintf(txt, sizeof(txt), "Music: %d/128", g->music_volume);
+    ui_set_text(st, SW_VOL_LBL, txt);
 }
 
-static void handle_settings_event(Game* g, const SDL_Event* e) {
-    // зручні локальні прямокутники (мають збігатися з render_settings)
-    SDL_Rect r_res = { 40, g->height/2 - 100, 280, 40 };
-    int res_list_top = r_res.y + 40;
-    SDL_Rect r_fs  = { 40, r_res.y + (g->set_drop_res_open? 40+RES_COUNT*36:50), 220, 40 };
-    SDL_Rect r_lang= { 40, r_fs.y + 50, 220, 40 };
-    SDL_Rect r_vol = g->set_vol_rect;
-    SDL_Rect r_apply = { g->width - 220, g->height - 60, 80, 36 };
-    SDL_Rect r_back  = { g->width - 120, g->height - 60, 80, 36 };
-
-    if (e->type == SDL_MOUSEBUTTONDOWN && e->button.button==SDL_BUTTON_LEFT) {
-        SDL_Point p = { e->button.x, e->button.y };
-
-        // Resolution dropdown
-        if (SDL_PointInRect(&p, &r_res)) {
-            g->set_drop_res_open = !g->set_drop_res_open;
-            return;
+// ===== Розкладка UI =====
+// Уся геометрія меню, налаштувань, HUD і діалогу. Рахується лише коли g->ui.valid скинуто
+// (розмір вікна, мова, сцена, розкритий список роздільностей), а не кожен кадр.
+
+// hover за останньою позицією курсора — щойно після перерахунку, а не за минулим кадром
+static void ui_rehover(Game* g) {
+    if (g->mouse_x < 0) return;
+    ui_hover(&g->ui_menu, g->mouse_x, g->mouse_y);
+    ui_hover(&g->ui_settings, g->mouse_x, g->mouse_y);
+    if (g->dialog.visible) ui_hover(&g->ui_dialog, g->mouse_x, g->mouse_y);
+}
+
+static void ui_layout(Game* g) {
+    UiLayout* L = &g->ui;
+    if (L->valid) return;
+    L->valid = true;
+    L->rev++;
+    const int W = g->width, H = g->height;
+
+    // Адаптивні коефіцієнти (потрібні і для діалогів)
+    float sW = W / 1280.f;
+    float sH = H /  720.f;
+    L->scale = SDL_clamp(SDL_min(sW, sH), 0.75f, 3.0f);
+    L->fs    = FONT_PX * L->scale; // текст масштабується разом з UI (SDF-атлас, без перерастеризації)
+    const float us = L->scale, fs = L->fs;
+
+    // ---- меню ----
+    {
+        static const char* keys[4] = { "menu.new_game", "menu.continue", "menu.settings", "menu.exit" };
+        static const char* defs[4] = { "New Game", "Continue", "Settings", "Exit" };
+        int bw = (int)(W * 0.28f), bh = 48, gap = 14;
+        int start_y = H/2 - (2*bh + 1*gap + bh);
+        for (int i=0;i<4;i++) {
+            ui_set_rect(&g->ui_menu, i, (SDL_Rect){ W/2 - bw/2, start_y + i*(bh+gap), bw, bh });
+            ui_set_text(&g->ui_menu, i, lang_get(&g->lang, keys[i]) ?: defs[i]);
         }
-        if (g->set_drop_res_open) {
-            for (int i=0;i<RES_COUNT;i++) {
-                SDL_Rect r = { r_res.x, res_list_top + i*36, r_res.w, 34 };
-                if (SDL_PointInRect(&p, &r)) {
-                    g->set_sel_res = i;
-                    g->set_drop_res_open = false;
-                    return;
-                }
+    }
+
+    // ---- налаштування (у пікселях, без масштабу) ----
+    {
+        UiTree* st = &g->ui_settings;
+        SDL_Rect r_res  = { 40, H/2 - 100, 280, 40 };
+        SDL_Rect r_fs   = { 40, r_res.y + (st->w[SW_RES].open ? 40+RES_COUNT*36 : 50), 220, 40 };
+        SDL_Rect r_lang = { 40, r_fs.y + 50, 220, 40 };
+        SDL_Rect r_scale = { 40, r_lang.y + 50, 220, 40 };
+        SDL_Rect r_vol  = { 40, r_scale.y + 70, 340, 6 };
+        ui_set_rect(st, SW_TITLE, (SDL_Rect){ W/2 - 60, H/2 - 160, 0, 0 });
+        ui_set_rect(st, SW_RES, r_res);
+        ui_set_rect(st, SW_FS, r_fs);
+        ui_set_rect(st, SW_LANG, r_lang);
+        ui_set_rect(st, SW_SCALE, r_scale);
+        ui_set_rect(st, SW_VOL, r_vol);
+        ui_set_rect(st, SW_VOL_LBL, (SDL_Rect){ r_vol.x + 360, r_vol.y - 8, 0, 0 });
+        ui_set_rect(st, SW_APPLY, (SDL_Rect){ W - 220, H - 60, 80, 36 });
+        ui_set_rect(st, SW_BACK,  (SDL_Rect){ W - 120, H - 60, 80, 36 });
+    }
+
+    // ---- HUD ----
+    {
+        float pad = 16.f * us, gap = 8.f * us;
+        L->bar_h = 18.f * us;
+        L->bar_w = (float)W * 0.34f;
+        L->hud_x = (int)pad;
+        L->hud_row_y[0] = (int)pad;
+        L->hud_row_y[1] = L->hud_row_y[0] + (int)(L->bar_h + gap);
+        L->hud_row_y[2] = L->hud_row_y[1] + (int)(L->bar_h + gap);
+
+        int w_lbl1, w_lbl2, w_lbl3;
+        font_size_text(fs, "Memory Clarity", &w_lbl1, NULL);
+        font_size_text(fs, "Anxiety",        &w_lbl2, NULL);
+        font_size_text(fs, "Balance",        &w_lbl3, NULL);
+        int label_col_w = SDL_max(SDL_max(w_lbl1, w_lbl2), w_lbl3) + (int)(12*us);
+
+        // колонка значень — під найширше можливе, щоб підкладка не «дихала» разом зі статами
+        static const char* widest[] = { "100%", "100", "+100", "-100" };
+        int value_col_w = 0;
+        for (int i=0;i<4;i++) { int w; font_size_text(fs, widest[i], &w, NULL); value_col_w = SDL_max(value_col_w, w); }
+        value_col_w += (int)(6*us);
+
+        L->bar_x   = L->hud_x + label_col_w + (int)(8*us);
+        L->value_x = (int)(L->bar_x + L->bar_w + 10*us);
+
+        int hud_left  = (int)(L->hud_x - pad*0.6f);
+        int hud_top   = (int)(L->hud_row_y[0] - pad*0.6f);
+        int hud_right = L->value_x + value_col_w + (int)(pad*0.6f);
+        int hud_h     = (int)(L->bar_h * 3.f + gap * 2.f + pad * 2.f);
+        if (hud_right > W - (int)(pad*0.4f)) hud_right = W - (int)(pad*0.4f);
+        L->hud_bg = (SDL_Rect){ hud_left, hud_top, hud_right - hud_left, hud_h };
+    }
+
+    // ---- діалог ----
+    const Scene* S = (g->rt.cur >= 0) ? &g->scenes[g->rt.cur] : NULL;
+    if (S && S->cinematic) {
+        // короткий текст посередині
+        int text_w = (int)(W * 0.8f);
+        typewriter_layout(fs, text_w, true);
+        L->cine_text = (SDL_Point){ (W - text_w)/2, (H - typewriter_height())/2 + (int)(12*us) };
+    } else {
+        // стандартна панель з виборами
+        UiTree* d = &g->ui_dialog;
+        int inner_pad = (int)(20 * us);
+        int panel_wi  = (int)(W - 2 * (16 * us));
+        int panel_hi  = (int)SDL_max(110.f * us, H * 0.18f);
+        int panel_x   = (W - panel_wi)/2;
+        int panel_y   = H - panel_hi - (int)(12 * us);
+        ui_set_rect(d, DW_PANEL, (SDL_Rect){ panel_x, panel_y, panel_wi, panel_hi });
+
+        int cur_y = panel_y + inner_pad;
+        int cur_x = panel_x + inner_pad;
+        ui_set_visible(d, DW_SPEAKER, g->dialog.speaker != NULL);
+        ui_set_rect(d, DW_SPEAKER, (SDL_Rect){ cur_x, cur_y, 0, 0 });
+        ui_set_font(d, DW_SPEAKER, fs);
+        ui_set_text(d, DW_SPEAKER, g->dialog.speaker);
+        if (g->dialog.speaker) {
+            int h; font_size_text(fs, g->dialog.speaker, NULL, &h);
+            cur_y += h + (int)(6*us);
+        }
+
+        int text_w = panel_wi - inner_pad*2;
+        typewriter_layout(fs, text_w, false);
+        int wrap_h = typewriter_height();
+
+        // геометрія кнопок
+        int btn_h   = (int)(56 * us);
+        int btn_gap = (int)(10 * us);
+        int cols    = 2;
+        int btn_w   = (text_w - btn_gap) / cols;
+        int rows    = (g->dialog.num_choices + cols - 1) / cols;
+
+        // максимально допустима висота тексту, щоб усе влізло в панель
+        int max_text_h = panel_hi - inner_pad*2
+                    - rows * btn_h
+                    - (rows ? (rows-1)*btn_gap : 0)
+                    - (int)(12 * us);          // відступ між текстом і кнопками
+        wrap_h = SDL_clamp(wrap_h, 0, SDL_max(0, max_text_h));
+        L->dlg_text = (SDL_Rect){ cur_x, cur_y, text_w, wrap_h };
+        cur_y += wrap_h + (int)(12 * us);
+
+        for (int i=0; i<4; ++i) {
+            const int w = DW_CHOICE0 + i;
+            ui_set_visible(d, w, i < g->dialog.num_choices);
+            if (i >= g->dialog.num_choices) continue;
+            const Choice* C = &g->dialog.choices[i];
+            int row = i / cols, col = i % cols;
+            ui_set_rect(d, w, (SDL_Rect){ cur_x + col * (btn_w + btn_gap), cur_y + row * (btn_h + btn_gap), btn_w, btn_h });
+            ui_set_font(d, w, fs);
+            ui_set_text(d, w, C->text);
+            char hint[64];
+            SDL_snprintf(hint, sizeof(hint), "(%+d CL, %+d ANX, %+d BAL)", C->d_clarity, C->d_anxiety, C->d_balance);
+            ui_set_sub(d, w, hint);
+            Widget* B = &d->w[w];
+            if (B->pad_x != (int)(14 * us) || B->sub_dy != (int)(20 * us)) {
+                B->pad_x  = (int)(14 * us);
+                B->pad_y  = (int)(10 * us);
+                B->sub_dy = (int)(20 * us);
+                ui_mark_dirty(d, w);
             }
         }
+    }
 
-        // Fullscreen toggle
-        if (SDL_PointInRect(&p, &r_fs)) { g->set_fullscreen = !g->set_fullscreen; return; }
+    // ---- титр сцени ----
+    if (S && S->title && S->num_choices == 0) {
+        int tw, th; font_size_text(fs, S->title, &tw, &th);
+        L->title_pos = (SDL_Point){ (W - tw)/2, (H - th)/2 };
+    }
 
-        // Language (циклічно)
-        if (SDL_PointInRect(&p, &r_lang)) { g->set_lang_idx = (g->set_lang_idx+1)%3; return; }
+    ui_rehover(g);
+}
 
-        // Volume slider begin drag
-        if (SDL_PointInRect(&p, &r_vol) ||
-            (p.x >= r_vol.x && p.x <= r_vol.x+r_vol.w && p.y >= r_vol.y-8 && p.y <= r_vol.y+16)) {
-            g->set_drag_vol = true;
-            float t = SDL_clamp((p.x - r_vol.x) / (float)SDL_max(r_vol.w,1), 0.f, 1.f);
-            g->music_volume = (int)(t * 128.f);
-            Mix_VolumeMusic(g->music_volume);
-            return;
-        }
+static void render_settings(Game* g) {
+    SDL_SetRenderDrawColor(g->renderer, 20,24,32,255);
+    SDL_RenderClear(g->renderer);
+    settings_sync(g);
+    ui_draw(&g->ui_settings);
+}
 
-        // Apply
-        if (SDL_PointInRect(&p, &r_apply)) {
-            // apply resolution
-            int nw = RES_LIST[g->set_sel_res][0], nh = RES_LIST[g->set_sel_res][1];
-            SDL_SetWindowSize(g->window, nw, nh);
-            SDL_GetWindowSize(g->window, &g->width, &g->height);
-            SDL_RenderSetViewport(g->renderer, NULL);
-            SDL_RenderSetScale(g->renderer, 1.0f, 1.0f);
+static void handle_settings_event(Game* g, const SDL_Event* e) {
+    UiAction a;
+    if (ui_dispatch(&g->ui_settings, e, &a)) {
+        switch (a.id) {
+            case SW_RES:
+                if (a.kind == UI_ACT_CHANGE) g->set_sel_res = a.value;
+                g->ui.valid = false; // список розкрито/згорнуто — рядки нижче зсуваються
+                break;
+            case SW_FS:   g->set_fullscreen = a.value; break;
+            case SW_LANG: g->set_lang_idx = (g->set_lang_idx+1)%3; break; // циклічно
+            case SW_SCALE: g->set_scale_idx = (g->set_scale_idx+1)%SCALE_COUNT; break;
+            case SW_VOL:
+                g->music_volume = a.value;
+                Mix_VolumeMusic(g->music_volume);
+                break;
+            case SW_APPLY: {
+                // apply resolution
+                int nw = RES_LIST[g->set_sel_res][0], nh = RES_LIST[g->set_sel_res][1];
+                SDL_SetWindowSize(g->window, nw, nh);
+                SDL_GetWindowSize(g->window, &g->width, &g->height);
+                SDL_RenderSetViewport(g->renderer, NULL);
+                SDL_RenderSetScale(g->renderer, 1.0f, 1.0f);
+                g->ui.valid = false;
 
-            // apply fullscreen
-            if (g->set_fullscreen != g->fullscreen) {
-                set_fullscreen(g, g->set_fullscreen);
-            }
+                g->render_scale = SCALES[g->set_scale_idx];
 
-            // apply language: reload lang + scenes
-            SDL_snprintf(g->lang_code, sizeof(g->lang_code), "%s", LANGS[g->set_lang_idx]);
-            lang_free(&g->lang);
-            char lp[128]; SDL_snprintf(lp,sizeof(lp),"assets/strings/%s.json", g->lang_code);
-            if (!lang_load(&g->lang, lp)) lang_load(&g->lang, "assets/strings/ua.json");
+                // apply fullscreen
+                if (g->set_fullscreen != g->fullscreen) {
+                    set_fullscreen(g, g->set_fullscreen);
+                }
 
-            scenes_free(g);
-            scenes_load(g, "assets/content/scenes_demo.json");
+                // apply language: reload lang + relocalize scenes (поточна сцена і прогрес лишаються)
+                if (SDL_strcasecmp(g->lang_code, LANGS[g->set_lang_idx]) != 0) {
+                    startup_adopt(g); // не перезбирати сюжет, поки його ще вантажить потік
+                    SDL_snprintf(g->lang_code, sizeof(g->lang_code), "%s", LANGS[g->set_lang_idx]);
+                    lang_free(&g->lang);
+                    char lp[128]; SDL_snprintf(lp,sizeof(lp),"assets/strings/%s.json", g->lang_code);
+                    if (!lang_load(&g->lang, lp)) lang_load(&g->lang, "assets/strings/ua.json");
 
-            Mix_VolumeMusic(g->music_volume);
-            save_config(g);
-            return;
-        }
+                    scenes_reload(g, SCENES_PATH, true);
+                }
 
-        // Back
-        if (SDL_PointInRect(&p, &r_back)) {
-            g->mode = MODE_MENU;
-            return;
+                Mix_VolumeMusic(g->music_volume);
+                save_config(g);
+                break;
+            }
+            case SW_BACK: g->mode = MODE_MENU; break;
+            default: break;
         }
-    }
-    if (e->type == SDL_MOUSEMOTION && g->set_drag_vol) {
-        float t = SDL_clamp((e->motion.x - r_vol.x) / (float)SDL_max(r_vol.w,1), 0.f, 1.f);
-        g->music_volume = (int)(t * 128.f);
-        Mix_VolumeMusic(g->music_volume);
-        return;
-    }
-    if (e->type == SDL_MOUSEBUTTONUP && e->button.button==SDL_BUTTON_LEFT) {
-        g->set_drag_vol = false;
         return;
     }
 
@@ -728,64 +836,32 @@ static void handle_settings_event(Game* g, const SDL_Event* e) {
     }
 }
 
-static void draw_text(SDL_Renderer* r, TTF_Font* f, const char* txt, int x, int y) {
-    SDL_Color col = { 210, 210, 210, 255 };
-    SDL_Surface* s = TTF_RenderUTF8_Blended(f, txt, col);
-    if (!s) return;
-    SDL_Texture* t = SDL_CreateTextureFromSurface(r, s);
-    SDL_Rect dst = { x, y, s->w, s->h };
-    SDL_FreeSurface(s);
-    if (t) {
-        SDL_RenderCopy(r, t, NULL, &dst);
-        SDL_DestroyTexture(t);
-    }
+static void draw_text(float size, const char* txt, int x, int y) {
+    if (!txt) return;
+    prim_flush(); // текст поверх уже накопичених примітивів
+    font_draw(size, (SDL_Color){ 210, 210, 210, 255 }, txt, x, y);
 }
 
-static int draw_text_right(SDL_Renderer* r, TTF_Font* f, const char* txt, int right, int y) {
-    SDL_Color col = { 234, 239, 244, 255 }; // #EAEFF4
-    SDL_Surface* s = TTF_RenderUTF8_Blended(f, txt, col);
-    if (!s) return 0;
-    SDL_Texture* t = SDL_CreateTextureFromSurface(r, s);
-    int x = right - s->w;
-    SDL_Rect dst = { x, y, s->w, s->h };
-    SDL_FreeSurface(s);
-    if (t) {
-        SDL_RenderCopy(r, t, NULL, &dst);
-        SDL_DestroyTexture(t);
-    }
-    return dst.w;
+static int draw_text_right(float size, const char* txt, int right, int y) {
+    if (!txt) return 0;
+    int w = 0; font_size_text(size, txt, &w, NULL);
+    prim_flush();
+    font_draw(size, (SDL_Color){ 234, 239, 244, 255 }, txt, right - w, y); // #EAEFF4
+    return w;
 }
 
-static void draw_text_col(SDL_Renderer* r, TTF_Font* f, SDL_Color col, const char* txt, int x, int y) {
-    if (!f || !txt) return;
-    SDL_Surface* s = TTF_RenderUTF8_Blended(f, txt, col);
-    if (!s) return;
-    SDL_Texture* t = SDL_CreateTextureFromSurface(r, s);
-    SDL_Rect dst = { x, y, s->w, s->h };
-    SDL_FreeSurface(s);
-    if (t) {
-        SDL_RenderCopy(r, t, NULL, &dst);
-        SDL_DestroyTexture(t);
-    }
-}
-
-static void draw_text_wrapped(SDL_Renderer* r, TTF_Font* f, SDL_Color col,
-                              const char* txt, int x, int y, int max_w) {
-    if (!f || !txt) return;
-    SDL_Surface* s = TTF_RenderUTF8_Blended_Wrapped(f, txt, col, (Uint32)max_w);
-    if (!s) return;
-    SDL_Texture* t = SDL_CreateTextureFromSurface(r, s);
-    SDL_Rect dst = { x, y, s->w, s->h };
-    SDL_FreeSurface(s);
-    if (t) {
-        SDL_RenderCopy(r, t, NULL, &dst);
-        SDL_DestroyTexture(t);
-    }
+static void draw_text_col(float size, SDL_Color col, const char* txt, int x, int y) {
+    if (!txt) return;
+    prim_flush(); // текст поверх уже накопичених примітивів
+    font_draw(size, col, txt, x, y);
 }
 
 static void set_fullscreen(Game* g, bool fs) {
     SDL_SetWindowFullscreen(g->window, fs ? SDL_WINDOW_FULLSCREEN_DESKTOP : 0);
     g->fullscreen = fs;
+    SDL_GetWindowSize(g->window, &g->width, &g->height);
+    g->ui.valid = false;
+    texcache_set_output_size(g->width, g->height);
     save_config(g);
 }
 
@@ -794,6 +870,17 @@ static void load_config(Game* g) {
     SDL_snprintf(g->lang_code, sizeof(g->lang_code), "ua");
     g->music_volume = 96; // 0..128
     g->sfx_volume = 128;
+    g->img_cache = true;
+    g->img_cache_lz4 = false;
+    g->text_cps = 45.f;
+    g->text_cps_cinematic = 24.f;
+    g->render_scale = 1.f;
+    g->pace_mode = PACE_VSYNC;
+    g->fps_limit = 60;
+    g->bg_fps = 10;
+    g->res_hops = 2;
+    g->res_by_visits = true;
+    g->cpu_compose = true;
 
     char* json = read_file_all("assets/config.json");
     if (!json) return;
@@ -806,6 +893,28 @@ static void load_config(Game* g) {
     const cJSON* jres = cJSON_GetObjectItemCaseSensitive(root, "resolution");
     const cJSON* jfs = cJSON_GetObjectItemCaseSensitive(root, "fullscreen");
     g->fullscreen = cJSON_IsTrue(jfs);
+    const cJSON* jic = cJSON_GetObjectItemCaseSensitive(root, "image_cache");
+    const cJSON* jlz = cJSON_GetObjectItemCaseSensitive(root, "image_cache_lz4");
+    if (cJSON_IsBool(jic)) g->img_cache = cJSON_IsTrue(jic);
+    if (cJSON_IsBool(jlz)) g->img_cache_lz4 = cJSON_IsTrue(jlz);
+    const cJSON* jts = cJSON_GetObjectItemCaseSensitive(root, "text_speed");
+    const cJSON* jtc = cJSON_GetObjectItemCaseSensitive(root, "text_speed_cinematic");
+    if (cJSON_IsNumber(jts)) g->text_cps = (float)SDL_max(0.0, jts->valuedouble);
+    if (cJSON_IsNumber(jtc)) g->text_cps_cinematic = (float)SDL_max(0.0, jtc->valuedouble);
+    const cJSON* jsc = cJSON_GetObjectItemCaseSensitive(root, "scale");
+    if (cJSON_IsNumber(jsc)) g->render_scale = (float)SDL_clamp(jsc->valuedouble, 0.25, 1.0);
+    const cJSON* jpm = cJSON_GetObjectItemCaseSensitive(root, "frame_pacing");
+    const cJSON* jfl = cJSON_GetObjectItemCaseSensitive(root, "fps_limit");
+    const cJSON* jbf = cJSON_GetObjectItemCaseSensitive(root, "background_fps");
+    if (cJSON_IsString(jpm)) g->pace_mode = pacing_mode_from_name(jpm->valuestring, PACE_VSYNC);
+    if (cJSON_IsNumber(jfl)) g->fps_limit = SDL_clamp(jfl->valueint, 10, 1000);
+    if (cJSON_IsNumber(jbf)) g->bg_fps = SDL_clamp(jbf->valueint, 0, 120); // 0 — не пригальмовувати
+    const cJSON* jrh = cJSON_GetObjectItemCaseSensitive(root, "residency_hops");
+    const cJSON* jrv = cJSON_GetObjectItemCaseSensitive(root, "prefetch_by_visits");
+    if (cJSON_IsNumber(jrh)) g->res_hops = SDL_clamp(jrh->valueint, 0, 8);
+    if (cJSON_IsBool(jrv)) g->res_by_visits = cJSON_IsTrue(jrv);
+    const cJSON* jcc = cJSON_GetObjectItemCaseSensitive(root, "cpu_compose");
+    if (cJSON_IsBool(jcc)) g->cpu_compose = cJSON_IsTrue(jcc);
     if (cJSON_IsArray(jres) && cJSON_GetArraySize(jres)==2) {
         g->width = cJSON_GetArrayItem(jres,0)->valueint;
         g->height = cJSON_GetArrayItem(jres,1)->valueint;
@@ -828,6 +937,17 @@ static void save_config(Game* g) {
     cJSON_AddStringToObject(root, "lang", g->lang_code);
     cJSON_AddNumberToObject(root, "music", (int)(g->music_volume));
     cJSON_AddBoolToObject(root, "fullscreen", g->fullscreen);
+    cJSON_AddNumberToObject(root, "scale", g->render_scale);
+    cJSON_AddStringToObject(root, "frame_pacing", pacing_mode_name(g->pace_mode));
+    cJSON_AddNumberToObject(root, "fps_limit", g->fps_limit);
+    cJSON_AddNumberToObject(root, "background_fps", g->bg_fps);
+    cJSON_AddNumberToObject(root, "residency_hops", g->res_hops);
+    cJSON_AddBoolToObject(root, "prefetch_by_visits", g->res_by_visits);
+    cJSON_AddBoolToObject(root, "cpu_compose", g->cpu_compose);
+    cJSON_AddBoolToObject(root, "image_cache", g->img_cache);
+    cJSON_AddBoolToObject(root, "image_cache_lz4", g->img_cache_lz4);
+    cJSON_AddNumberToObject(root, "text_speed", g->text_cps);
+    cJSON_AddNumberToObject(root, "text_speed_cinematic", g->text_cps_cinematic);
 
     cJSON* arr = cJSON_CreateIntArray((int[]){g->width,g->height},2);
     cJSON_AddItemToObject(root, "resolution", arr);
@@ -846,6 +966,8 @@ static void save_config(Game* g) {
 }
 
 bool game_init(Game* g, const char* title, int w, int h) {
+    g->startup.t0 = SDL_GetPerformanceCounter();
+    g->startup.pending = -1;
     if (SDL_Init(SDL_INIT_VIDEO) != 0) {
         SDL_Log("SDL_Init failed: %s", SDL_GetError());
         return false;
@@ -866,19 +988,26 @@ bool game_init(Game* g, const char* title, int w, int h) {
     }
     Mix_AllocateChannels(8);
 
+    // assets.hpak поруч з exe; без нього — звичайні файли з assets/
+    assets_open_pack(NULL);
+
     load_config(g);
     Mix_VolumeMusic(g->music_volume);
+    // потік стартує тут і одразу вантажить фон першої сцени — кеш має бути налаштований до нього
+    imgcache_configure(g->img_cache, g->img_cache_lz4);
+    startup_begin(g); // рядки й сюжет вантажаться, поки піднімаємо вікно й меню
 
-    // menu hover = none
-    g->menu_hover = -1;
+    g->mouse_x = g->mouse_y = -1; // курсор ще не рухався
+    g->ui.valid = false;
 
     // settings state from current config
     g->set_fullscreen = g->fullscreen;
     g->set_lang_idx = lang_to_idx(g->lang_code);
+    g->set_scale_idx = 0; // найближчий пункт до scale з конфігу
+    for (int i=1;i<SCALE_COUNT;i++)
+        if (SDL_fabsf(SCALES[i] - g->render_scale) < SDL_fabsf(SCALES[g->set_scale_idx] - g->render_scale)) g->set_scale_idx = i;
     g->set_sel_res = 0;
     for (int i=0;i<RES_COUNT;i++) if (RES_LIST[i][0]==g->width && RES_LIST[i][1]==g->height) { g->set_sel_res = i; break; }
-    g->set_drop_res_open = false;
-    g->set_drag_vol = false;
 
     // capture config mtime (for hot-reload)
     struct stat st; g->cfg_mtime = 0;
@@ -902,112 +1031,206 @@ bool game_init(Game* g, const char* title, int w, int h) {
     }
 
     g->renderer = SDL_CreateRenderer(g->window, -1,
-        SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
-    SDL_SetRenderDrawBlendMode(g->renderer, SDL_BLENDMODE_BLEND);
+        SDL_RENDERER_ACCELERATED | (g->pace_mode == PACE_VSYNC ? SDL_RENDERER_PRESENTVSYNC : 0));
+    if (!g->renderer) { // машина без GPU-драйвера — малюємо процесором
+        SDL_Log("accelerated renderer unavailable (%s), falling back to software", SDL_GetError());
+        g->renderer = SDL_CreateRenderer(g->window, -1, SDL_RENDERER_SOFTWARE);
+    }
     if (!g->renderer) {
         SDL_Log("CreateRenderer failed: %s", SDL_GetError());
         return false;
     }
+    SDL_SetRenderDrawBlendMode(g->renderer, SDL_BLENDMODE_BLEND);
+    swc_init(g->renderer, g->window, g->cpu_compose);
+    pacing_init(g->renderer, g->window, g->pace_mode, g->fps_limit, g->bg_fps);
+
+    texcache_init(g->renderer);
+    texcache_set_output_size(g->width, g->height);
+    residency_configure(g->res_hops, g->res_by_visits);
+    residency_init();
+
+    if (!g->rng_seed) g->rng_seed = SDL_GetPerformanceCounter(); // 0 = «будь-який»
+    vfx_init(g->renderer, g->rng_seed);
+    prim_init(g->renderer);
+    typewriter_init(g->renderer);
+    ui_init(g->renderer);
+    ui_build(g);
+    layers_init(g->renderer);
+    layer_init(&g->layer_screen, LAYER_OPAQUE);
+    layer_init(&g->layer_bg, LAYER_OPAQUE);
+    layer_init(&g->layer_ui, LAYER_OVERLAY);
+    layer_init(&g->layer_world, LAYER_OPAQUE);
 
     if (g->fullscreen) set_fullscreen(g, true);
 
-    char lang_path[128];
-    SDL_snprintf(lang_path, sizeof(lang_path), "assets/strings/%s.json", g->lang_code[0] ? g->lang_code : "ua");
-    if (!lang_load(&g->lang, lang_path)) {
-        SDL_Log("lang_load failed, fallback to ua");
-        lang_load(&g->lang, "assets/strings/ua.json");
-        // не фатальна помилка, можна продовжити
-    }
-    bool scenes_ok = scenes_load(g, "assets/content/scenes_demo.json");
-    if (!scenes_ok) SDL_Log("scenes_load failed");
-
     g->mode = MODE_MENU;
     g->menu_index = 0;
 
-    g->fade = 0.f; g->fade_dir = 0.f; g->fade_queued_scene = -1;
+    tween_reset();
+    g->fade = 0.f; g->fade_tw = 0; g->fade_to_black = false;
+    runtime_reset(&g->rt);
 
     g->flags_count = 0;
 
-    g->cur_scene = -1;
     g->running = true;
-    g->memory_clarity = g->memory_clarity_t = 20.0f;
-    g->anxiety        = g->anxiety_t        = 12.0f;
-    g->balance        = g->balance_t        = 5;
-    g->notif_count = 0;
+    g->memory_clarity = 20.0f; g->memory_clarity_t = 20.0;
+    g->anxiety        = 12.0f; g->anxiety_t        = 12.0;
+    g->balance        = 5.0f;  g->balance_t        = 5.0;
+    // бари підтягуються до *_t зі сталою швидкістю (од./с)
+    g->stat_tw[0] = tween_follow(&g->memory_clarity, (float)g->memory_clarity_t, 220.f);
+    g->stat_tw[1] = tween_follow(&g->anxiety,        (float)g->anxiety_t,        220.f);
+    g->stat_tw[2] = tween_follow(&g->balance,        (float)g->balance_t,        500.f);
+    memset(g->notifs, 0, sizeof(g->notifs));
+    g->notif_seq = 0;
 
     // Resources
-    g->bg = load_texture_cached(
-        g->renderer,
-        g->menu_bg_path[0] ? g->menu_bg_path : "backgrounds/menu_bg.png"
-    );    
+    g->bg = texcache_get(g->menu_bg_path[0] ? g->menu_bg_path : "backgrounds/menu_bg.png");
     g->music = NULL;
     g->current_music[0] = 0;
-    g->font = TTF_OpenFont("assets/fonts/Inter-Medium.ttf", 20);
-    if (!g->font) SDL_Log("TTF_OpenFont failed: %s", TTF_GetError());
+    if (!font_init(g->renderer, "fonts/Inter-Medium.ttf")) SDL_Log("font_init failed");
+    assets_log_stats("init");
+    SDL_Log("startup: menu ready in %.1f ms", ms_since(g->startup.t0));
 
     return true;
 }
 
 void game_shutdown(Game* g) {
     save_config(g);
+    texcache_shutdown(); // до знищення рендерера: кеш володіє g->bg
+    g->bg = NULL;
+    vfx_shutdown();
+    prim_shutdown();
+    typewriter_shutdown();
+    ui_tree_free(&g->ui_menu);
+    ui_tree_free(&g->ui_settings);
+    ui_tree_free(&g->ui_dialog);
+    ui_shutdown();
+    layer_free(&g->layer_screen);
+    layer_free(&g->layer_bg);
+    layer_free(&g->layer_ui);
+    layer_free(&g->layer_world);
+    layers_shutdown();
+    font_shutdown();
+    swc_shutdown();
+    for (int i = 0; i < NOTIF_MAX; ++i) notif_free(&g->notifs[i]); // текстури — до рендерера
+    tween_reset();
     if (g->renderer) SDL_DestroyRenderer(g->renderer);
     if (g->window)   SDL_DestroyWindow(g->window);
-    if (g->bg)      SDL_DestroyTexture(g->bg);
-    if (g->font)    TTF_CloseFont(g->font);
+    if (g->music)   { Mix_HaltMusic(); Mix_FreeMusic(g->music); g->music = NULL; }
+    residency_shutdown(); // музика читала з його буферів
     for (int i = 0; i < g->flags_count; ++i) free(g->flags[i]);
     g->flags_count = 0;
-    for (int i=0;i<g_tex_cache_n;i++) if (g_tex_cache[i].tex) SDL_DestroyTexture(g_tex_cache[i].tex);
-    g_tex_cache_n = 0;
 
+    g->startup.pending = -1;
+    startup_adopt(g); // дочекатися потоку, щоб звільнити все разом
     scenes_free(g);
+    runtime_free(&g->rt);
     lang_free(&g->lang);
+    assets_log_stats("shutdown");
+    assets_close_pack(); // шрифт і музика читали прямо з мапінгу
     TTF_Quit();
     IMG_Quit();
     SDL_Quit();
 }
 
+// вибір у діалозі: стати, прапорці, нотифікації, перехід
+static void pick_choice(Game* g, int idx) {
+    if (idx < 0 || idx >= g->dialog.num_choices) return;
+    const Scene* S = &g->scenes[g->rt.cur];
+    const SceneChoice* C = &S->choices[idx];
+
+    // стат-ефекти
+    g->memory_clarity_t += C->d_clarity;
+    g->anxiety_t        += C->d_anxiety;
+    g->balance_t        += C->d_balance;
+
+    // прапорці
+    for (int k = 0; k < C->add_flags_n; ++k) game_add_flag(g, C->add_flags[k]);
+    for (int k = 0; k < C->rem_flags_n; ++k) game_remove_flag(g, C->rem_flags[k]);
+    vfx_trigger(&C->vfx_on_pick);
+
+    g->dialog.visible = false;
+
+    // нотифікації
+    char tmp[24];
+    if (C->d_clarity){ SDL_snprintf(tmp, sizeof(tmp), "%+d CL", C->d_clarity); push_notif(g,0,tmp,(SDL_Color){110,178,191,255},1.4f); }
+    if (C->d_anxiety){ SDL_snprintf(tmp, sizeof(tmp), "%+d ANX", C->d_anxiety); push_notif(g,1,tmp,(SDL_Color){205,63,69,255},1.4f); }
+    if (C->d_balance){ SDL_snprintf(tmp, sizeof(tmp), "%+d BAL", C->d_balance); push_notif(g,2,tmp,(SDL_Color){199,141,165,255},1.4f); }
+
+    // перехід
+    if (C->next >= 0) start_fade_to(g, C->next);
+    else { g->dialog.visible=false; g->rt.cur=-1; }
+}
+
+static void menu_activate(Game* g, int i) {
+    g->menu_index = i;
+    if (i == MW_NEW || i == MW_CONTINUE) { // New/Continue -> старт сцени
+        if (!g->startup.ready) { g->startup.pending = i; return; } // сюжет ще вантажиться — стартуємо, щойно буде
+        if (i == MW_NEW) runtime_reset(&g->rt); // нове проходження — лічильники з нуля
+        if (g->start_scene >= 0) { start_fade_to(g, g->start_scene); g->mode = MODE_GAME; }
+    } else if (i == MW_SETTINGS) {
+        g->mode = MODE_SETTINGS;
+    } else if (i == MW_EXIT) {
+        g->running = false;
+    }
+}
+
+// нове проходження з довільної сцени (dev): id -> індекс через scene_ix
+bool game_jump_to_scene(Game* g, const char* id) {
+    startup_adopt(g);
+    int idx = strindex_get(&g->scene_ix, id);
+    if (idx < 0) { SDL_Log("jump: no scene '%s'", id); return false; }
+    runtime_reset(&g->rt);
+    start_fade_to(g, idx);
+    g->mode = MODE_GAME;
+    return true;
+}
+
 void game_handle_event(Game* g, const SDL_Event* e) {
+    if (e->type == SDL_WINDOWEVENT) {
+        if (e->window.event == SDL_WINDOWEVENT_RESIZED || e->window.event == SDL_WINDOWEVENT_SIZE_CHANGED || e->window.event == SDL_WINDOWEVENT_MAXIMIZED) {
+            SDL_GetWindowSize(g->window, &g->width, &g->height);
+            SDL_RenderSetViewport(g->renderer, NULL);
+            SDL_RenderSetScale(g->renderer, 1.0f, 1.0f);
+            texcache_set_output_size(g->width, g->height);
+            g->ui.valid = false;
+        }
+        return;
+    }
+    if (e->type == SDL_QUIT) { g->running = false; return; }
+    if (e->type == SDL_RENDER_TARGETS_RESET || e->type == SDL_RENDER_DEVICE_RESET) {
+        // вміст текстур-цілей втрачено: шари й кеші віджетів перемалюються з нуля
+        layer_invalidate(&g->layer_screen);
+        layer_invalidate(&g->layer_bg);
+        layer_invalidate(&g->layer_ui);
+        layer_invalidate(&g->layer_world);
+        ui_tree_invalidate(&g->ui_menu);
+        ui_tree_invalidate(&g->ui_settings);
+        ui_tree_invalidate(&g->ui_dialog);
+        return;
+    }
+
+    // hit-test по свіжій розкладці, навіть якщо кадр ще не малювався (--fast replay)
+    ui_layout(g);
+    if (e->type == SDL_MOUSEMOTION) {
+        g->mouse_x = e->motion.x; g->mouse_y = e->motion.y;
+    } else if (e->type == SDL_MOUSEBUTTONDOWN) {
+        g->mouse_x = e->button.x; g->mouse_y = e->button.y;
+    }
+
+    UiAction a;
     switch(g->mode) {
         case MODE_MENU:
-            if (e->type == SDL_QUIT) { g->running = false; return; }
-
-            if (e->type == SDL_MOUSEMOTION) {
-                SDL_Point p = { e->motion.x, e->motion.y };
-                g->menu_hover = -1;
-                for (int i=0;i<4;i++) if (SDL_PointInRect(&p, &g->menu_btn_rects[i])) { g->menu_hover=i; break; }
+            if (ui_dispatch(&g->ui_menu, e, &a)) {
+                if (a.kind == UI_ACT_CLICK) menu_activate(g, a.id);
                 return;
             }
-            if (e->type == SDL_MOUSEBUTTONDOWN && e->button.button==SDL_BUTTON_LEFT) {
-                SDL_Point p = { e->button.x, e->button.y };
-                for (int i=0;i<4;i++) if (SDL_PointInRect(&p, &g->menu_btn_rects[i])) {
-                    g->menu_index = i;
-                    if (i==0 || i==1) { // New/Continue -> старт сцени
-                        if (g->start_scene >= 0) { start_fade_to(g, g->start_scene); g->mode = MODE_GAME; }
-                    } else if (i==2) {
-                        g->mode = MODE_SETTINGS;
-                    } else if (i==3) {
-                        g->running = false;
-                    }
-                    return;
-                }
-            }
-            if (e->type == SDL_QUIT) g->running = false;
             if (e->type == SDL_KEYDOWN) {
                 if (e->key.keysym.sym == SDLK_ESCAPE) g->running = false;
                 if (e->key.keysym.sym == SDLK_UP) g->menu_index = (g->menu_index+3) % 4;
                 if (e->key.keysym.sym == SDLK_DOWN) g->menu_index = (g->menu_index+1) % 4;
-                if (e->key.keysym.sym == SDLK_F11 || (e->key.keysym.sym == SDLK_RETURN && (e->key.keysym.mod & KMOD_ALT))) { set_fullscreen(g, !g->fullscreen); break; }
-                if (e->key.keysym.sym == SDLK_RETURN || e->key.keysym.sym == SDLK_SPACE) {
-                    if (g->menu_index == 0) {
-                        if (g->start_scene >= 0) { start_fade_to(g, g->start_scene); g->mode = MODE_GAME; }
-                    } else if (g->menu_index == 1) {
-                        if (g->start_scene >= 0) { start_fade_to(g, g->start_scene); g->mode = MODE_GAME; }
-                    } else if (g->menu_index == 2) {
-                        g->mode = MODE_SETTINGS;
-                    } else if (g->menu_index == 3) {
-                        g->running = false;
-                    }
-                }
+                if (e->key.keysym.sym == SDLK_F11 || (e->key.keysym.sym == SDLK_RETURN && (e->key.keysym.mod & KMOD_ALT))) { set_fullscreen(g, !g->fullscreen); return; }
+                if (e->key.keysym.sym == SDLK_RETURN || e->key.keysym.sym == SDLK_SPACE) menu_activate(g, g->menu_index);
             }
             return;
         case MODE_SETTINGS:
@@ -1016,114 +1239,65 @@ void game_handle_event(Game* g, const SDL_Event* e) {
         default: break;
     }
     switch (e->type) {
-        case SDL_QUIT:
-            g->running = false;
-            break;
         case SDL_KEYDOWN:
             if (e->key.keysym.sym == SDLK_ESCAPE) g->running = false;
             if (e->key.keysym.sym == SDLK_e) g->memory_clarity_t += 2.f;
             if (e->key.keysym.sym == SDLK_q) g->anxiety_t += 2.f;
             if (e->key.keysym.sym == SDLK_a) g->balance_t -= 5;
             if (e->key.keysym.sym == SDLK_d) g->balance_t += 5;
+            if (g->dialog.visible && !typewriter_done() &&
+                (e->key.keysym.sym == SDLK_SPACE || e->key.keysym.sym == SDLK_RETURN)) {
+                typewriter_complete(); // дописати репліку одразу
+                break;
+            }
+            // по клавішах
             if (g->dialog.visible && e->key.keysym.sym >= SDLK_1 && e->key.keysym.sym <= SDLK_4) {
-                // по клавішах
-                if (g->dialog.visible && e->key.keysym.sym >= SDLK_1 && e->key.keysym.sym <= SDLK_4) {
-                    int idx = (int)(e->key.keysym.sym - SDLK_1);
-                    if (idx >= 0 && idx < g->dialog.num_choices) {
-                        Scene* S = &g->scenes[g->cur_scene];
-                        SceneChoice* C = &S->choices[idx];
-
-                        // стат-ефекти
-                        g->memory_clarity_t += C->d_clarity;
-                        g->anxiety_t        += C->d_anxiety;
-                        g->balance_t        += C->d_balance;
-
-                        // прапорці
-                        for (int k = 0; k < C->add_flags_n; ++k) game_add_flag(g, C->add_flags[k]);
-                        for (int k = 0; k < C->rem_flags_n; ++k) game_remove_flag(g, C->rem_flags[k]);
-
-                        g->dialog.visible = false;
-
-                        // нотифікації
-                        char tmp[24];
-                        if (C->d_clarity){ SDL_snprintf(tmp, sizeof(tmp), "%+d CL", C->d_clarity); push_notif(g,0,tmp,(SDL_Color){110,178,191,255},1.4f); }
-                        if (C->d_anxiety){ SDL_snprintf(tmp, sizeof(tmp), "%+d ANX", C->d_anxiety); push_notif(g,1,tmp,(SDL_Color){205,63,69,255},1.4f); }
-                        if (C->d_balance){ SDL_snprintf(tmp, sizeof(tmp), "%+d BAL", C->d_balance); push_notif(g,2,tmp,(SDL_Color){199,141,165,255},1.4f); }
-
-                        // перехід
-                        if (C->next >= 0) start_fade_to(g, C->next);
-                        else { g->dialog.visible=false; g->cur_scene=-1; }
-                    }
-                }
+                pick_choice(g, (int)(e->key.keysym.sym - SDLK_1));
             }
             if (e->key.keysym.sym == SDLK_r) {
                 start_fade_to(g, g->start_scene);
             }
             break;
         case SDL_MOUSEMOTION:
-            if (g->dialog.visible) {
-                int mx = e->motion.x, my = e->motion.y;
-                g->dialog.hovered = -1;
-                for (int i=0;i<g->dialog.num_choices;++i) {
-                    if (SDL_PointInRect(&(SDL_Point){mx,my}, &g->dialog.choices[i].rect)) {
-                        g->dialog.hovered = i;
-                        break;
-                    }
-                }
-            }
+            if (g->dialog.visible) ui_dispatch(&g->ui_dialog, e, &a); // hover
             break;
         case SDL_MOUSEBUTTONDOWN:
-            if (g->dialog.visible && e->button.button == SDL_BUTTON_LEFT) {
-                int mx = e->button.x, my = e->button.y;
-                for (int i=0;i<g->dialog.num_choices;i++){
-                    if (SDL_PointInRect(&(SDL_Point){mx,my}, &g->dialog.choices[i].rect)) {
-                        Scene* S = &g->scenes[g->cur_scene];
-                        SceneChoice* C = &S->choices[i];
-
-                        // стат-ефекти
-                        g->memory_clarity_t += C->d_clarity;
-                        g->anxiety_t        += C->d_anxiety;
-                        g->balance_t        += C->d_balance;
-
-                        // прапорці
-                        for (int k = 0; k < C->add_flags_n; ++k) game_add_flag(g, C->add_flags[k]);
-                        for (int k = 0; k < C->rem_flags_n; ++k) game_remove_flag(g, C->rem_flags[k]);
-
-                        g->dialog.visible = false;
-
-                        // нотифікації
-                        char tmp[24];
-                        if (C->d_clarity){ SDL_snprintf(tmp, sizeof(tmp), "%+d CL", C->d_clarity); push_notif(g,0,tmp,(SDL_Color){110,178,191,255},1.4f); }
-                        if (C->d_anxiety){ SDL_snprintf(tmp, sizeof(tmp), "%+d ANX", C->d_anxiety); push_notif(g,1,tmp,(SDL_Color){205,63,69,255},1.4f); }
-                        if (C->d_balance){ SDL_snprintf(tmp, sizeof(tmp), "%+d BAL", C->d_balance); push_notif(g,2,tmp,(SDL_Color){199,141,165,255},1.4f); }
-
-                        // перехід
-                        if (C->next >= 0) start_fade_to(g, C->next);
-                        else { g->dialog.visible=false; g->cur_scene=-1; }
-
-                        break;
-                    }
-                }
+            if (g->dialog.visible && e->button.button == SDL_BUTTON_LEFT && !typewriter_done()) {
+                typewriter_complete(); // перший клік лише дописує репліку
+                break;
             }
-            break;
-        case SDL_WINDOWEVENT:
-            if (e->window.event == SDL_WINDOWEVENT_RESIZED || e->window.event == SDL_WINDOWEVENT_SIZE_CHANGED || e->window.event == SDL_WINDOWEVENT_MAXIMIZED) {
-                SDL_GetWindowSize(g->window, &g->width, &g->height);
-                SDL_RenderSetViewport(g->renderer, NULL);
-                SDL_RenderSetScale(g->renderer, 1.0f, 1.0f);
+            if (g->dialog.visible && ui_dispatch(&g->ui_dialog, e, &a) && a.kind == UI_ACT_CLICK) {
+                pick_choice(g, a.id - DW_CHOICE0);
             }
             break;
         default: break;
     }
 }
 
+// символів/с: синематик повільніший, тривога квапить (до x1.6 при 100)
+static float text_reveal_cps(const Game* g, const Scene* S) {
+    float cps = S->cinematic ? g->text_cps_cinematic : g->text_cps;
+    if (cps <= 0.f) return 0.f;
+    return cps * (1.f + 0.6f * (float)g->anxiety_t / 100.f);
+}
+
 void game_update(Game* g, float dt) {
-    // ---- hot-reload config.json ----
+    startup_poll(g);
+
+    // ---- hot-reload config.json ---- (після старту: до того рядки й сюжет належать потоку)
     static float cfg_timer = 0.f;
     cfg_timer += dt;
-    if (cfg_timer > 0.5f) { // раз на ~0.5 c
+    if (cfg_timer > 0.5f && g->startup.ready) { // раз на ~0.5 c
         cfg_timer = 0.f;
         struct stat st;
+        Uint64 smt, ssz;
+
+        // ---- hot-reload сцен: лише змінені, прогрес гри зберігається ----
+        if (asset_stamp(SCENES_PATH, &smt, &ssz) &&
+            ((time_t)smt != g->scenes_mtime || (long)ssz != g->scenes_size)) {
+            scenes_reload(g, SCENES_PATH, false);
+        }
+
         if (stat("assets/config.json", &st) == 0 && st.st_mtime != g->cfg_mtime) {
             g->cfg_mtime = st.st_mtime;
 
@@ -1137,16 +1311,16 @@ void game_update(Game* g, float dt) {
                 lang_free(&g->lang);
                 char lp[128]; SDL_snprintf(lp,sizeof(lp),"assets/strings/%s.json", g->lang_code[0]?g->lang_code:"ua");
                 if (!lang_load(&g->lang, lp)) lang_load(&g->lang, "assets/strings/ua.json");
+                g->ui.valid = false; // підписи меню
 
-                // scenes must be reloaded for new language
-                scenes_free(g);
-                scenes_load(g, "assets/content/scenes_demo.json");
+                // scenes must be relocalized for new language
+                scenes_reload(g, SCENES_PATH, true);
             }
 
             // reload background texture if path changed
             if (SDL_strcasecmp(old_bg, g->menu_bg_path)!=0) {
-                SDL_Texture* newbg = load_texture(g->renderer, g->menu_bg_path[0]?g->menu_bg_path:"backgrounds/menu_bg.png");
-                if (newbg) { if (g->bg) SDL_DestroyTexture(g->bg); g->bg = newbg; }
+                SDL_Texture* newbg = texcache_get(g->menu_bg_path[0]?g->menu_bg_path:"backgrounds/menu_bg.png");
+                if (newbg) g->bg = newbg; // кеш володіє ресурсом
             }
 
             Mix_VolumeMusic(g->music_volume);
@@ -1157,61 +1331,46 @@ void game_update(Game* g, float dt) {
         }
     }
 
-    float s = 4.5f;
-    if (g->fade_dir != 0.f) {
-        g->fade += g->fade_dir * s * dt;
-        if (g->fade >= 1.f) { g->fade = 1.f; g->fade_dir = -1.f;
-            if (g->fade_queued_scene >= 0) {
-                scene_show_immediate(g, g->fade_queued_scene);
-                g->fade_queued_scene = -1;
-            }
-        } else if (g->fade <= 0.f) { g->fade = 0.f; g->fade_dir = 0.f; }
-    }
-    //* 1) Дрейф балансу від тривоги (в пер-секундних одиницях)
-    float anx = g->anxiety; // беремо згладжене current
-    float drift = 0.f;
-    if (anx > 60.f)       drift = -(anx - 60.f) * 0.20f;  // до -8.0/с при 100
-    else if (anx < 30.f)  drift =  (30.f - anx) * 0.12f;  // до +3.6/с при 0
-
-    //* Демпфування: баланс сам тягнеться до 0 (щоб не зашкалював до ±100)
-    float damping = 0.20f;                 // 20%/с до нуля
-    float bal_vel = drift - damping * g->balance_t;
-
-    g->balance_t += bal_vel * dt;
-
-    //* 2) Вплив балансу на ясність (повільно набираємо, швидше втрачаємо)
-    float k_up = 0.30f, k_down = 0.60f;    // при |balance|==100
-    if (g->balance_t >= 0.f) g->memory_clarity_t += (g->balance_t / 100.f) * k_up   * dt;
-    else                     g->memory_clarity_t += (g->balance_t / 100.f) * k_down * dt;
-
-    //* 3) Природний спад тривоги (дуже повільно)
-    g->anxiety_t -= 0.05f * dt;
-
-    //* 4) Клампи target’ів
-    g->memory_clarity_t = clampf(g->memory_clarity_t, 0.f, 100.f);
-    g->anxiety_t        = clampf(g->anxiety_t,        0.f, 100.f);
-    g->balance_t        = clampf(g->balance_t,      -100.f, 100.f);
-
-    //* 5) Плавний підхід current → target
-    g->memory_clarity = approachf(g->memory_clarity, g->memory_clarity_t, 220.f, dt);
-    g->anxiety        = approachf(g->anxiety,        g->anxiety_t,        220.f, dt);
-    g->balance        = approachf(g->balance,        g->balance_t,        500.f, dt);
-
-    //* 6) Нотифікації
-    for (int i=0; i<g->notif_count; ){
-        g->notifs[i].t -= dt;
-        if (g->notifs[i].t <= 0.f){
-            g->notifs[i] = g->notifs[g->notif_count-1];
-            g->notif_count--;
-        } else ++i;
-    }
-
-    //* 7) Autoscenes
-    if (g->dialog.visible && g->cur_scene >= 0) {
-        Scene* S = &g->scenes[g->cur_scene];
-        if (S->auto_time > 0.f && S->auto_next >= 0 && S->num_choices == 0) {
-            S->auto_time -= dt;
-            if (S->auto_time <= 0.f) {
+    // зменшені варіанти фонів, готові у фоновому потоці
+    texcache_pump(&g->bg);
+
+    if (g->mode == MODE_GAME) vfx_update(dt);
+
+    //* 0) Усі анімації одним проходом: fade, бари, нотифікації, таймер автосцени
+    tween_update(dt);
+
+    // пік затемнення: показуємо сцену і світлішаємо назад
+    if (g->fade_to_black && !tween_active(g->fade_tw)) {
+        g->fade_to_black = false;
+        if (g->rt.queued >= 0) {
+            scene_show_immediate(g, g->rt.queued);
+            g->rt.queued = -1;
+        }
+        g->fade_tw = tween_start(&g->fade, 1.f, 0.f, FADE_TIME, EASE_LINEAR);
+    }
+    //* 1-4) Модель статів: тривога -> дрейф балансу -> ясність, точний розв'язок за dt
+    StatState st = { g->memory_clarity_t, g->anxiety_t, g->balance_t };
+    stats_advance(&st, dt);
+    g->memory_clarity_t = st.clarity;
+    g->anxiety_t        = st.anxiety;
+    g->balance_t        = st.balance;
+
+    //* 5) Плавний підхід current → target (крокує tween_update наступного кадру)
+    tween_retarget(g->stat_tw[0], (float)g->memory_clarity_t);
+    tween_retarget(g->stat_tw[1], (float)g->anxiety_t);
+    tween_retarget(g->stat_tw[2], (float)g->balance_t);
+
+    //* 6) Нотифікації: догасла — звільняємо спрайт
+    for (int i = 0; i < NOTIF_MAX; ++i)
+        if (g->notifs[i].live && !tween_active(g->notifs[i].tw_alpha)) notif_free(&g->notifs[i]);
+
+    //* 7) Поява репліки; автосцени відлічують час лише після неї
+    if (g->dialog.visible && g->rt.cur >= 0) {
+        const Scene* S = &g->scenes[g->rt.cur];
+        typewriter_update(dt, text_reveal_cps(g, S));
+        if (typewriter_done() && S->auto_time > 0.f && S->auto_next >= 0 && S->num_choices == 0) {
+            tween_pause(g->rt.auto_tw, false);
+            if (!tween_active(g->rt.auto_tw)) {
                 g->dialog.visible = false;
                 start_fade_to(g, S->auto_next);
             }
@@ -1219,20 +1378,22 @@ void game_update(Game* g, float dt) {
     }
 }
 
-static void draw_bar(SDL_Renderer* r, float x, float y, float w, float h, float value01) {
-    // рамка
-    SDL_SetRenderDrawColor(r, 36, 42, 51, 180); // #232A33 ~60% opacity
+static const SDL_Color COL_BORDER = {36, 42, 51, 180};   // #232A33 ~60% opacity
+
+// рамка бару — статична частина HUD (шар layer_ui)
+static void draw_bar_frame(float x, float y, float w, float h) {
     SDL_Rect border = { (int)x, (int)y, (int)w, (int)h };
-    SDL_RenderDrawRect(r, &border);
+    prim_outline_i(&border, COL_BORDER);
+}
 
-    // заповнення
+// заповнення всередині рамки; лише накопичує примітиви (див. prim_flush)
+static void draw_bar(float x, float y, float w, float h, float value01, SDL_Color fill_col) {
     int pad = 2;
     SDL_Rect fill = {
         (int)(x + pad), (int)(y + pad),
         (int)((w - 2*pad) * value01), (int)(h - 2*pad)
     };
-    SDL_SetRenderDrawColor(r, 110, 178, 191, 255); // #6ED2BF
-    SDL_RenderFillRect(r, &fill);
+    prim_rect_i(&fill, fill_col);
 }
 
 static float balance_to01(int bal) {
@@ -1241,11 +1402,7 @@ static float balance_to01(int bal) {
     return (bal + 100) / 200.0f; // -100..+100 -> 0..1
 }
 
-static void draw_balance_bar(SDL_Renderer* r, float x, float y, float w, float h, int bal) {
-    SDL_SetRenderDrawColor(r, 36, 42, 51, 180);
-    SDL_Rect border = { (int)x, (int)y, (int)w, (int)h };
-    SDL_RenderDrawRect(r, &border);
-
+static void draw_balance_bar(float x, float y, float w, float h, int bal) {
     int pad = 2;
     float ix = x + pad, iy = y + pad;
     float iw = w - 2*pad, ih = h - 2*pad;
@@ -1258,9 +1415,8 @@ static void draw_balance_bar(SDL_Renderer* r, float x, float y, float w, float h
         float t = (bal + 100) / 200.0f;        // -100..0 -> 0..0.5
         float left  = ix + iw * t;
         float right = zero_x;
-        SDL_SetRenderDrawColor(r, 205, 63, 69, 255);
         SDL_Rect neg = { (int)left, (int)iy, (int)(right - left), (int)ih };
-        SDL_RenderFillRect(r, &neg);
+        prim_rect_i(&neg, (SDL_Color){205, 63, 69, 255});
     }
 
     // позитив праворуч (рожевий)
@@ -1268,9 +1424,8 @@ static void draw_balance_bar(SDL_Renderer* r, float x, float y, float w, float h
         float t = (bal + 100) / 200.0f;        // 0..+100 -> 0.5..1.0
         float left  = zero_x;
         float right = ix + iw * t;
-        SDL_SetRenderDrawColor(r, 199, 141, 165, 255);
         SDL_Rect pos = { (int)left, (int)iy, (int)(right - left), (int)ih };
-        SDL_RenderFillRect(r, &pos);
+        prim_rect_i(&pos, (SDL_Color){199, 141, 165, 255});
     }
 
     // маркер
@@ -1278,303 +1433,288 @@ static void draw_balance_bar(SDL_Renderer* r, float x, float y, float w, float h
 #else
     // Ліво->право 0..100: просто рожевий філд
     int bal01 = SDL_clamp(bal, 0, 100);
-    SDL_SetRenderDrawColor(r, 199, 141, 165, 255);
     SDL_Rect pos = { (int)ix, (int)iy, (int)(iw * (bal01/100.0f)), (int)ih };
-    SDL_RenderFillRect(r, &pos);
+    prim_rect_i(&pos, (SDL_Color){199, 141, 165, 255});
     float cx = ix + iw * (bal01/100.0f);
 #endif
 
-    int cy = (int)(iy + ih/2), rpx = 5;
-    SDL_SetRenderDrawColor(r, 234, 239, 244, 255);
-    for (int dy = -rpx; dy <= rpx; ++dy)
-      for (int dx = -rpx; dx <= rpx; ++dx)
-        if (dx*dx + dy*dy <= rpx*rpx) SDL_RenderDrawPoint(r, (int)cx + dx, cy + dy);
+    // центр пікселя, як у колишнього кола з DrawPoint
+    prim_circle((float)(int)cx + 0.5f, (float)(int)(iy + ih/2) + 0.5f, 5.5f, (SDL_Color){234, 239, 244, 255});
 }
 
-static void text_size(TTF_Font* f, const char* txt, int* w, int* h) {
-    int tw = 0, th = 0;
-    if (f && txt) TTF_SizeUTF8(f, txt, &tw, &th);
-    if (w) *w = tw;
-    if (h) *h = th;
+static void text_size(float size, const char* txt, int* w, int* h) {
+    font_size_text(size, txt, w, h);
 }
 
-void game_render(Game* g) {
-    // ===== MENЮ =====
-    if (g->mode == MODE_MENU) {
-        render_bg_fit(g->renderer, g->bg, g->width, g->height);
+// напівпрозора заливка всього viewport: на програмному рендерері — SIMD-ядром (swcomp.h)
+static void fill_view(Game* g, SDL_Color c) {
+    if (swc_fill_view(c)) return;
+    prim_rect(0.f, 0.f, (float)g->width, (float)g->height, c);
+}
 
-        // напівпрозорий оверлей
-        SDL_SetRenderDrawColor(g->renderer, 0,0,0,160);
-        SDL_Rect ov = {0,0,g->width,g->height};
-        SDL_RenderFillRect(g->renderer, &ov);
-
-        const char* items[4] = {
-            lang_get(&g->lang, "menu.new_game") ?: "New Game",
-            lang_get(&g->lang, "menu.continue") ?: "Continue",
-            lang_get(&g->lang, "menu.settings") ?: "Settings",
-            lang_get(&g->lang, "menu.exit")     ?: "Exit"
-        };
-
-        int cx = g->width/2, cy = g->height/2;
-        int bw = (int)(g->width * 0.28f), bh = 48, gap = 14;
-        int start_y = cy - (2*bh + 1*gap + bh);
-
-        for (int i=0;i<4;i++){
-            int x = cx - bw/2;
-            int y = start_y + i*(bh+gap);
-            SDL_Rect r = {x,y,bw,bh};
-            g->menu_btn_rects[i] = r;
-
-            bool sel = (g->menu_hover==i) || (g->menu_hover==-1 && g->menu_index==i);
-            SDL_SetRenderDrawColor(g->renderer, sel?40:28, sel?48:32, sel?60:40, 255);
-            SDL_RenderFillRect(g->renderer, &r);
-            SDL_SetRenderDrawColor(g->renderer, 36,42,51,180);
-            SDL_RenderDrawRect(g->renderer, &r);
-
-            int tw=0,th=0; text_size(g->font, items[i], &tw, &th);
-            draw_text_col(g->renderer, g->font, (SDL_Color){234,239,244,255},
-                        items[i], x + (bw - tw)/2, y + (bh - th)/2);
-        }
+// Статичний UI сцени: підкладка HUD, рамки барів, підписи, затемнення синематику, панель діалогу.
+// Змінюється лише з розкладкою чи віджетами діалогу — тому живе в кешованому шарі.
+static void draw_scene_ui_static(Game* g, bool cinematic) {
+    const UiLayout* L = &g->ui;
+    if (!cinematic) {
+        prim_rect_i(&L->hud_bg, (SDL_Color){20,24,32,180});
+        for (int i = 0; i < 3; ++i) draw_bar_frame((float)L->bar_x, (float)L->hud_row_y[i], L->bar_w, L->bar_h);
+        prim_flush();
+        draw_text(L->fs, "Memory Clarity", L->hud_x, L->hud_row_y[0]);
+        draw_text(L->fs, "Anxiety",        L->hud_x, L->hud_row_y[1]);
+        draw_text(L->fs, "Balance",        L->hud_x, L->hud_row_y[2]);
+    }
+    if (g->dialog.visible) {
+        if (cinematic) fill_view(g, (SDL_Color){0,0,0,140});
+        else ui_draw(&g->ui_dialog); // панель, мовець і кнопки виборів
+    }
+    prim_flush();
+}
 
-        if (g->fade > 0.f) {
-            Uint8 a = (Uint8)SDL_clamp((int)(g->fade*255),0,255);
-            SDL_SetRenderDrawColor(g->renderer,0,0,0,a);
-            SDL_Rect full={0,0,g->width,g->height}; SDL_RenderFillRect(g->renderer,&full);
-        }
-        SDL_RenderPresent(g->renderer);
+// Кадр сцени — впорядковані шари, кожен малює поверх попереднього.
+// Презент — рівно один, у кінці game_render.
+typedef struct {
+    bool     cinematic;
+    int      ow, oh;      // ціль світових шарів: вікно або знижена роздільність (render_scale)
+    SDL_Rect bg_dst;      // де лежить фон (з трясінням) — для світових VFX
+} FrameCtx;
+
+// фон: вписаний у вікно один раз, далі — копія шару (зі зсувом трясіння)
+static void frame_background(Game* g, FrameCtx* f) {
+    if (!g->bg) {
+        SDL_SetRenderDrawColor(g->renderer, 18,20,24,255);
+        SDL_RenderClear(g->renderer);
         return;
     }
+    int sx, sy; vfx_shake_offset(f->oh, &sx, &sy);
+    // адреса сама по собі не ключ: звільнену текстуру SDL може віддати новому фону
+    struct { const void* bg; Uint32 serial; } key = { g->bg, texcache_serial(g->bg) };
+    Layer* B = &g->layer_bg;
+    if (layer_begin(B, f->ow, f->oh, &key, sizeof(key))) {
+        render_bg_fit(g->renderer, g->bg, f->ow, f->oh, 0, 0);
+        layer_end(B);
+    }
+    if (layer_ready(B)) {
+        if (sx || sy) { SDL_SetRenderDrawColor(g->renderer, 0,0,0,255); SDL_RenderClear(g->renderer); }
+        layer_draw(B, sx, sy);
+        f->bg_dst = bg_fit_rect(g->bg, f->ow, f->oh);
+        f->bg_dst.x += sx; f->bg_dst.y += sy;
+    } else {
+        f->bg_dst = render_bg_fit(g->renderer, g->bg, f->ow, f->oh, sx, sy);
+    }
+}
 
-    // ===== НАЛАШТУВАННЯ =====
-    if (g->mode == MODE_SETTINGS) {
-        render_settings(g);
-        if (g->fade > 0.f) {
-            Uint8 a = (Uint8)SDL_clamp((int)(g->fade*255),0,255);
-            SDL_SetRenderDrawColor(g->renderer,0,0,0,a);
-            SDL_Rect full={0,0,g->width,g->height}; SDL_RenderFillRect(g->renderer,&full);
-        }
-        SDL_RenderPresent(g->renderer);
-        return;
+static void frame_vfx(Game* g, FrameCtx* f) {
+    vfx_render_world(g->renderer, g->bg, &f->bg_dst, f->ow, f->oh);
+}
+
+// статичний UI з кешу (якщо рендерер вміє premultiplied-накладання) + живі бари й значення
+static void frame_hud(Game* g, FrameCtx* f) {
+    const UiLayout* L = &g->ui;
+    struct { Uint32 layout, dialog; bool visible, cinematic; } key;
+    memset(&key, 0, sizeof(key));
+    key.layout    = L->rev;
+    key.dialog    = ui_tree_rev(&g->ui_dialog);
+    key.visible   = g->dialog.visible;
+    key.cinematic = f->cinematic;
+    Layer* U = &g->layer_ui;
+    if (layer_begin(U, g->width, g->height, &key, sizeof(key))) {
+        draw_scene_ui_static(g, f->cinematic);
+        layer_end(U);
     }
+    if (layer_ready(U)) layer_draw(U, 0, 0);
+    else draw_scene_ui_static(g, f->cinematic);
+
+    // бари/значення показуємо тільки якщо НЕ cinematic
+    if (f->cinematic) return;
+    char val_cl[32], val_anx[32], val_bal[32];
+    SDL_snprintf(val_cl,  sizeof(val_cl),  "%.0f%%", g->memory_clarity);
+    SDL_snprintf(val_anx, sizeof(val_anx), "%.0f",   g->anxiety);
+    SDL_snprintf(val_bal, sizeof(val_bal), "%+d",    (int)g->balance);
+
+    // заповнення барів одним пакетом, потім значення
+    const int y1 = L->hud_row_y[0], y2 = L->hud_row_y[1], y3 = L->hud_row_y[2];
+    draw_bar((float)L->bar_x, (float)y1, L->bar_w, L->bar_h, g->memory_clarity/100.f, (SDL_Color){110,178,191,255});
+    draw_bar((float)L->bar_x, (float)y2, L->bar_w, L->bar_h, g->anxiety/100.f,        (SDL_Color){205,63,69,255});
+    draw_balance_bar((float)L->bar_x, (float)y3, L->bar_w, L->bar_h, (int)g->balance);
+    prim_flush();
+
+    draw_text(L->fs, val_cl, L->value_x, y1);
+    draw_text(L->fs, val_anx, L->value_x, y2);
+    draw_text(L->fs, val_bal, L->value_x, y3);
+}
 
-    // ===== ОСНОВНА СЦЕНА (MODE_GAME та ін.) =====
-    // фон
-    if (g->bg) {
-        SDL_RenderClear(g->renderer);
-        SDL_Rect dst = {0,0,g->width,g->height};
-        render_bg_fit(g->renderer, g->bg, g->width, g->height);
+// репліка (друкарська машинка); панель уже в шарі HUD
+static void frame_dialog(Game* g, FrameCtx* f) {
+    if (!g->dialog.visible) return;
+    const UiLayout* L = &g->ui;
+    if (f->cinematic) {
+        typewriter_draw(L->cine_text.x, L->cine_text.y, (SDL_Color){234,239,244,255});
     } else {
-        SDL_SetRenderDrawColor(g->renderer, 18,20,24,255);
-        SDL_RenderClear(g->renderer);
+        // ТІЛЬКИ в межах панелі
+        SDL_RenderSetClipRect(g->renderer, &L->dlg_text);
+        typewriter_draw(L->dlg_text.x, L->dlg_text.y, (SDL_Color){210,210,210,255});
+        SDL_RenderSetClipRect(g->renderer, NULL);
     }
+}
 
-    // Чи ми в синематику?
-    bool cinematic = (g->cur_scene >= 0 && g->scenes[g->cur_scene].cinematic);
-
-    // Адаптивні коефіцієнти (потрібні і для діалогів)
-    float sW = g->width  / 1280.f;
-    float sH = g->height /  720.f;
-    float ui_scale = SDL_clamp(SDL_min(sW, sH), 0.75f, 1.0f);
+// заголовок сцени без виборів — затемнення й назва
+static void frame_title(Game* g, FrameCtx* f) {
+    (void)f;
+    if (g->rt.cur < 0) return;
+    const Scene* S = &g->scenes[g->rt.cur];
+    if (!S->title || S->num_choices != 0) return;
+    fill_view(g, (SDL_Color){0,0,0,200});
+    prim_flush();
+    draw_text_col(g->ui.fs, (SDL_Color){234,239,244,255}, S->title, g->ui.title_pos.x, g->ui.title_pos.y);
+}
 
-    // ----- HUD (бари/нотіфки) показуємо тільки якщо НЕ cinematic -----
-    if (!cinematic) {
-        float pad   = 16.f * ui_scale;
-        float bar_h = 18.f * ui_scale;
-        float gap   = 8.f  * ui_scale;
-        int   x     = (int)pad;
-        int   y     = (int)pad;
-        float panel_w = (float)g->width * 0.34f;
-
-        char val_cl[32], val_anx[32], val_bal[32];
-        SDL_snprintf(val_cl,  sizeof(val_cl),  "%.0f%%", g->memory_clarity);
-        SDL_snprintf(val_anx, sizeof(val_anx), "%.0f",   g->anxiety);
-        SDL_snprintf(val_bal, sizeof(val_bal), "%+d",    (int)g->balance);
-
-        int w_lbl1, w_lbl2, w_lbl3, htmp;
-        text_size(g->font, "Memory Clarity", &w_lbl1, &htmp);
-        text_size(g->font, "Anxiety",        &w_lbl2, NULL);
-        text_size(g->font, "Balance",        &w_lbl3, NULL);
-        int label_col_w = SDL_max(SDL_max(w_lbl1, w_lbl2), w_lbl3) + (int)(12*ui_scale);
-
-        int w_val1, w_val2, w_val3;
-        text_size(g->font, val_cl,  &w_val1, NULL);
-        text_size(g->font, val_anx, &w_val2, NULL);
-        text_size(g->font, val_bal, &w_val3, NULL);
-        int value_col_w = SDL_max(SDL_max(w_val1, w_val2), w_val3) + (int)(6*ui_scale);
-
-        int bar_x   = x + label_col_w + (int)(8*ui_scale);
-        int value_x = (int)(bar_x + panel_w + 10*ui_scale);
-
-        // підкладка
-        {
-            int hud_left  = (int)(x - pad*0.6f);
-            int hud_top   = (int)(y - pad*0.6f);
-            int hud_right = value_x + value_col_w + (int)(pad*0.6f);
-            int hud_h     = (int)(bar_h * 3.f + gap * 2.f + pad * 2.f);
-            if (hud_right > g->width - (int)(pad*0.4f)) hud_right = g->width - (int)(pad*0.4f);
-            SDL_SetRenderDrawColor(g->renderer, 20,24,32,180);
-            SDL_Rect hud = { hud_left, hud_top, hud_right - hud_left, hud_h };
-            SDL_RenderFillRect(g->renderer, &hud);
-        }
+// текст нотифікації растеризується раз (і ще раз — лише якщо змінився розмір шрифту)
+static void notif_bake(Game* g, Notif* n, float fs) {
+    if (n->tex && n->fs == fs) return;
+    if (n->tex) { SDL_DestroyTexture(n->tex); n->tex = NULL; }
+    n->fs = fs;
+    text_size(fs, n->text, &n->w, &n->h);
+    SDL_Surface* s = font_render_n(fs, n->text, (int)strlen(n->text));
+    if (!s) return;
+    n->tex = SDL_CreateTextureFromSurface(g->renderer, s);
+    if (n->tex) { SDL_SetTextureBlendMode(n->tex, SDL_BLENDMODE_BLEND); n->w = s->w; n->h = s->h; }
+    SDL_FreeSurface(s);
+}
 
-        // рядки
-        draw_text(g->renderer, g->font, "Memory Clarity", x, y);
-        draw_bar(g->renderer, (float)bar_x, (float)y, panel_w, bar_h, g->memory_clarity/100.f);
-        draw_text(g->renderer, g->font, val_cl, value_x, y);
-        y += (int)(bar_h + gap);
-
-        draw_text(g->renderer, g->font, "Anxiety", x, y);
-        SDL_SetRenderDrawColor(g->renderer, 36,42,51,180);
-        SDL_Rect border = { bar_x, y, (int)panel_w, (int)bar_h };
-        SDL_RenderDrawRect(g->renderer, &border);
-        int pad2 = 2;
-        SDL_Rect fill = { bar_x+pad2, y+pad2,
-                          (int)((panel_w-2*pad2) * (g->anxiety/100.f)),
-                          (int)(bar_h-2*pad2) };
-        SDL_SetRenderDrawColor(g->renderer, 205,63,69,255);
-        SDL_RenderFillRect(g->renderer, &fill);
-        draw_text(g->renderer, g->font, val_anx, value_x, y);
-        y += (int)(bar_h + gap);
-
-        draw_text(g->renderer, g->font, "Balance", x, y);
-        draw_balance_bar(g->renderer, (float)bar_x, (float)y, panel_w, bar_h, (int)g->balance);
-        draw_text(g->renderer, g->font, val_bal, value_x, y);
-
-        // нотифікації (прив'язано до HUD — теж ховаємо у cinematic)
-        for (int i=0; i<g->notif_count; ++i) {
-            Notif* n = &g->notifs[i];
-            int row_y = (int)(pad + (bar_h + gap) * n->row);
-            float t01 = SDL_clamp(n->t / 1.4f, 0.f, 1.f);
-            SDL_Color col = n->col; col.a = (Uint8)(255 * t01);
-            int tw=0, th=0; text_size(g->font, n->text, &tw, &th);
-            int tx = (int)(bar_x + panel_w - tw - 8);
-            int ty = row_y - (int)(th + 6);
-            if (ty < 2) ty = 2;
-            draw_text_col(g->renderer, g->font, col, n->text, tx, ty);
+// нотифікації (прив'язано до HUD — теж ховаємо у cinematic); готові спрайти, кадр міняє лише альфу і зсув
+static void frame_notifs(Game* g, FrameCtx* f) {
+    if (f->cinematic) return;
+    const UiLayout* L = &g->ui;
+    for (int i = 0; i < NOTIF_MAX; ++i) {
+        Notif* n = &g->notifs[i];
+        if (!n->live) continue;
+        notif_bake(g, n, L->fs);
+        Uint8 a = (Uint8)(255 * SDL_clamp(n->alpha, 0.f, 1.f));
+        int tx = (int)(L->bar_x + L->bar_w - n->w - 8);
+        int ty = L->hud_row_y[n->row] - (n->h + 6) + (int)floorf(n->dy + 0.5f);
+        if (ty < 2) ty = 2;
+        if (!n->tex) { // без текстури — як раніше, напряму
+            SDL_Color col = n->col; col.a = a;
+            draw_text_col(L->fs, col, n->text, tx, ty);
+            continue;
         }
+        prim_flush(); // поверх уже накопичених примітивів
+        SDL_SetTextureColorMod(n->tex, n->col.r, n->col.g, n->col.b);
+        SDL_SetTextureAlphaMod(n->tex, a);
+        SDL_Rect dst = { tx, ty, n->w, n->h };
+        SDL_RenderCopy(g->renderer, n->tex, NULL, &dst);
     }
+}
 
-    // ----- ДІАЛОГ (завжди відмальовуємо; вигляд залежить від cinematic) -----
-    if (g->dialog.visible) {
-        if (cinematic) {
-            // затемнення і короткий текст посередині
-            SDL_SetRenderDrawColor(g->renderer, 0,0,0,140);
-            SDL_Rect full = {0,0,g->width,g->height};
-            SDL_RenderFillRect(g->renderer, &full);
-
-            const char* msg = g->dialog.text ? g->dialog.text : "";
-            int tw=0, th=0; text_size(g->font, msg, &tw, &th);
-            int x = (g->width - tw)/2;
-            int y = (g->height - th)/2 + (int)(12*ui_scale);
-            draw_text_col(g->renderer, g->font, (SDL_Color){234,239,244,255}, msg, x, y);
-        } else {
-            // стандартна панель з виборами
-            int inner_pad = (int)(20 * ui_scale);
-            int panel_wi  = (int)(g->width - 2 * (16 * ui_scale));
-            int panel_hi  = (int)SDL_max(110.f * ui_scale, g->height * 0.18f);
-            int panel_x   = (g->width - panel_wi)/2;
-            int panel_y   = g->height - panel_hi - (int)(12 * ui_scale);
-
-            SDL_SetRenderDrawColor(g->renderer, 20,24,32,200);
-            SDL_Rect dlg = { panel_x, panel_y, panel_wi, panel_hi };
-            SDL_RenderFillRect(g->renderer, &dlg);
-
-            int cur_y = panel_y + inner_pad;
-            int cur_x = panel_x + inner_pad;
-            SDL_Color c_title = {234,239,244,255};
-            SDL_Color c_text  = {210,210,210,255};
-
-            if (g->dialog.speaker) {
-                draw_text_col(g->renderer, g->font, c_title, g->dialog.speaker, cur_x, cur_y);
-                int w,h; text_size(g->font, g->dialog.speaker, &w, &h);
-                cur_y += h + (int)(6*ui_scale);
-            }
+// спалах і загальний fade — завжди останні
+static void frame_fade(Game* g, FrameCtx* f) {
+    (void)f;
+    vfx_render_flash(g->renderer, g->width, g->height);
+    if (g->fade > 0.f) {
+        Uint8 a = (Uint8)SDL_clamp((int)(g->fade * 255), 0, 255);
+        fill_view(g, (SDL_Color){0,0,0,a});
+    }
+}
 
-            int text_w = panel_wi - inner_pad*2;
-            int wrap_h = 0;
-            {
-                SDL_Color mcol = {210,210,210,255};
-                const char* msg = g->dialog.text ? g->dialog.text : "";
-                SDL_Surface* ms = TTF_RenderUTF8_Blended_Wrapped(g->font, msg, mcol, (Uint32)text_w);
-                if (ms) { wrap_h = ms->h; SDL_FreeSurface(ms); }
-            }
+typedef void (*FrameLayerFn)(Game*, FrameCtx*);
+// світ (можна у зниженій роздільності) і все, що поверх нього — завжди в роздільності вікна
+static const FrameLayerFn g_world_layers[] = { frame_background, frame_vfx };
+static const FrameLayerFn g_scene_layers[] = {
+    frame_hud, frame_dialog, frame_title, frame_notifs, frame_fade,
+};
 
-            // 2) геометрія кнопок (перш ніж малювати текст)
-            int btn_h   = (int)(56 * ui_scale);
-            int btn_gap = (int)(10 * ui_scale);
-            int cols    = 2;
-            int btn_w   = (text_w - btn_gap) / cols;
-            int rows    = (g->dialog.num_choices + cols - 1) / cols;
-
-            // 3) максимально допустима висота тексту, щоб усе влізло в панель
-            int max_text_h = panel_hi - inner_pad*2
-                        - rows * btn_h
-                        - (rows ? (rows-1)*btn_gap : 0)
-                        - (int)(12 * ui_scale);          // відступ між текстом і кнопками
-            wrap_h = SDL_clamp(wrap_h, 0, SDL_max(0, max_text_h));
-
-            // 4) малюємо ТІЛЬКИ в межах панелі
-            SDL_Rect clip = { cur_x, cur_y, text_w, wrap_h };
-            SDL_RenderSetClipRect(g->renderer, &clip);
-            draw_text_wrapped(g->renderer, g->font, c_text, g->dialog.text, cur_x, cur_y, text_w);
-            SDL_RenderSetClipRect(g->renderer, NULL);
-
-            cur_y += wrap_h + (int)(12 * ui_scale);
-
-            // 5) кнопки — рівно під текстом
-            for (int i=0; i<g->dialog.num_choices; ++i) {
-                int row = i / cols, col = i % cols;
-                int bx = cur_x + col * (btn_w + btn_gap);
-                int by = cur_y + row * (btn_h + btn_gap);
-
-                SDL_Rect r = (SDL_Rect){ bx, by, btn_w, btn_h };
-                g->dialog.choices[i].rect = r;
-
-                bool hov = (g->dialog.hovered == i);
-                SDL_SetRenderDrawColor(g->renderer, hov?40:28, hov?48:32, hov?60:40, 255);
-                SDL_RenderFillRect(g->renderer, &r);
-                SDL_SetRenderDrawColor(g->renderer, hov?110:36, hov?178:42, hov?191:51, hov?255:180);
-                SDL_RenderDrawRect(g->renderer, &r);
-
-                int tx = bx + (int)(14 * ui_scale);
-                int ty = by + (int)(10 * ui_scale);
-                draw_text_col(g->renderer, g->font, c_title, g->dialog.choices[i].text, tx, ty);
-
-                char hint[64];
-                SDL_snprintf(hint, sizeof(hint), "(%+d CL, %+d ANX, %+d BAL)",
-                            g->dialog.choices[i].d_clarity,
-                            g->dialog.choices[i].d_anxiety,
-                            g->dialog.choices[i].d_balance);
-                draw_text_col(g->renderer, g->font, (SDL_Color){170,178,190,255}, hint, tx, ty + (int)(20 * ui_scale));
-            }
-        }
+// меню / налаштування: увесь екран — один кешований шар
+static void frame_screen(Game* g, FrameCtx* f) {
+    (void)f;
+    // кнопки меню: підсвічена та, що під курсором, інакше вибрана з клавіатури
+    if (g->mode == MODE_MENU) ui_set_focus(&g->ui_menu, g->menu_index);
+    else settings_sync(g);
+
+    struct { int mode; const void* bg; Uint32 bg_serial, rev; } key;
+    memset(&key, 0, sizeof(key));
+    key.mode = g->mode;
+    key.bg   = g->mode == MODE_MENU ? g->bg : NULL;
+    key.bg_serial = texcache_serial(key.bg);
+    key.rev  = ui_tree_rev(g->mode == MODE_MENU ? &g->ui_menu : &g->ui_settings);
+
+    Layer* S = &g->layer_screen;
+    bool cached = false;
+    if (layer_begin(S, g->width, g->height, &key, sizeof(key))) {
+        cached = true;
+    } else if (layer_ready(S)) {
+        layer_draw(S, 0, 0);
+        return;
     }
+    // або перемальовуємо шар, або (без цілей рендера) малюємо напряму щокадру
+    if (g->mode == MODE_MENU) {
+        render_bg_fit(g->renderer, g->bg, g->width, g->height, 0, 0);
+        // напівпрозорий оверлей
+        fill_view(g, (SDL_Color){0,0,0,160});
+        ui_draw(&g->ui_menu);
+    } else {
+        render_settings(g);
+    }
+    if (cached) {
+        layer_end(S);
+        layer_draw(S, 0, 0);
+    }
+}
 
-    if (g->cur_scene >= 0) {
-        Scene* S = &g->scenes[g->cur_scene];
-        if (S->title && S->num_choices == 0) {
-            SDL_SetRenderDrawColor(g->renderer, 0, 0, 0, 200);
-            SDL_Rect full = {0,0,g->width,g->height};
-            SDL_RenderFillRect(g->renderer, &full);
+static const FrameLayerFn g_screen_layers[] = { frame_screen, frame_fade };
 
-            SDL_Color col = {234,239,244,255};
-            int tw, th;
-            text_size(g->font, S->title, &tw, &th);
-            draw_text_col(g->renderer, g->font, col,
-                        S->title, (g->width - tw)/2, (g->height - th)/2);
+static void run_layers(Game* g, FrameCtx* f, const FrameLayerFn* layers, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        layers[i](g, f);
+        prim_flush(); // примітиви шару не змішуються з наступним
+    }
+}
 
-            // легке fade-in/out
-            SDL_RenderPresent(g->renderer);
+// фон і VFX: при render_scale < 1 — у меншу ціль і одним розтягуванням на вікно
+static void render_world(Game* g, FrameCtx* f) {
+    f->ow = g->width; f->oh = g->height;
+    if (g->render_scale < 0.999f) {
+        int ow = SDL_max(1, (int)(g->width  * g->render_scale + 0.5f));
+        int oh = SDL_max(1, (int)(g->height * g->render_scale + 0.5f));
+        if (swc_active() && !SDL_GetRenderTarget(g->renderer)) {
+            // програмний рендерер: світ у кут кадру, далі розтягування на місці (без текстури-цілі)
+            SDL_Rect vp = { 0, 0, ow, oh };
+            f->ow = ow; f->oh = oh;
+            SDL_RenderSetViewport(g->renderer, &vp);
+            run_layers(g, f, g_world_layers, SDL_arraysize(g_world_layers));
+            SDL_RenderSetViewport(g->renderer, NULL);
+            if (swc_stretch_corner(ow, oh)) return;
+            f->ow = g->width; f->oh = g->height;
+        }
+        Layer* W = &g->layer_world;
+        if (layer_begin_frame(W, ow, oh)) {
+            f->ow = ow; f->oh = oh;
+            run_layers(g, f, g_world_layers, SDL_arraysize(g_world_layers));
+            layer_end(W);
+            layer_draw_scaled(W, NULL);
+            return;
         }
     }
+    run_layers(g, f, g_world_layers, SDL_arraysize(g_world_layers)); // нативно
+}
 
-    // загальний fade
-    if (g->fade > 0.f) {
-        Uint8 a = (Uint8)SDL_clamp((int)(g->fade * 255), 0, 255);
-        SDL_SetRenderDrawColor(g->renderer, 0,0,0, a);
-        SDL_Rect full = (SDL_Rect){0,0,g->width,g->height};
-        SDL_RenderFillRect(g->renderer, &full);
-    }
+void game_render(Game* g) {
+    ui_layout(g); // дешево, якщо розмір/мова/сцена не змінились
+
+    FrameCtx f;
+    memset(&f, 0, sizeof(f));
+    f.cinematic = (g->rt.cur >= 0 && g->scenes[g->rt.cur].cinematic);
 
+    if (g->mode == MODE_MENU || g->mode == MODE_SETTINGS) {
+        run_layers(g, &f, g_screen_layers, SDL_arraysize(g_screen_layers));
+    } else {
+        render_world(g, &f);
+        run_layers(g, &f, g_scene_layers, SDL_arraysize(g_scene_layers));
+    }
     SDL_RenderPresent(g->renderer);
+
+    if (!g->startup.menu_shown) { // time-to-interactive: перший показаний кадр
+        g->startup.menu_shown = true;
+        SDL_Log("startup: interactive in %.1f ms", ms_since(g->startup.t0));
+    }
 }
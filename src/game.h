@@ -6,17 +6,12 @@
 #include <SDL2/SDL_ttf.h>
 #include <SDL2/SDL_mixer.h>
 #include <stdbool.h>
-
-typedef struct {
-    int op_cl,  val_cl;   // clarity
-    int op_anx, val_anx;  // anxiety
-    int op_bal, val_bal;  // balance
-    char* flag;           // "flag"
-    char* flag2;          // "flag2"
-    char* not_flag;       // "not_flag"
-    char* goto_id;        // id сцени для переходу
-    int   goto_index;     // індекс (резолвимо після завантаження)
-} SceneCheck;
+#include "vfx.h"
+#include "ui.h"
+#include "layer.h"
+#include "pacing.h"
+#include "scenes.h"
+#include "tween.h"
 
 typedef enum {
     MODE_MENU = 0,
@@ -25,51 +20,32 @@ typedef enum {
     MODE_END = 3,
 } GameMode;
 
+// Стан проходження: усе, що змінюється під час гри. Самі сцени (Scene) після
+// завантаження лише читаються — їх можна ділити між потоками без копій.
 typedef struct {
-    char* key;
-    char* val;
-} StringKV;
+    int    cur;           // поточна сцена (-1 — немає)
+    int    queued;        // сцена, що чекає піку fade (-1)
+    float  auto_left;     // до auto_next, с; відлік після появи репліки
+    TweenId auto_tw;      // веде auto_left; на паузі, поки репліка друкується
+    int*   visits;        // скільки разів показували кожну сцену
+    int    visits_n;
+} SceneRuntime;
 
-typedef struct {
-    StringKV* kv;
-    int count;
-} Lang;
-
-typedef struct {
-    char* text;
-    int d_clarity, d_anxiety, d_balance;
-    int next;
-
-    char* add_flags[4];   int add_flags_n;   // із "flags+"
-    char* rem_flags[4];   int rem_flags_n;   // із "flags-"
-} SceneChoice;
-
-typedef struct {
-    char* id;
-    char* speaker;
-    char* text;
-    int num_choices;
-    SceneChoice choices[4];
-
-    char* background;
-    char* music;
-
-    char* title;
-    float auto_time;
-    char* auto_next_id;
-    int   auto_next;
-
-    SceneCheck checks[4];
-    int checks_count;
-
-    bool cinematic;
-} Scene;
+#define NOTIF_MAX 16
 
+// нотифікація — готовий спрайт тексту; анімуються лише альфа і зсув
 typedef struct {
+    bool live;
+    int row;     // 0=Clar, 1=Anx, 2=Bal
+    Uint32 seq;  // порядок появи: при переповненні замінюємо найстарішу
     char text[24];
     SDL_Color col;
-    float t;     // час анімації
-    int row;    // 0=Clar, 1=Anx, 2=Bal 
+    SDL_Texture* tex; // біла маска; колір і альфа — mod при копіюванні
+    int w, h;
+    float fs;    // розмір шрифту, з яким растеризовано
+    float alpha; // 0..1
+    float dy;    // зсув від місця в рядку, px
+    TweenId tw_alpha, tw_dy;
 } Notif;
 
 typedef struct {
@@ -77,7 +53,6 @@ typedef struct {
     int d_clarity; // ефекти на стати
     int d_anxiety;
     int d_balance;
-    SDL_Rect rect; // область кнопки  
 } Choice;
 
 typedef struct {
@@ -85,25 +60,66 @@ typedef struct {
     const char* text; // текст репліки
     int num_choices; // 0..4
     Choice choices[4];
-    int hovered; // index hover or -1
     bool visible; // чи показаувати панель
 } Dialog;
 
+// Старт у два етапи: вікно, меню й музика — одразу в game_init; рядки, сюжет і фон
+// першої сцени — у фоновому потоці. Головний потік забирає результат у game_update.
+typedef struct {
+    SDL_Thread*  thread;
+    SDL_atomic_t done;          // потік закінчив (результати нижче готові)
+    bool         ready;         // результати вже в Game — сюжет можна починати
+    bool         menu_shown;    // перший кадр меню показано (time-to-interactive)
+    int          pending;       // пункт меню, натиснутий до готовності (-1)
+    Uint64       t0;            // початок game_init
+
+    // вхід / вихід потоку (до ready головний потік їх не чіпає)
+    char         lang_code[8];
+    Lang         lang;
+    Scene*       scenes;
+    int          scenes_count, start_scene;
+    StrIndex     scene_ix;
+    bool         scenes_ok;
+    char         first_bg[128];
+    SDL_Surface* first_bg_surf; // декодований фон стартової сцени
+} Startup;
+
+// Геометрія UI, порахована наперед (ui_layout у game.c): перераховується лише після
+// зміни розміру вікна, мови чи сцени. Прямокутники меню, налаштувань і кнопок діалогу
+// розкладка віддає віджетам (ui.h), решта — тут.
+typedef struct {
+    bool   valid;
+    Uint32 rev;               // +1 з кожним перерахунком (ключ кешованих шарів)
+    float  scale;             // ui_scale від 1280x720
+    float  fs;                // розмір шрифту сцени
+
+    // HUD
+    SDL_Rect hud_bg;
+    int   hud_x, hud_row_y[3];
+    int   bar_x, value_x;
+    float bar_w, bar_h;
+
+    // діалог
+    SDL_Rect  dlg_text;       // ще й кліп репліки
+    SDL_Point cine_text;      // репліка в синематику
+    SDL_Point title_pos;
+} UiLayout;
+
 typedef struct {
     SDL_Window*   window;
     SDL_Renderer* renderer;
     bool          running;
 
     // Stats (0..100)
-    float memory_clarity, memory_clarity_t;
-    float anxiety,        anxiety_t;
-    float balance,          balance_t;  // -100..+100
+    // *_t — точний стан моделі (stats.c), без суфікса — згладжене значення для HUD
+    float memory_clarity; double memory_clarity_t;
+    float anxiety;        double anxiety_t;
+    float balance;        double balance_t;  // -100..+100
 
     int width, height;
 
     // Resources
     SDL_Texture* bg; // background
-    TTF_Font*    font; // for text rendering
 
     Mix_Music* music; // actual song
     char current_music[256]; // that what now playin
@@ -112,43 +128,65 @@ typedef struct {
     char lang_code[8]; // "ua"/"ru"/"en"
 
     Dialog dialog; // current dialog
-    int cur_scene;
+    SceneRuntime rt; // де ми в сюжеті (сцени — лише для читання)
+    Startup startup;
 
     Lang lang;
     Scene* scenes;
     int    scenes_count;
     int    start_scene;
+    StrIndex scene_ix;   // id -> індекс у scenes (перебудовується після hot-reload)
 
-    Notif notifs[6];
-    int notif_count;
+    Notif notifs[NOTIF_MAX];
+    Uint32 notif_seq;
 
     GameMode mode; // MENU/SETTINGS/GAME/END
     int menu_index; // choose
 
     float fade;
-    float fade_dir;
-    int   fade_queued_scene;
+    TweenId fade_tw;
+    bool fade_to_black; // ще темніє; на піку — queued сцена
+
+    TweenId stat_tw[3]; // clarity/anxiety/balance -> *_t
 
     char menu_bg_path[128];
 
-    SDL_Rect menu_btn_rects[4];
-    int menu_hover;
+    UiLayout ui;
+    UiTree   ui_menu, ui_settings, ui_dialog;
+    Layer    layer_screen;    // меню / налаштування цілком
+    Layer    layer_bg;        // фон сцени, вписаний у вікно
+    Layer    layer_ui;        // статичний UI сцени: підкладка HUD, рамки, підписи, панель діалогу
+    Layer    layer_world;     // фон + VFX у зниженій роздільності (render_scale < 1)
+    int mouse_x, mouse_y; // остання позиція курсора з подій (-1 — ще не було)
 
     char* flags[MAX_FLAGS];
     int   flags_count;
 
     time_t cfg_mtime;
+    time_t scenes_mtime; // scenes json (for hot-reload)
+    long   scenes_size;
+
+    Uint64 rng_seed;     // seed ігрового Rng (ефекти); фіксується для відтворення
 
     bool fullscreen;
+    float render_scale;  // частка роздільності вікна для фону й VFX (UI — завжди нативно)
+    PaceMode pace_mode;  // темп кадрів (pacing.h)
+    int   fps_limit;     // для PACE_LIMIT
+    int   bg_fps;        // вікно без фокуса / згорнуте
+    int   res_hops;      // фони й музика в пам'яті — для сцен за стільки переходів (residency.h)
+    bool  res_by_visits; // ...у межах кроку частіше відвідувані — першими
+    bool  cpu_compose;   // програмний рендерер: заливки, fade і розтягування світу — SIMD (swcomp.h)
+    bool img_cache;      // дисковий кеш декодованих фонів
+    bool img_cache_lz4;  // ...стиснутий (менше диска, без mmap-пікселів)
+    float text_cps;      // швидкість появи репліки, символів/с (0 = одразу)
+    float text_cps_cinematic;
 
     char menu_music_path[128];
 
     int set_sel_res;
-    bool set_drop_res_open;
     bool set_fullscreen;
     int set_lang_idx;
-    bool set_drag_vol;
-    SDL_Rect set_vol_rect;
+    int set_scale_idx;
 } Game;
 
 bool game_init(Game* g, const char* title, int w, int h);
@@ -156,5 +194,7 @@ void game_shutdown(Game* g);
 void game_handle_event(Game* g, const SDL_Event* e);
 void game_update(Game* g, float dt);
 void game_render(Game* g);
+void game_wait_ready(Game* g);   // дочекатися фонового старту (запис/відтворення — детермінізм)
+bool game_jump_to_scene(Game* g, const char* id);   // налагодження: одразу в сцену (--scene)
 
 #endif /* HYDRANGEA_GAME_H */
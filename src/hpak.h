@@ -0,0 +1,64 @@
+#ifndef HYDRANGEA_HPAK_H
+#define HYDRANGEA_HPAK_H
+
+// Формат архіву ассетів assets.hpak (спільний для гри і пакувальника).
+//
+//   HpakHeader
+//   дані файлів (кожен вирівняно на 16 байтів; збережені як є або LZ4 block)
+//   імена (нормалізовані шляхи, без '\0')
+//   індекс: HpakSlot[slots], відкрита адресація за hpak_hash(ім'я), slots — степінь двійки
+//
+// Усі числа little-endian.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define HPAK_VERSION  1u
+#define HPAK_FLAG_LZ4 1u
+
+typedef struct {
+    char     magic[4];    // "HPAK"
+    uint32_t version;
+    uint32_t count;       // файлів
+    uint32_t slots;       // розмір хеш-таблиці
+    uint64_t index_off;
+    uint64_t names_off;
+} HpakHeader;
+
+typedef struct {
+    uint64_t hash;        // 0 = порожній слот
+    uint64_t data_off;
+    uint32_t name_off;    // відносно names_off
+    uint32_t name_len;
+    uint32_t stored_size;
+    uint32_t raw_size;
+    uint32_t flags;
+    uint32_t reserved;
+} HpakSlot;
+
+// "assets/Music\calm.mp3" -> "music/calm.mp3"
+static inline size_t hpak_normalize(const char* in, char* out, size_t n) {
+    if (in[0] == '.' && (in[1] == '/' || in[1] == '\\')) in += 2;
+    const char* pre = "assets";
+    size_t k = 0;
+    while (k < 6 && (in[k] | 0x20) == pre[k]) k++;
+    if (k == 6 && (in[6] == '/' || in[6] == '\\')) in += 7;
+
+    size_t len = 0;
+    for (; *in && len + 1 < n; ++in) {
+        char c = *in;
+        if (c == '\\') c = '/';
+        if (c >= 'A' && c <= 'Z') c = (char)(c + 32);
+        out[len++] = c;
+    }
+    out[len] = 0;
+    return len;
+}
+
+static inline uint64_t hpak_hash(const char* norm, size_t len) {
+    uint64_t h = 1469598103934665603ull;
+    for (size_t i = 0; i < len; ++i) { h ^= (unsigned char)norm[i]; h *= 1099511628211ull; }
+    return h ? h : 1;
+}
+
+#endif /* HYDRANGEA_HPAK_H */
@@ -0,0 +1,202 @@
+#include "imgcache.h"
+#include "assets.h"
+#include "mapfile.h"
+#include "lz4blk.h"
+#include "qoi.h"
+#include <SDL2/SDL_image.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define HIC_VERSION   1u
+#define HIC_CODEC_RAW 0u
+#define HIC_CODEC_LZ4 1u
+#define HIC_MAPPED_TAG 0x4D415050u // 'MAPP'
+
+typedef struct {
+    char   magic[4];     // "HIC1"
+    Uint32 version;
+    Uint64 src_mtime;
+    Uint64 src_size;
+    Uint64 path_hash;
+    Uint32 w, h;         // ARGB8888, pitch = w*4
+    Uint32 codec;
+    Uint32 data_size;    // байтів після заголовка
+    Uint32 reserved[4];
+} HicHeader;
+SDL_COMPILE_TIME_ASSERT(hic_header_size, sizeof(HicHeader) == 64);
+
+// живе в surface->userdata, поки пікселі вказують у мапінг
+typedef struct {
+    Uint32 tag;
+    MapFile map;
+} MappedPixels;
+
+static bool g_enabled = false;
+static bool g_compress = false;
+static char g_dir[512];
+
+void imgcache_configure(bool enabled, bool compress) {
+    g_enabled = enabled;
+    g_compress = compress;
+    g_dir[0] = 0;
+    if (!enabled) return;
+    char* pref = SDL_GetPrefPath("Hydrangea", "imgcache");
+    if (!pref) { SDL_Log("imgcache: no writable pref path, cache disabled: %s", SDL_GetError()); g_enabled = false; return; }
+    SDL_snprintf(g_dir, sizeof(g_dir), "%s", pref);
+    SDL_free(pref);
+}
+
+static Uint64 fnv1a64(const char* s) {
+    Uint64 h = 1469598103934665603ull;
+    for (; *s; ++s) { h ^= (unsigned char)*s; h *= 1099511628211ull; }
+    return h;
+}
+
+static void cache_file(const char* path, int w, int h, char* out, size_t n) {
+    SDL_snprintf(out, n, "%s%016llx_%dx%d.hic", g_dir, (unsigned long long)fnv1a64(path), w, h);
+}
+
+SDL_Surface* imgcache_fetch(const char* path, int w, int h) {
+    if (!g_enabled) return NULL;
+    Uint64 mtime, size;
+    if (!asset_stamp(path, &mtime, &size)) return NULL;
+
+    char file[640]; cache_file(path, w, h, file, sizeof(file));
+    MapFile m;
+    if (!mapfile_open(&m, file)) return NULL;
+
+    const HicHeader* hd = (const HicHeader*)m.data;
+    // джерело змінилось або файл битий -> промах, кеш перезапишеться після декодування
+    if (m.size < sizeof(HicHeader) || memcmp(hd->magic, "HIC1", 4) != 0 || hd->version != HIC_VERSION ||
+        hd->src_mtime != mtime || hd->src_size != size || hd->path_hash != fnv1a64(path) ||
+        (w && ((int)hd->w != w || (int)hd->h != h)) ||
+        m.size < sizeof(HicHeader) + hd->data_size) {
+        mapfile_close(&m);
+        return NULL;
+    }
+
+    const Uint32 raw_size = hd->w * hd->h * 4;
+    const unsigned char* payload = m.data + sizeof(HicHeader);
+    SDL_Surface* s = NULL;
+
+    if (hd->codec == HIC_CODEC_RAW && hd->data_size == raw_size) {
+        MappedPixels* mp = (MappedPixels*)malloc(sizeof(MappedPixels));
+        if (mp) s = SDL_CreateRGBSurfaceWithFormatFrom((void*)payload, (int)hd->w, (int)hd->h, 32,
+                                                        (int)hd->w * 4, SDL_PIXELFORMAT_ARGB8888);
+        if (s) { mp->tag = HIC_MAPPED_TAG; mp->map = m; s->userdata = mp; return s; }
+        free(mp);
+    } else if (hd->codec == HIC_CODEC_LZ4) {
+        s = SDL_CreateRGBSurfaceWithFormat(0, (int)hd->w, (int)hd->h, 32, SDL_PIXELFORMAT_ARGB8888);
+        if (s && (s->pitch != (int)hd->w * 4 ||
+                  lz4_decompress(payload, (int)hd->data_size, (unsigned char*)s->pixels, (int)raw_size) != (int)raw_size)) {
+            SDL_FreeSurface(s);
+            s = NULL;
+        }
+    }
+    mapfile_close(&m);
+    return s;
+}
+
+void imgcache_store(const char* path, int w, int h, SDL_Surface* src) {
+    if (!g_enabled || !src) return;
+    HicHeader hd;
+    memset(&hd, 0, sizeof(hd));
+    if (!asset_stamp(path, &hd.src_mtime, &hd.src_size)) return;
+
+    SDL_Surface* s = SDL_ConvertSurfaceFormat(src, SDL_PIXELFORMAT_ARGB8888, 0);
+    if (!s) return;
+
+    const int row = s->w * 4;
+    const int raw_size = row * s->h;
+    unsigned char* raw = (unsigned char*)s->pixels;
+    unsigned char* packed = NULL;
+    if (s->pitch != row) { // щільно пакуємо рядки
+        packed = (unsigned char*)malloc((size_t)raw_size);
+        if (!packed) { SDL_FreeSurface(s); return; }
+        for (int y = 0; y < s->h; ++y) memcpy(packed + (size_t)y*row, (unsigned char*)s->pixels + (size_t)y*s->pitch, (size_t)row);
+        raw = packed;
+    }
+
+    memcpy(hd.magic, "HIC1", 4);
+    hd.version = HIC_VERSION;
+    hd.path_hash = fnv1a64(path);
+    hd.w = (Uint32)s->w; hd.h = (Uint32)s->h;
+    hd.codec = HIC_CODEC_RAW;
+    hd.data_size = (Uint32)raw_size;
+
+    const unsigned char* payload = raw;
+    unsigned char* lz = NULL;
+    if (g_compress) {
+        int cap = lz4_compress_bound(raw_size);
+        lz = (unsigned char*)malloc((size_t)cap);
+        int n = lz ? lz4_compress(raw, raw_size, lz, cap) : 0;
+        if (n > 0 && n < raw_size) { hd.codec = HIC_CODEC_LZ4; hd.data_size = (Uint32)n; payload = lz; }
+    }
+
+    // пишемо в тимчасовий файл і підміняємо — читач ніколи не побачить половину
+    char file[640], tmp[700];
+    cache_file(path, w, h, file, sizeof(file));
+    SDL_snprintf(tmp, sizeof(tmp), "%s.%lu.tmp", file, (unsigned long)SDL_ThreadID());
+    FILE* f = fopen(tmp, "wb");
+    bool ok = f && fwrite(&hd, sizeof(hd), 1, f) == 1 && fwrite(payload, 1, hd.data_size, f) == hd.data_size;
+    if (f) ok = (fclose(f) == 0) && ok;
+    if (ok) {
+        remove(file); // Windows: rename не перезаписує
+        ok = rename(tmp, file) == 0;
+    }
+    if (!ok) { remove(tmp); SDL_Log("imgcache: can't write %s", file); }
+
+    free(lz);
+    free(packed);
+    SDL_FreeSurface(s);
+}
+
+static SDL_Surface* load_qoi(const char* path) {
+    size_t size = 0;
+    void* data = asset_load(path, &size);
+    if (!data) return NULL;
+    SDL_Surface* s = qoi_decode(data, size);
+    free(data);
+    return s;
+}
+
+// x.png -> спершу x.qoi поруч (tools/qoi_conv.c). Окремі файли — лише якщо QOI не старший
+// за PNG (забули переконвертувати); в архіві обидва запаковані разом.
+static SDL_Surface* decode(const char* path) {
+    const char* ext = SDL_strrchr(path, '.');
+    if (ext && SDL_strcasecmp(ext, ".qoi") == 0) return load_qoi(path);
+    if (ext && SDL_strcasecmp(ext, ".png") == 0) {
+        char alt[512];
+        SDL_snprintf(alt, sizeof(alt), "%.*s.qoi", (int)(ext - path), path);
+        Uint64 qm, qs, pm, ps;
+        if (asset_stamp(alt, &qm, &qs) &&
+            (assets_have_pack() || !asset_stamp(path, &pm, &ps) || qm >= pm)) {
+            SDL_Surface* s = load_qoi(alt);
+            if (s) return s;
+            SDL_Log("imgcache: %s: %s, falling back to PNG", alt, SDL_GetError());
+        }
+    }
+    return IMG_Load_RW(asset_open(path), 1);
+}
+
+SDL_Surface* imgcache_load(const char* path) {
+    SDL_Surface* s = imgcache_fetch(path, 0, 0);
+    if (s) return s;
+    s = decode(path);
+    if (s) imgcache_store(path, 0, 0, s);
+    return s;
+}
+
+void imgcache_free_surface(SDL_Surface* s) {
+    if (!s) return;
+    MappedPixels* mp = (MappedPixels*)s->userdata;
+    if (mp && mp->tag == HIC_MAPPED_TAG) {
+        s->userdata = NULL;
+        SDL_FreeSurface(s);      // спершу surface, потім пам'ять під пікселями
+        mapfile_close(&mp->map);
+        free(mp);
+        return;
+    }
+    SDL_FreeSurface(s);
+}
@@ -0,0 +1,24 @@
+#ifndef HYDRANGEA_IMGCACHE_H
+#define HYDRANGEA_IMGCACHE_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+// Дисковий кеш декодованих картинок (ARGB8888), щоб не розпаковувати PNG щоразу.
+// Ключ — шлях джерела + його mtime і розмір; варіанти w x h зберігаються окремо.
+// Нестиснені файли мапляться в пам'ять і стають пікселями surface без копіювання.
+
+void imgcache_configure(bool enabled, bool compress);
+
+// w = h = 0: оригінальний розмір; інакше — готовий зменшений варіант
+SDL_Surface* imgcache_fetch(const char* path, int w, int h);
+void         imgcache_store(const char* path, int w, int h, SDL_Surface* s);
+
+// IMG_Load через кеш: hit -> без декодування; miss -> декодуємо і записуємо.
+// x.qoi поруч з x.png (не старший за нього) вантажиться замість PNG — див. qoi.h.
+SDL_Surface* imgcache_load(const char* path);
+
+// звільняє surface з imgcache_* (знімає мапінг, якщо він є)
+void         imgcache_free_surface(SDL_Surface* s);
+
+#endif /* HYDRANGEA_IMGCACHE_H */
@@ -0,0 +1,246 @@
+#include "jsonr.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define JR_MAX_DEPTH 64
+
+static void fail(JsonReader* r, const char* why) {
+    if (r->err) return;
+    r->err = why;
+    r->err_at = r->p;
+    r->p = r->end; // далі — лише «кінець»
+}
+
+static void ws(JsonReader* r) {
+    char* p = r->p;
+    for (; p < r->end; ++p) {
+        if (*p == '\n') { r->line++; r->line_at = p + 1; }
+        else if (*p != ' ' && *p != '\r' && *p != '\t') break;
+    }
+    r->p = p;
+}
+
+void jr_init(JsonReader* r, char* buf, size_t n) {
+    jr_init_span(r, buf, buf + n, 1, buf);
+}
+
+void jr_init_span(JsonReader* r, char* p, char* end, int line, char* line_at) {
+    memset(r, 0, sizeof(*r));
+    r->p = p;
+    r->end = end;
+    r->line = line;
+    r->line_at = line_at;
+}
+
+bool jr_ok(const JsonReader* r) { return r->err == NULL; }
+
+void jr_log_error(const JsonReader* r, const char* what) {
+    if (!r->err) return;
+    int col = (int)(r->err_at - r->line_at) + 1; // у байтах
+    SDL_Log("%s: JSON error at %d:%d: %s", what, r->line, col, r->err);
+}
+
+JrType jr_peek(JsonReader* r) {
+    ws(r);
+    if (r->p >= r->end) return JR_NONE;
+    switch (*r->p) {
+        case '{': return JR_OBJ;
+        case '[': return JR_ARR;
+        case '"': return JR_STR;
+        case 't': case 'f': return JR_BOOL;
+        case 'n': return JR_NULL;
+        case '-': case '0': case '1': case '2': case '3': case '4':
+        case '5': case '6': case '7': case '8': case '9': return JR_NUM;
+        default: return JR_NONE;
+    }
+}
+
+static bool open(JsonReader* r, char c) {
+    ws(r);
+    if (r->p >= r->end || *r->p != c) { fail(r, c == '{' ? "expected '{'" : "expected '['"); return false; }
+    if (++r->depth > JR_MAX_DEPTH) { fail(r, "nesting too deep"); return false; }
+    ++r->p;
+    r->first = true;
+    return true;
+}
+
+// кінець контейнера або кома перед наступним елементом; true — контейнер закрито
+static bool close_or_comma(JsonReader* r, char c) {
+    ws(r);
+    if (r->p >= r->end) { fail(r, "unexpected end"); return true; }
+    if (*r->p == c) { ++r->p; --r->depth; r->first = false; return true; }
+    if (r->first) { r->first = false; return false; }
+    if (*r->p != ',') { fail(r, "expected ','"); return true; }
+    ++r->p;
+    ws(r);
+    if (r->p < r->end && *r->p == c) { fail(r, "trailing ','"); return true; }
+    return false;
+}
+
+bool jr_obj_begin(JsonReader* r) { return open(r, '{'); }
+bool jr_arr_begin(JsonReader* r) { return open(r, '['); }
+
+bool jr_arr_next(JsonReader* r) {
+    if (r->err) return false;
+    return !close_or_comma(r, ']');
+}
+
+static void put_utf8(char** w, Uint32 cp) {
+    char* o = *w;
+    if (cp < 0x80) { *o++ = (char)cp; }
+    else if (cp < 0x800) { *o++ = (char)(0xC0 | (cp >> 6)); *o++ = (char)(0x80 | (cp & 0x3F)); }
+    else if (cp < 0x10000) {
+        *o++ = (char)(0xE0 | (cp >> 12)); *o++ = (char)(0x80 | ((cp >> 6) & 0x3F)); *o++ = (char)(0x80 | (cp & 0x3F));
+    } else {
+        *o++ = (char)(0xF0 | (cp >> 18)); *o++ = (char)(0x80 | ((cp >> 12) & 0x3F));
+        *o++ = (char)(0x80 | ((cp >> 6) & 0x3F)); *o++ = (char)(0x80 | (cp & 0x3F));
+    }
+    *w = o;
+}
+
+static int hex4(const char* p, const char* end) {
+    if (end - p < 4) return -1;
+    int v = 0;
+    for (int i = 0; i < 4; ++i) {
+        char c = p[i];
+        v <<= 4;
+        if (c >= '0' && c <= '9') v |= c - '0';
+        else if (c >= 'a' && c <= 'f') v |= c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F') v |= c - 'A' + 10;
+        else return -1;
+    }
+    return v;
+}
+
+// рядок на місці: запис іде не попереду читання (екранування лише скорочує), '\0' — на місці лапки
+static char* read_string(JsonReader* r) {
+    char* out = r->p + 1;
+    char* q = out;
+    char* w = out;
+    while (q < r->end) {
+        char c = *q;
+        if (c == '"') { *w = '\0'; r->p = q + 1; return out; }
+        if ((unsigned char)c < 0x20) break;
+        if (c != '\\') { *w++ = *q++; continue; }
+        if (++q >= r->end) break;
+        switch (*q++) {
+            case '"':  *w++ = '"';  break;
+            case '\\': *w++ = '\\'; break;
+            case '/':  *w++ = '/';  break;
+            case 'b':  *w++ = '\b'; break;
+            case 'f':  *w++ = '\f'; break;
+            case 'n':  *w++ = '\n'; break;
+            case 'r':  *w++ = '\r'; break;
+            case 't':  *w++ = '\t'; break;
+            case 'u': {
+                int hi = hex4(q, r->end);
+                if (hi < 0) { r->p = q; fail(r, "bad \\u escape"); return NULL; }
+                q += 4;
+                Uint32 cp = (Uint32)hi;
+                if (hi >= 0xD800 && hi <= 0xDBFF && q + 1 < r->end && q[0] == '\\' && q[1] == 'u') {
+                    int lo = hex4(q + 2, r->end);
+                    if (lo >= 0xDC00 && lo <= 0xDFFF) { cp = 0x10000 + (((Uint32)hi - 0xD800) << 10) + ((Uint32)lo - 0xDC00); q += 6; }
+                }
+                put_utf8(&w, cp); // не довше за 6 (12) прочитаних байтів
+                break;
+            }
+            default: r->p = q - 1; fail(r, "bad escape"); return NULL;
+        }
+    }
+    r->p = q;
+    fail(r, "unterminated string");
+    return NULL;
+}
+
+bool jr_obj_key(JsonReader* r, char** key) {
+    *key = NULL;
+    if (r->err || close_or_comma(r, '}')) return false;
+    if (*r->p != '"') { fail(r, "expected key"); return false; }
+    char* k = read_string(r);
+    if (!k) return false;
+    ws(r);
+    if (r->p >= r->end || *r->p != ':') { fail(r, "expected ':'"); return false; }
+    ++r->p;
+    *key = k;
+    return true;
+}
+
+static bool literal(JsonReader* r, const char* lit) {
+    size_t n = strlen(lit);
+    if ((size_t)(r->end - r->p) < n || memcmp(r->p, lit, n) != 0) { fail(r, "bad literal"); return false; }
+    r->p += n;
+    return true;
+}
+
+void jr_skip(JsonReader* r) {
+    switch (jr_peek(r)) {
+        case JR_OBJ: {
+            jr_obj_begin(r);
+            char* k;
+            while (jr_obj_key(r, &k)) jr_skip(r);
+            break;
+        }
+        case JR_ARR:
+            jr_arr_begin(r);
+            while (jr_arr_next(r)) jr_skip(r);
+            break;
+        case JR_STR:  read_string(r); break;
+        case JR_NUM:  jr_num(r, 0.0); break;
+        case JR_BOOL: literal(r, *r->p == 't' ? "true" : "false"); break;
+        case JR_NULL: literal(r, "null"); break;
+        case JR_NONE: fail(r, "expected value"); break;
+    }
+}
+
+bool jr_span(JsonReader* r, char** begin, char** end) {
+    JrType t = jr_peek(r);
+    if (t != JR_OBJ && t != JR_ARR) { fail(r, "expected object or array"); return false; }
+    char* p = r->p;
+    char* e = r->end;
+    int depth = 0, line = r->line;
+    char* line_at = r->line_at;   // рядок ведемо локально, у r — лише після успіху
+    for (; p < e; ++p) {
+        char c = *p;
+        if (c == '"') {
+            for (++p; p < e; ++p) {
+                if (*p == '"') break;
+                if (*p == '\\') ++p;
+            }
+            if (p >= e) break;
+        } else if (c == '{' || c == '[') {
+            depth++;
+        } else if (c == '}' || c == ']') {
+            if (--depth == 0) {
+                *begin = r->p; *end = r->p = p + 1;
+                r->line = line; r->line_at = line_at;
+                return true;
+            }
+        } else if (c == '\n') {
+            line++; line_at = p + 1;
+        }
+    }
+    // помилку показуємо на початку значення
+    fail(r, "unterminated object");
+    return false;
+}
+
+char* jr_str(JsonReader* r) {
+    if (jr_peek(r) != JR_STR) { jr_skip(r); return NULL; }
+    return read_string(r);
+}
+
+double jr_num(JsonReader* r, double def) {
+    if (jr_peek(r) != JR_NUM) { jr_skip(r); return def; }
+    char* e = NULL;
+    double v = strtod(r->p, &e); // буфер закінчується '\0', тож strtod не вийде за межі
+    if (!e || e == r->p || e > r->end) { fail(r, "bad number"); return def; }
+    r->p = e;
+    return v;
+}
+
+bool jr_bool(JsonReader* r, bool def) {
+    if (jr_peek(r) != JR_BOOL) { jr_skip(r); return def; }
+    bool v = *r->p == 't';
+    literal(r, v ? "true" : "false");
+    return v;
+}
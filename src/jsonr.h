@@ -0,0 +1,50 @@
+#ifndef HYDRANGEA_JSONR_H
+#define HYDRANGEA_JSONR_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+// Потоковий читач JSON без дерева (pull-парсер). Працює прямо в буфері файлу:
+// рядки розекрановуються на місці й закінчуються '\0', тож jr_str/jr_obj_key
+// повертають вказівники в буфер — живуть, поки живе буфер.
+// Після першої помилки все повертає «порожнє» (цикли завершуються), jr_ok() == false.
+//
+//   jr_obj_begin(r);
+//   char* key;
+//   while (jr_obj_key(r, &key)) { switch (key[0]) { ... default: jr_skip(r); } }
+
+typedef enum { JR_NONE = 0, JR_NULL, JR_BOOL, JR_NUM, JR_STR, JR_OBJ, JR_ARR } JrType;
+
+typedef struct {
+    char*       p;
+    char*       end;
+    const char* err;     // перша помилка або NULL
+    char*       err_at;
+    int         depth;
+    bool        first;   // щойно відкрили контейнер — кома ще не потрібна
+    int         line;    // рядок файлу біля p (рахуємо лише в пробілах: розекрановані '\n' не плутають)
+    char*       line_at; // початок цього рядка
+} JsonReader;
+
+void   jr_init(JsonReader* r, char* buf, size_t n);   // buf[n] має бути '\0'
+// шматок [p, end) більшого буфера, знайдений jr_span; line/line_at — звідти ж (для помилок)
+void   jr_init_span(JsonReader* r, char* p, char* end, int line, char* line_at);
+bool   jr_ok(const JsonReader* r);
+void   jr_log_error(const JsonReader* r, const char* what);   // SDL_Log з рядком і колонкою
+
+JrType jr_peek(JsonReader* r);
+
+bool   jr_obj_begin(JsonReader* r);                  // '{'
+bool   jr_obj_key(JsonReader* r, char** key);        // наступний ключ (і ':'), false — кінець '}'
+bool   jr_arr_begin(JsonReader* r);                  // '['
+bool   jr_arr_next(JsonReader* r);                   // є ще елемент; false — кінець ']'
+
+// значення: якщо тип не той — значення пропускається, повертається def / NULL
+char*  jr_str(JsonReader* r);
+double jr_num(JsonReader* r, double def);
+bool   jr_bool(JsonReader* r, bool def);
+void   jr_skip(JsonReader* r);
+// межі наступного об'єкта/масиву без розбору й без змін у буфері (для розбору шматками в потоках)
+bool   jr_span(JsonReader* r, char** begin, char** end);
+
+#endif /* HYDRANGEA_JSONR_H */
@@ -0,0 +1,109 @@
+#include "layer.h"
+#include "prim.h"
+#include <string.h>
+
+static SDL_Renderer* g_r = NULL;
+static SDL_BlendMode g_premul = SDL_BLENDMODE_INVALID;
+static bool          g_premul_ok = false;
+
+bool layers_init(SDL_Renderer* r) {
+    g_r = r;
+    // src уже помножено на alpha: out = src + dst * (1 - srcA)
+    g_premul = SDL_ComposeCustomBlendMode(
+        SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+        SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+
+    // чи вміє рендерер і цілі, і такий режим — пробуємо на крихітній текстурі
+    g_premul_ok = false;
+    SDL_Texture* t = SDL_CreateTexture(r, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, 1, 1);
+    if (t) {
+        g_premul_ok = SDL_SetTextureBlendMode(t, g_premul) == 0;
+        SDL_DestroyTexture(t);
+    }
+    if (!g_premul_ok) SDL_Log("layer: premultiplied blending unsupported, UI overlay drawn directly");
+    return true;
+}
+
+void layers_shutdown(void) { g_r = NULL; }
+
+bool layers_overlay_supported(void) { return g_premul_ok; }
+
+void layer_init(Layer* L, LayerKind kind) {
+    memset(L, 0, sizeof(*L));
+    L->kind = kind;
+}
+
+void layer_free(Layer* L) {
+    if (L->tex) SDL_DestroyTexture(L->tex);
+    layer_init(L, L->kind);
+}
+
+void layer_invalidate(Layer* L) { L->valid = false; }
+
+// ціль потрібного розміру стає поточною й очищається
+static bool target_begin(Layer* L, int w, int h) {
+    if (!L->tex || L->w != w || L->h != h) {
+        if (L->tex) SDL_DestroyTexture(L->tex);
+        L->tex = SDL_CreateTexture(g_r, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, w, h);
+        if (!L->tex) {
+            SDL_Log("layer: target %dx%d failed: %s", w, h, SDL_GetError());
+            L->w = L->h = 0; L->valid = false;
+            return false;
+        }
+        SDL_SetTextureBlendMode(L->tex, L->kind == LAYER_OVERLAY ? g_premul : SDL_BLENDMODE_NONE);
+        SDL_SetTextureScaleMode(L->tex, SDL_ScaleModeLinear); // для layer_draw_scaled
+        L->w = w; L->h = h;
+    }
+
+    prim_flush(); // накопичене належить попередній цілі
+    L->prev = SDL_GetRenderTarget(g_r);
+    if (SDL_SetRenderTarget(g_r, L->tex) != 0) {
+        SDL_Log("layer: SetRenderTarget failed: %s", SDL_GetError());
+        L->valid = false;
+        return false;
+    }
+    SDL_SetRenderDrawColor(g_r, 0, 0, 0, L->kind == LAYER_OVERLAY ? 0 : 255);
+    SDL_RenderClear(g_r);
+    return true;
+}
+
+bool layer_begin(Layer* L, int w, int h, const void* key, size_t key_n) {
+    if (!g_r || w <= 0 || h <= 0 || key_n > LAYER_KEY_MAX) return false;
+    if (L->kind == LAYER_OVERLAY && !g_premul_ok) return false;
+    if (L->valid && L->w == w && L->h == h && L->key_n == key_n && memcmp(L->key, key, key_n) == 0)
+        return false;
+    if (!target_begin(L, w, h)) return false;
+
+    memcpy(L->key, key, key_n);
+    L->key_n = key_n;
+    L->valid = true;
+    return true;
+}
+
+bool layer_begin_frame(Layer* L, int w, int h) {
+    if (!g_r || w <= 0 || h <= 0) return false;
+    if (L->kind == LAYER_OVERLAY && !g_premul_ok) return false;
+    if (!target_begin(L, w, h)) return false;
+    L->key_n = 0;
+    L->valid = true;
+    return true;
+}
+
+void layer_end(Layer* L) {
+    prim_flush();
+    SDL_SetRenderTarget(g_r, L->prev);
+    L->prev = NULL;
+}
+
+bool layer_ready(const Layer* L) { return L->valid && L->tex; }
+
+void layer_draw(const Layer* L, int dx, int dy) {
+    if (!layer_ready(L)) return;
+    SDL_Rect dst = { dx, dy, L->w, L->h };
+    SDL_RenderCopy(g_r, L->tex, NULL, &dst);
+}
+
+void layer_draw_scaled(const Layer* L, const SDL_Rect* dst) {
+    if (!layer_ready(L)) return;
+    SDL_RenderCopy(g_r, L->tex, NULL, dst);
+}
@@ -0,0 +1,49 @@
+#ifndef HYDRANGEA_LAYER_H
+#define HYDRANGEA_LAYER_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+// Кешовані шари кадру: статичний вміст малюється раз у текстуру-ціль розміру вікна,
+// далі кадр — лише копія цієї текстури. Шар перемальовується, коли змінився ключ
+// (байти всього, від чого залежить вміст: розмір, текстура фону, ревізія віджетів...).
+//
+// LAYER_OPAQUE  — непрозорий (фон, екран меню); копіюється без змішування.
+// LAYER_OVERLAY — напівпрозорий UI поверх сцени. У текстурі лежить premultiplied alpha
+//                 (так виходить при звичайному BLEND у прозору ціль), тож і накладати
+//                 його треба premultiplied-режимом. Якщо рендерер такого не вміє —
+//                 layer_begin повертає false, і вміст малюється напряму щокадру.
+
+#define LAYER_KEY_MAX 64
+
+typedef enum { LAYER_OPAQUE = 0, LAYER_OVERLAY } LayerKind;
+
+typedef struct {
+    LayerKind    kind;
+    SDL_Texture* tex;
+    int          w, h;
+    bool         valid;
+    Uint8        key[LAYER_KEY_MAX];
+    size_t       key_n;
+    SDL_Texture* prev;    // ціль до layer_begin
+} Layer;
+
+bool layers_init(SDL_Renderer* r);
+void layers_shutdown(void);
+bool layers_overlay_supported(void);
+
+void layer_init(Layer* L, LayerKind kind);
+void layer_free(Layer* L);
+void layer_invalidate(Layer* L);
+
+// true — шар застарів і зараз є ціллю рендера: намалювати вміст і викликати layer_end.
+// false — або кеш актуальний, або шар недоступний (див. layer_ready).
+bool layer_begin(Layer* L, int w, int h, const void* key, size_t key_n);
+// те саме без ключа: вміст щокадру новий, шар — лише проміжна ціль (напр. знижена роздільність)
+bool layer_begin_frame(Layer* L, int w, int h);
+void layer_end(Layer* L);
+bool layer_ready(const Layer* L);            // є що копіювати
+void layer_draw(const Layer* L, int dx, int dy);
+void layer_draw_scaled(const Layer* L, const SDL_Rect* dst);   // NULL — на всю ціль, лінійно
+
+#endif /* HYDRANGEA_LAYER_H */
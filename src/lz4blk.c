@@ -0,0 +1,113 @@
+#include "lz4blk.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LZ4_MINMATCH   4
+#define LZ4_LASTLITS   5   // останні 5 байтів — завжди літерали
+#define LZ4_MFLIMIT    12  // матч не може починатися ближче 12 байтів до кінця
+#define LZ4_MAXOFF     65535
+#define LZ4_HASH_LOG   14
+
+static uint32_t read32(const unsigned char* p) { uint32_t v; memcpy(&v, p, 4); return v; }
+static uint32_t hash4(uint32_t v) { return (v * 2654435761u) >> (32 - LZ4_HASH_LOG); }
+
+int lz4_compress_bound(int src_size) {
+    return src_size + src_size / 255 + 16;
+}
+
+// довжина понад 15 кодується байтами 255... + залишок
+static unsigned char* put_len(unsigned char* op, int len) {
+    while (len >= 255) { *op++ = 255; len -= 255; }
+    *op++ = (unsigned char)len;
+    return op;
+}
+
+static unsigned char* put_seq(unsigned char* op, const unsigned char* lit, int lit_n, int off, int match_n) {
+    unsigned char* token = op++;
+    int ml = match_n - LZ4_MINMATCH;
+    *token = (unsigned char)(((lit_n >= 15 ? 15 : lit_n) << 4) | (match_n ? (ml >= 15 ? 15 : ml) : 0));
+    if (lit_n >= 15) op = put_len(op, lit_n - 15);
+    memcpy(op, lit, (size_t)lit_n); op += lit_n;
+    if (!match_n) return op; // останній блок — лише літерали
+    *op++ = (unsigned char)(off & 0xFF);
+    *op++ = (unsigned char)(off >> 8);
+    if (ml >= 15) op = put_len(op, ml - 15);
+    return op;
+}
+
+int lz4_compress(const unsigned char* src, int n, unsigned char* dst, int cap) {
+    if (n < 0 || cap < lz4_compress_bound(n)) return 0;
+
+    int* table = (int*)calloc((size_t)1 << LZ4_HASH_LOG, sizeof(int)); // позиція+1, 0 = порожньо
+    if (!table) return 0;
+
+    unsigned char* op = dst;
+    int ip = 0, anchor = 0;
+    const int mflimit = n - LZ4_MFLIMIT;
+    const int matchlimit = n - LZ4_LASTLITS;
+    int misses = 0;
+
+    while (ip < mflimit) {
+        uint32_t seq = read32(src + ip);
+        uint32_t h = hash4(seq);
+        int ref = table[h] - 1;
+        table[h] = ip + 1;
+
+        if (ref < 0 || ip - ref > LZ4_MAXOFF || read32(src + ref) != seq) {
+            ip += 1 + (misses++ >> 6); // на нестисливих ділянках крокуємо ширше
+            continue;
+        }
+        misses = 0;
+
+        int ml = LZ4_MINMATCH;
+        while (ip + ml < matchlimit && src[ip + ml] == src[ref + ml]) ml++;
+
+        op = put_seq(op, src + anchor, ip - anchor, ip - ref, ml);
+        ip += ml;
+        anchor = ip;
+        if (ip < mflimit) table[hash4(read32(src + ip - 2))] = ip - 2 + 1;
+    }
+
+    op = put_seq(op, src + anchor, n - anchor, 0, 0);
+    free(table);
+    return (int)(op - dst);
+}
+
+int lz4_decompress(const unsigned char* src, int src_size, unsigned char* dst, int dst_cap) {
+    const unsigned char* ip = src;
+    const unsigned char* iend = src + src_size;
+    unsigned char* op = dst;
+    unsigned char* oend = dst + dst_cap;
+
+    while (ip < iend) {
+        unsigned token = *ip++;
+
+        size_t lit = token >> 4;
+        if (lit == 15) {
+            unsigned b;
+            do { if (ip >= iend) return -1; b = *ip++; lit += b; } while (b == 255);
+        }
+        if ((size_t)(iend - ip) < lit || (size_t)(oend - op) < lit) return -1;
+        memcpy(op, ip, lit); ip += lit; op += lit;
+        if (ip == iend) break; // останні літерали
+
+        if (iend - ip < 2) return -1;
+        size_t off = (size_t)ip[0] | ((size_t)ip[1] << 8);
+        ip += 2;
+        if (off == 0 || off > (size_t)(op - dst)) return -1;
+
+        size_t ml = token & 15;
+        if (ml == 15) {
+            unsigned b;
+            do { if (ip >= iend) return -1; b = *ip++; ml += b; } while (b == 255);
+        }
+        ml += LZ4_MINMATCH;
+        if ((size_t)(oend - op) < ml) return -1;
+
+        const unsigned char* m = op - off;
+        if (off >= ml) { memcpy(op, m, ml); op += ml; }
+        else while (ml--) *op++ = *m++; // перекриття: копіюємо побайтно
+    }
+    return (int)(op - dst);
+}
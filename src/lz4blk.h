@@ -0,0 +1,15 @@
+#ifndef HYDRANGEA_LZ4BLK_H
+#define HYDRANGEA_LZ4BLK_H
+
+// Мінімальний кодек у форматі LZ4 block (сумісний з LZ4_decompress_safe).
+// Швидкий жадібний компресор без зовнішніх залежностей.
+
+int lz4_compress_bound(int src_size);
+
+// повертає кількість записаних байтів або 0, якщо не влізло в dst_cap
+int lz4_compress(const unsigned char* src, int src_size, unsigned char* dst, int dst_cap);
+
+// повертає кількість розпакованих байтів або -1 при пошкоджених даних
+int lz4_decompress(const unsigned char* src, int src_size, unsigned char* dst, int dst_cap);
+
+#endif /* HYDRANGEA_LZ4BLK_H */
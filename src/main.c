@@ -1,29 +1,120 @@
 #include "game.h"
+#include "replay.h"
+#include "pacing.h"
 #include <SDL2/SDL.h>
+#include <string.h>
+
+// --record <file> | --replay <file> [--fast] | --uncapped | --scene <id>
+typedef struct {
+    const char* record;
+    const char* replay;
+    bool fast;      // відтворення без рендеру і без очікування
+    bool uncapped;  // кадри без обмежень (замір), поверх frame_pacing з конфігу
+    const char* scene; // одразу в цю сцену, минаючи меню (налагодження)
+} Args;
+
+static bool parse_args(int argc, char** argv, Args* a) {
+    memset(a, 0, sizeof(*a));
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) a->record = argv[++i];
+        else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) a->replay = argv[++i];
+        else if (strcmp(argv[i], "--fast") == 0) a->fast = true;
+        else if (strcmp(argv[i], "--uncapped") == 0) a->uncapped = true;
+        else if (strcmp(argv[i], "--scene") == 0 && i + 1 < argc) a->scene = argv[++i];
+        else { SDL_Log("Unknown argument: %s", argv[i]); return false; }
+    }
+    if (a->record && a->replay) { SDL_Log("--record and --replay are exclusive"); return false; }
+    // стрибок не пишеться в запис — відтворення розійшлося б
+    if (a->scene && (a->record || a->replay)) { SDL_Log("--scene can't be combined with --record/--replay"); return false; }
+    return true;
+}
+
+// Програвання запису: події й dt — із файлу, від SDL беремо лише закриття вікна.
+static void run_replay(Game* g, Replay* rp, bool fast) {
+    const Uint64 freq = SDL_GetPerformanceFrequency();
+    const Uint64 start = SDL_GetPerformanceCounter();
+    double game_time = 0.0;
+    Uint32 frames = 0;
+
+    while (g->running) {
+        SDL_Event e;
+        while (SDL_PollEvent(&e)) {
+            if (e.type == SDL_QUIT) { g->running = false; }
+        }
+        if (!g->running) break;
+
+        float dt = 0.f;
+        int kind;
+        while ((kind = replay_play_next(rp, &e, &dt)) == REPLAY_EVENT) {
+            // розмір вікна мусить збігатися із записаним, бо гра читає його сама
+            if (e.type == SDL_WINDOWEVENT &&
+                (e.window.event == SDL_WINDOWEVENT_RESIZED || e.window.event == SDL_WINDOWEVENT_SIZE_CHANGED)) {
+                SDL_SetWindowSize(g->window, e.window.data1, e.window.data2);
+            }
+            game_handle_event(g, &e);
+        }
+        if (kind == REPLAY_END) break;
+
+        game_update(g, dt);
+        game_time += dt;
+        ++frames;
+        if (fast) continue;
+
+        game_render(g);
+        // тримаємо реальний темп: чекаємо, поки стінний час не наздожене ігровий
+        double wall = (double)(SDL_GetPerformanceCounter() - start) / (double)freq;
+        if (game_time > wall) SDL_Delay((Uint32)((game_time - wall) * 1000.0));
+    }
+
+    double wall = (double)(SDL_GetPerformanceCounter() - start) / (double)freq;
+    SDL_Log("replay: %u frames in %.3f s wall (%.0f fps)", frames, wall, wall > 0.0 ? frames / wall : 0.0);
+}
 
 int main(int argc, char** argv) {
-    (void)argc; (void)argv; // Unused
-    
+    Args args;
+    if (!parse_args(argc, argv, &args)) return 1;
+
     Game g = {0};
-    if (!game_init(&g, "The Hydrangea", 1280, 720)) return 1;
+    Replay* rp = NULL;
+    if (args.replay) {
+        rp = replay_play_open(args.replay, &g.rng_seed);
+        if (!rp) return 1;
+    }
+    if (!game_init(&g, "The Hydrangea", 1280, 720)) { replay_close(rp); return 1; }
+    if (args.uncapped) pacing_set_mode(PACE_UNCAPPED, 0);
+    // у записі кадр готовності сюжету залежить від швидкості потоку — фіксуємо: одразу
+    if (rp || args.record) game_wait_ready(&g);
+
+    if (rp) {
+        run_replay(&g, rp, args.fast);
+        replay_close(rp);
+        game_shutdown(&g);
+        return 0;
+    }
+    if (args.record) rp = replay_record_open(args.record, g.rng_seed);
+    if (args.scene && !game_jump_to_scene(&g, args.scene)) { game_shutdown(&g); return 1; }
 
-    Uint32 prev = SDL_GetTicks();
+    const Uint64 freq = SDL_GetPerformanceFrequency();
+    Uint64 prev = SDL_GetPerformanceCounter();
     while (g.running) {
         SDL_Event e;
         while (SDL_PollEvent(&e)) {
+            if (e.type == SDL_WINDOWEVENT) pacing_window_event(&e.window);
+            replay_record_event(rp, &e);
             game_handle_event(&g, &e);
         }
 
-        Uint32 now = SDL_GetTicks();
-        float dt = (now - prev) / 1000.f;
+        Uint64 now = SDL_GetPerformanceCounter();
+        float dt = (float)((double)(now - prev) / (double)freq);
         prev = now;
 
+        replay_record_frame(rp, dt);
         game_update(&g, dt);
-        game_render(&g);
-
-        SDL_Delay(1);
+        if (pacing_should_render()) game_render(&g); // згорнуте вікно не малюємо
+        pacing_end_frame();
     }
 
+    replay_close(rp);
     game_shutdown(&g);
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,63 @@
+#include "mapfile.h"
+#include <string.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+
+bool mapfile_open(MapFile* m, const char* path) {
+    memset(m, 0, sizeof(*m));
+    HANDLE f = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                           FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (f == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER sz;
+    if (!GetFileSizeEx(f, &sz) || sz.QuadPart == 0) { CloseHandle(f); return false; }
+
+    HANDLE map = CreateFileMappingA(f, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!map) { CloseHandle(f); return false; }
+    void* p = MapViewOfFile(map, FILE_MAP_READ, 0, 0, 0);
+    if (!p) { CloseHandle(map); CloseHandle(f); return false; }
+
+    m->data = (const unsigned char*)p;
+    m->size = (size_t)sz.QuadPart;
+    m->handle = f;
+    m->mapping = map;
+    return true;
+}
+
+void mapfile_close(MapFile* m) {
+    if (m->data)    UnmapViewOfFile((void*)m->data);
+    if (m->mapping) CloseHandle((HANDLE)m->mapping);
+    if (m->handle)  CloseHandle((HANDLE)m->handle);
+    memset(m, 0, sizeof(*m));
+}
+
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+bool mapfile_open(MapFile* m, const char* path) {
+    memset(m, 0, sizeof(*m));
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) { close(fd); return false; }
+
+    void* p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // мапінг живе й без дескриптора
+    if (p == MAP_FAILED) return false;
+
+    m->data = (const unsigned char*)p;
+    m->size = (size_t)st.st_size;
+    return true;
+}
+
+void mapfile_close(MapFile* m) {
+    if (m->data) munmap((void*)m->data, m->size);
+    memset(m, 0, sizeof(*m));
+}
+#endif
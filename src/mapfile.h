@@ -0,0 +1,18 @@
+#ifndef HYDRANGEA_MAPFILE_H
+#define HYDRANGEA_MAPFILE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Файл, відображений у пам'ять лише для читання (mmap / MapViewOfFile)
+typedef struct {
+    const unsigned char* data;
+    size_t size;
+    void*  handle;   // Windows: HANDLE файлу; POSIX: не використовується
+    void*  mapping;  // Windows: HANDLE мапінгу
+} MapFile;
+
+bool mapfile_open(MapFile* m, const char* path);
+void mapfile_close(MapFile* m);
+
+#endif /* HYDRANGEA_MAPFILE_H */
@@ -0,0 +1,109 @@
+#include "pacing.h"
+
+#define SPIN_MS 2   // останні мілісекунди до дедлайну — спін (SDL_Delay неточний)
+
+static SDL_Renderer* g_r = NULL;
+static SDL_Window*   g_w = NULL;
+static PaceMode      g_mode = PACE_VSYNC;
+static int           g_fps = 60, g_bg_fps = 10;
+static bool          g_vsync_on = false;   // чи present справді чекає vblank
+static bool          g_hidden = false;     // згорнуто / приховано
+static bool          g_unfocused = false;
+static Uint64        g_next = 0;           // дедлайн наступного кадру (тики лічильника)
+
+void pacing_set_mode(PaceMode mode, int fps) {
+    g_mode = mode;
+    if (fps > 0) g_fps = fps;
+    g_vsync_on = false;
+    if (g_r) {
+        if (SDL_RenderSetVSync(g_r, mode == PACE_VSYNC ? 1 : 0) != 0 && mode == PACE_VSYNC)
+            SDL_Log("pacing: vsync unavailable (%s), limiting to display rate", SDL_GetError());
+        SDL_RendererInfo info;
+        if (SDL_GetRendererInfo(g_r, &info) == 0) g_vsync_on = (info.flags & SDL_RENDERER_PRESENTVSYNC) != 0;
+    }
+    g_next = 0;
+}
+
+void pacing_init(SDL_Renderer* r, SDL_Window* w, PaceMode mode, int fps, int bg_fps) {
+    g_r = r; g_w = w;
+    g_bg_fps = bg_fps;
+    g_hidden = g_unfocused = false;
+    pacing_set_mode(mode, fps);
+    SDL_Log("pacing: %s (%d fps limit, %d fps in background, vsync %s)",
+            pacing_mode_name(g_mode), g_fps, g_bg_fps, g_vsync_on ? "on" : "off");
+}
+
+void pacing_window_event(const SDL_WindowEvent* e) {
+    switch (e->event) {
+        case SDL_WINDOWEVENT_HIDDEN:
+        case SDL_WINDOWEVENT_MINIMIZED:    g_hidden = true; break;
+        case SDL_WINDOWEVENT_SHOWN:
+        case SDL_WINDOWEVENT_RESTORED:
+        case SDL_WINDOWEVENT_MAXIMIZED:
+        case SDL_WINDOWEVENT_EXPOSED:      g_hidden = false; break;
+        case SDL_WINDOWEVENT_FOCUS_LOST:   g_unfocused = true; break;
+        case SDL_WINDOWEVENT_FOCUS_GAINED: g_unfocused = false; break;
+        default: return;
+    }
+    g_next = 0; // темп змінився — відлік з нуля
+}
+
+bool pacing_should_render(void) { return !g_hidden; }
+
+static int display_hz(void) {
+    SDL_DisplayMode dm;
+    int idx = g_w ? SDL_GetWindowDisplayIndex(g_w) : 0;
+    if (SDL_GetCurrentDisplayMode(idx < 0 ? 0 : idx, &dm) == 0 && dm.refresh_rate > 0) return dm.refresh_rate;
+    return 60;
+}
+
+// цільова частота; 0 — не чекаємо (uncapped або vsync уже тримає темп)
+static int target_fps(void) {
+    int fps = 0;
+    switch (g_mode) {
+        case PACE_VSYNC:    fps = g_vsync_on ? 0 : display_hz(); break;
+        case PACE_LIMIT:    fps = g_fps; break;
+        case PACE_UNCAPPED: fps = 0; break;
+    }
+    // невидиме вікно — завжди повільно; без фокуса — якщо не міряємо швидкодію
+    bool throttle = g_hidden || (g_unfocused && g_mode != PACE_UNCAPPED);
+    if (throttle && g_bg_fps > 0 && (fps == 0 || g_bg_fps < fps)) fps = g_bg_fps;
+    // невидиме вікно нічого не present-ить, тож vsync не чекає: без ліміту цикл крутився б на 100% CPU
+    if (g_hidden && fps == 0) fps = display_hz();
+    return fps;
+}
+
+void pacing_end_frame(void) {
+    int fps = target_fps();
+    if (fps <= 0) { g_next = 0; return; }
+
+    const Uint64 freq = SDL_GetPerformanceFrequency();
+    const Uint64 period = freq / (Uint64)fps;
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (!g_next) g_next = now;
+    g_next += period;
+    if (g_next < now) { g_next = now; return; } // запізнились — не наздоганяємо пачкою кадрів
+
+    // сон грубо, решту — спін
+    Uint64 left_ms = (g_next - now) * 1000 / freq;
+    if (left_ms > SPIN_MS) SDL_Delay((Uint32)(left_ms - SPIN_MS));
+    while (SDL_GetPerformanceCounter() < g_next) { }
+}
+
+PaceMode pacing_mode_from_name(const char* s, PaceMode def) {
+    if (!s) return def;
+    if (SDL_strcasecmp(s, "vsync") == 0)    return PACE_VSYNC;
+    if (SDL_strcasecmp(s, "limit") == 0)    return PACE_LIMIT;
+    if (SDL_strcasecmp(s, "uncapped") == 0) return PACE_UNCAPPED;
+    SDL_Log("pacing: unknown mode '%s'", s);
+    return def;
+}
+
+const char* pacing_mode_name(PaceMode m) {
+    switch (m) {
+        case PACE_VSYNC:    return "vsync";
+        case PACE_LIMIT:    return "limit";
+        case PACE_UNCAPPED: return "uncapped";
+    }
+    return "vsync";
+}
@@ -0,0 +1,27 @@
+#ifndef HYDRANGEA_PACING_H
+#define HYDRANGEA_PACING_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+// Темп кадрів головного циклу.
+// PACE_VSYNC    — чекає present; якщо рендерер vsync не дав — обмежувач на частоті дисплея.
+// PACE_LIMIT    — точний обмежувач: сон до ~2 мс до дедлайну, далі — спін по лічильнику.
+// PACE_UNCAPPED — без обмежень (замір швидкодії).
+// Згорнуте/приховане вікно не рендериться; без фокуса — темп знижується до bg_fps.
+// Приховане вікно обмежене завжди: bg_fps, а якщо той 0 — частотою дисплея.
+// Стан вікна — лише з SDL_WINDOWEVENT (pacing_window_event).
+
+typedef enum { PACE_VSYNC = 0, PACE_LIMIT, PACE_UNCAPPED } PaceMode;
+
+void pacing_init(SDL_Renderer* r, SDL_Window* w, PaceMode mode, int fps, int bg_fps);
+void pacing_set_mode(PaceMode mode, int fps);
+void pacing_window_event(const SDL_WindowEvent* e);
+
+bool pacing_should_render(void);   // false — вікно не видно, кадр лише оновлюємо
+void pacing_end_frame(void);       // чекає до наступного кадру за поточним режимом
+
+PaceMode    pacing_mode_from_name(const char* s, PaceMode def);
+const char* pacing_mode_name(PaceMode m);
+
+#endif /* HYDRANGEA_PACING_H */
@@ -0,0 +1,104 @@
+#include "prim.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#define CIRCLE_SEGS_MAX 64
+
+static SDL_Renderer* g_r = NULL;
+static SDL_Vertex* g_v = NULL;
+static int*        g_i = NULL;
+static int g_nv = 0, g_ni = 0;
+static int g_cap_v = 0, g_cap_i = 0;
+
+void prim_init(SDL_Renderer* r) {
+    g_r = r;
+    g_nv = g_ni = 0;
+}
+
+void prim_shutdown(void) {
+    free(g_v); free(g_i);
+    g_v = NULL; g_i = NULL;
+    g_nv = g_ni = g_cap_v = g_cap_i = 0;
+    g_r = NULL;
+}
+
+// місце під nv вершин і ni індексів; буфер росте й більше не звільняється
+static bool reserve(int nv, int ni) {
+    if (g_nv + nv > g_cap_v) {
+        int cap = SDL_max(256, g_cap_v * 2);
+        while (cap < g_nv + nv) cap *= 2;
+        SDL_Vertex* v = (SDL_Vertex*)realloc(g_v, sizeof(SDL_Vertex) * (size_t)cap);
+        if (!v) return false;
+        g_v = v; g_cap_v = cap;
+    }
+    if (g_ni + ni > g_cap_i) {
+        int cap = SDL_max(384, g_cap_i * 2);
+        while (cap < g_ni + ni) cap *= 2;
+        int* i = (int*)realloc(g_i, sizeof(int) * (size_t)cap);
+        if (!i) return false;
+        g_i = i; g_cap_i = cap;
+    }
+    return true;
+}
+
+static inline void vert(float x, float y, SDL_Color c) {
+    g_v[g_nv++] = (SDL_Vertex){ {x, y}, c, {0.f, 0.f} };
+}
+
+void prim_rect(float x, float y, float w, float h, SDL_Color c) {
+    if (w <= 0.f || h <= 0.f || c.a == 0 || !reserve(4, 6)) return;
+    int b = g_nv;
+    vert(x, y, c); vert(x + w, y, c); vert(x + w, y + h, c); vert(x, y + h, c);
+    int* k = &g_i[g_ni];
+    k[0] = b; k[1] = b + 1; k[2] = b + 2;
+    k[3] = b; k[4] = b + 2; k[5] = b + 3;
+    g_ni += 6;
+}
+
+void prim_rect_i(const SDL_Rect* r, SDL_Color c) {
+    prim_rect((float)r->x, (float)r->y, (float)r->w, (float)r->h, c);
+}
+
+void prim_outline_i(const SDL_Rect* r, SDL_Color c) {
+    if (r->w <= 0 || r->h <= 0) return;
+    const float x = (float)r->x, y = (float)r->y, w = (float)r->w, h = (float)r->h;
+    prim_rect(x, y, w, 1.f, c);                         // верх
+    if (r->h > 1) prim_rect(x, y + h - 1.f, w, 1.f, c); // низ
+    if (r->h > 2) {                                     // боки без кутів (кути не блендяться двічі)
+        prim_rect(x, y + 1.f, 1.f, h - 2.f, c);
+        if (r->w > 1) prim_rect(x + w - 1.f, y + 1.f, 1.f, h - 2.f, c);
+    }
+}
+
+void prim_circle(float cx, float cy, float radius, SDL_Color c) {
+    if (radius <= 0.f || c.a == 0) return;
+    int segs = SDL_clamp((int)(radius * 2.5f), 12, CIRCLE_SEGS_MAX);
+    // центр + внутрішнє кільце (повна альфа) + зовнішнє (нульова) = згладжений край
+    if (!reserve(1 + segs * 2, segs * 9)) return;
+    SDL_Color edge = c; edge.a = 0;
+    const float r_in = SDL_max(0.f, radius - 0.5f), r_out = radius + 0.5f;
+    const int b = g_nv;
+    vert(cx, cy, c);
+    for (int s = 0; s < segs; ++s) {
+        float a = (float)s * (6.2831853f / (float)segs);
+        float ca = cosf(a), sa = sinf(a);
+        vert(cx + ca * r_in,  cy + sa * r_in,  c);
+        vert(cx + ca * r_out, cy + sa * r_out, edge);
+    }
+    for (int s = 0; s < segs; ++s) {
+        int n = (s + 1) % segs;
+        int in0 = b + 1 + s*2, out0 = in0 + 1;
+        int in1 = b + 1 + n*2, out1 = in1 + 1;
+        int* k = &g_i[g_ni];
+        k[0] = b;   k[1] = in0;  k[2] = in1;
+        k[3] = in0; k[4] = out0; k[5] = out1;
+        k[6] = in0; k[7] = out1; k[8] = in1;
+        g_ni += 9;
+    }
+}
+
+void prim_flush(void) {
+    if (g_ni > 0 && g_r) SDL_RenderGeometry(g_r, NULL, g_v, g_nv, g_i, g_ni);
+    g_nv = g_ni = 0;
+}
@@ -0,0 +1,23 @@
+#ifndef HYDRANGEA_PRIM_H
+#define HYDRANGEA_PRIM_H
+
+#include <SDL2/SDL.h>
+
+// Пакетні 2D-примітиви: прямокутники, рамки й згладжені кола збираються у вершинний
+// буфер і йдуть на GPU одним SDL_RenderGeometry у prim_flush().
+// Порядок малювання зберігається в межах пакета. Перед будь-яким RenderCopy
+// (текст, текстури) — prim_flush(), інакше текст опиниться під примітивами.
+
+void prim_init(SDL_Renderer* r);
+void prim_shutdown(void);
+
+void prim_rect(float x, float y, float w, float h, SDL_Color c);
+void prim_rect_i(const SDL_Rect* r, SDL_Color c);
+// рамка товщиною 1 px всередині прямокутника (як SDL_RenderDrawRect)
+void prim_outline_i(const SDL_Rect* r, SDL_Color c);
+// коло з 1 px згладженим краєм
+void prim_circle(float cx, float cy, float radius, SDL_Color c);
+
+void prim_flush(void);
+
+#endif /* HYDRANGEA_PRIM_H */
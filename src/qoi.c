@@ -0,0 +1,170 @@
+#include "qoi.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define QOI_OP_INDEX 0x00  // 00xxxxxx
+#define QOI_OP_DIFF  0x40  // 01xxxxxx
+#define QOI_OP_LUMA  0x80  // 10xxxxxx
+#define QOI_OP_RUN   0xC0  // 11xxxxxx
+#define QOI_OP_RGB   0xFE
+#define QOI_OP_RGBA  0xFF
+#define QOI_MASK_2   0xC0
+
+#define QOI_HEADER     14
+#define QOI_PADDING    8            // сім нулів і 0x01 у кінці
+#define QOI_PIXELS_MAX 400000000u   // межа зі специфікації
+
+// піксель — як ARGB8888 у пам'яті: канали окремо, щоб не розбирати Uint32 у кожній операції
+typedef struct { Uint8 r, g, b, a; } Rgba;
+
+static int hash(Rgba c) { return (c.r * 3 + c.g * 5 + c.b * 7 + c.a * 11) & 63; }
+
+static Uint32 pack(Rgba c) { return (Uint32)c.a << 24 | (Uint32)c.r << 16 | (Uint32)c.g << 8 | c.b; }
+
+static Uint32 read_be32(const Uint8* p) {
+    return (Uint32)p[0] << 24 | (Uint32)p[1] << 16 | (Uint32)p[2] << 8 | p[3];
+}
+
+static Uint8* put_be32(Uint8* p, Uint32 v) {
+    p[0] = (Uint8)(v >> 24); p[1] = (Uint8)(v >> 16); p[2] = (Uint8)(v >> 8); p[3] = (Uint8)v;
+    return p + 4;
+}
+
+bool qoi_is(const void* data, size_t size) {
+    return data && size >= QOI_HEADER + QOI_PADDING && memcmp(data, "qoif", 4) == 0;
+}
+
+SDL_Surface* qoi_decode(const void* data, size_t size) {
+    if (!qoi_is(data, size)) { SDL_SetError("qoi: not a QOI image"); return NULL; }
+    const Uint8* in = (const Uint8*)data;
+    const Uint32 w = read_be32(in + 4), h = read_be32(in + 8);
+    const Uint8 channels = in[12];
+    if (w == 0 || h == 0 || w > 32768 || h > 32768 || (Uint64)w * h > QOI_PIXELS_MAX || (channels != 3 && channels != 4)) {
+        SDL_SetError("qoi: bad header (%ux%u, %u channels)", w, h, channels);
+        return NULL;
+    }
+    SDL_Surface* s = SDL_CreateRGBSurfaceWithFormat(0, (int)w, (int)h, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (!s) return NULL;
+    if (s->pitch != (int)w * 4) { SDL_FreeSurface(s); SDL_SetError("qoi: unexpected pitch"); return NULL; }
+
+    Rgba index[64];
+    memset(index, 0, sizeof(index));
+    Rgba px = { 0, 0, 0, 255 };
+    // кожна операція читає щонайбільше 5 байтів — з відступом у 8 байтів виходу за буфер немає
+    const size_t end = size - QOI_PADDING;
+    size_t p = QOI_HEADER;
+    Uint32* out = (Uint32*)s->pixels;               // ARGB8888: pitch == w * 4, рядки підряд
+    Uint32* const stop = out + (size_t)w * h;
+    while (out < stop) {
+        if (p >= end) { // обрізаний файл — краще PNG, ніж півкартинки
+            SDL_FreeSurface(s);
+            SDL_SetError("qoi: truncated data");
+            return NULL;
+        }
+        const Uint8 b1 = in[p++];
+        if (b1 == QOI_OP_RGB) {
+            px.r = in[p]; px.g = in[p + 1]; px.b = in[p + 2];
+            p += 3;
+        } else if (b1 == QOI_OP_RGBA) {
+            px.r = in[p]; px.g = in[p + 1]; px.b = in[p + 2]; px.a = in[p + 3];
+            p += 4;
+        } else if ((b1 & QOI_MASK_2) == QOI_OP_INDEX) {
+            px = index[b1];
+        } else if ((b1 & QOI_MASK_2) == QOI_OP_DIFF) {
+            px.r += ((b1 >> 4) & 3) - 2;
+            px.g += ((b1 >> 2) & 3) - 2;
+            px.b += (b1 & 3) - 2;
+        } else if ((b1 & QOI_MASK_2) == QOI_OP_LUMA) {
+            const Uint8 b2 = in[p++];
+            const int vg = (b1 & 0x3F) - 32;
+            px.r += vg - 8 + ((b2 >> 4) & 0x0F);
+            px.g += vg;
+            px.b += vg - 8 + (b2 & 0x0F);
+        } else { // QOI_OP_RUN: той самий піксель 1..62 рази, одним заповненням
+            index[hash(px)] = px;
+            const Uint32 v = pack(px);
+            Uint32* run_end = out + (b1 & 0x3F) + 1;
+            if (run_end > stop) run_end = stop;
+            while (out < run_end) *out++ = v;
+            continue;
+        }
+        index[hash(px)] = px;
+        *out++ = pack(px);
+    }
+    if (channels == 4) SDL_SetSurfaceBlendMode(s, SDL_BLENDMODE_BLEND);
+    return s;
+}
+
+void* qoi_encode(SDL_Surface* src, size_t* out_size) {
+    if (!src || !out_size) return NULL;
+    SDL_Surface* s = SDL_ConvertSurfaceFormat(src, SDL_PIXELFORMAT_ARGB8888, 0);
+    if (!s) return NULL;
+    const int w = s->w, h = s->h;
+
+    bool alpha = false;
+    for (int y = 0; y < h && !alpha; ++y) {
+        const Uint32* row = (const Uint32*)((const Uint8*)s->pixels + (size_t)y * s->pitch);
+        for (int x = 0; x < w && !alpha; ++x) alpha = (row[x] >> 24) != 0xFF;
+    }
+
+    // гірший випадок — RGBA на кожен піксель
+    const size_t cap = QOI_HEADER + (size_t)w * h * 5 + QOI_PADDING;
+    Uint8* out = (Uint8*)malloc(cap);
+    if (!out) { SDL_FreeSurface(s); SDL_SetError("qoi: out of memory"); return NULL; }
+    Uint8* o = out;
+    memcpy(o, "qoif", 4); o += 4;
+    o = put_be32(o, (Uint32)w);
+    o = put_be32(o, (Uint32)h);
+    *o++ = alpha ? 4 : 3;
+    *o++ = 0; // sRGB з лінійною альфою
+
+    Rgba index[64];
+    memset(index, 0, sizeof(index));
+    Rgba prev = { 0, 0, 0, 255 };
+    int run = 0;
+    for (int y = 0; y < h; ++y) {
+        const Uint32* row = (const Uint32*)((const Uint8*)s->pixels + (size_t)y * s->pitch);
+        for (int x = 0; x < w; ++x) {
+            const Uint32 v = row[x];
+            const Rgba px = { (Uint8)(v >> 16), (Uint8)(v >> 8), (Uint8)v, (Uint8)(v >> 24) };
+            if (pack(px) == pack(prev)) {
+                if (++run == 62) { *o++ = QOI_OP_RUN | (run - 1); run = 0; }
+                continue;
+            }
+            if (run) { *o++ = QOI_OP_RUN | (run - 1); run = 0; }
+
+            const int ix = hash(px);
+            if (pack(index[ix]) == pack(px)) {
+                *o++ = QOI_OP_INDEX | ix;
+            } else {
+                index[ix] = px;
+                if (px.a == prev.a) {
+                    const signed char vr = (signed char)(px.r - prev.r);
+                    const signed char vg = (signed char)(px.g - prev.g);
+                    const signed char vb = (signed char)(px.b - prev.b);
+                    const signed char vg_r = (signed char)(vr - vg), vg_b = (signed char)(vb - vg);
+                    if (vr > -3 && vr < 2 && vg > -3 && vg < 2 && vb > -3 && vb < 2) {
+                        *o++ = (Uint8)(QOI_OP_DIFF | (vr + 2) << 4 | (vg + 2) << 2 | (vb + 2));
+                    } else if (vg_r > -9 && vg_r < 8 && vg > -33 && vg < 32 && vg_b > -9 && vg_b < 8) {
+                        *o++ = (Uint8)(QOI_OP_LUMA | (vg + 32));
+                        *o++ = (Uint8)((vg_r + 8) << 4 | (vg_b + 8));
+                    } else {
+                        *o++ = QOI_OP_RGB;
+                        *o++ = px.r; *o++ = px.g; *o++ = px.b;
+                    }
+                } else {
+                    *o++ = QOI_OP_RGBA;
+                    *o++ = px.r; *o++ = px.g; *o++ = px.b; *o++ = px.a;
+                }
+            }
+            prev = px;
+        }
+    }
+    if (run) *o++ = QOI_OP_RUN | (run - 1);
+    static const Uint8 padding[QOI_PADDING] = { 0, 0, 0, 0, 0, 0, 0, 1 };
+    memcpy(o, padding, sizeof(padding)); o += sizeof(padding);
+
+    SDL_FreeSurface(s);
+    *out_size = (size_t)(o - out);
+    return out;
+}
@@ -0,0 +1,20 @@
+#ifndef HYDRANGEA_QOI_H
+#define HYDRANGEA_QOI_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// QOI (qoiformat.org) — безвтратний формат, що декодується за один лінійний прохід
+// без Huffman/zlib: фони в ньому вантажаться в рази швидше за PNG.
+// Без зовнішніх залежностей; декодер одразу дає ARGB8888 — як imgcache і текстури.
+
+bool qoi_is(const void* data, size_t size);
+
+// NULL — пошкоджені дані або бракує пам'яті (причина — в SDL_GetError)
+SDL_Surface* qoi_decode(const void* data, size_t size);
+
+// будь-який формат surface; повертає буфер для free() або NULL
+void* qoi_encode(SDL_Surface* s, size_t* out_size);
+
+#endif /* HYDRANGEA_QOI_H */
@@ -0,0 +1,226 @@
+#include "replay.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RPL_VERSION 1u
+
+// теги записів
+enum {
+    R_END = 0, R_FRAME, R_QUIT, R_KEYDOWN, R_KEYUP, R_MOTION, R_BDOWN, R_BUP, R_WINDOW, R_WHEEL
+};
+
+typedef struct {
+    char   magic[4];   // "HRPL"
+    Uint32 version;
+    Uint64 seed;
+} RplHeader;
+
+struct Replay {
+    bool   writing;
+    FILE*  f;                 // запис
+    Uint64 t0, last_us;       // запис: лічильник на старті, час попереднього запису (мкс)
+    Uint8* buf; size_t size, pos;  // відтворення: увесь файл у пам'яті
+    Uint64 play_us;           // відтворення: накопичений час подій
+    // підсумок
+    Uint32 frames, events;
+    double total_dt, worst_dt;
+    Uint32 worst_frame;
+};
+
+// ---- varint (LEB128) + zigzag для знакових ----
+static void put_u(Replay* rp, Uint64 v) {
+    Uint8 b[10]; int n = 0;
+    do { Uint8 c = v & 0x7F; v >>= 7; b[n++] = c | (v ? 0x80 : 0); } while (v);
+    fwrite(b, 1, (size_t)n, rp->f);
+}
+static void put_s(Replay* rp, Sint64 v) { put_u(rp, ((Uint64)v << 1) ^ (Uint64)(v >> 63)); }
+static void put_b(Replay* rp, Uint8 v)  { fputc(v, rp->f); }
+
+static bool get_u(Replay* rp, Uint64* out) {
+    Uint64 v = 0;
+    for (int sh = 0; sh < 64 && rp->pos < rp->size; sh += 7) {
+        Uint8 c = rp->buf[rp->pos++];
+        v |= (Uint64)(c & 0x7F) << sh;
+        if (!(c & 0x80)) { *out = v; return true; }
+    }
+    return false;
+}
+static bool get_s(Replay* rp, Sint32* out) {
+    Uint64 u; if (!get_u(rp, &u)) return false;
+    *out = (Sint32)(Sint64)((u >> 1) ^ (~(u & 1) + 1));
+    return true;
+}
+static bool get_b(Replay* rp, Uint8* out) {
+    if (rp->pos >= rp->size) return false;
+    *out = rp->buf[rp->pos++];
+    return true;
+}
+
+static Uint64 now_us(const Replay* rp) {
+    return (SDL_GetPerformanceCounter() - rp->t0) * 1000000ull / SDL_GetPerformanceFrequency();
+}
+
+Replay* replay_record_open(const char* path, Uint64 seed) {
+    Replay* rp = (Replay*)calloc(1, sizeof(Replay));
+    if (!rp) return NULL;
+    rp->f = fopen(path, "wb");
+    if (!rp->f) { SDL_Log("replay: can't create %s", path); free(rp); return NULL; }
+    rp->writing = true;
+    RplHeader h; memset(&h, 0, sizeof(h));
+    memcpy(h.magic, "HRPL", 4); h.version = RPL_VERSION; h.seed = seed;
+    fwrite(&h, sizeof(h), 1, rp->f);
+    rp->t0 = SDL_GetPerformanceCounter();
+    SDL_Log("replay: recording to %s (seed %llu)", path, (unsigned long long)seed);
+    return rp;
+}
+
+void replay_record_event(Replay* rp, const SDL_Event* e) {
+    if (!rp || !rp->writing) return;
+    Uint8 tag;
+    switch (e->type) {
+        case SDL_QUIT:            tag = R_QUIT; break;
+        case SDL_KEYDOWN:         tag = R_KEYDOWN; break;
+        case SDL_KEYUP:           tag = R_KEYUP; break;
+        case SDL_MOUSEMOTION:     tag = R_MOTION; break;
+        case SDL_MOUSEBUTTONDOWN: tag = R_BDOWN; break;
+        case SDL_MOUSEBUTTONUP:   tag = R_BUP; break;
+        case SDL_WINDOWEVENT:     tag = R_WINDOW; break;
+        case SDL_MOUSEWHEEL:      tag = R_WHEEL; break;
+        default: return;
+    }
+    Uint64 t = now_us(rp);
+    put_b(rp, tag);
+    put_u(rp, t - rp->last_us);
+    rp->last_us = t;
+    switch (tag) {
+        case R_KEYDOWN: case R_KEYUP:
+            put_u(rp, (Uint32)e->key.keysym.sym);
+            put_u(rp, (Uint32)e->key.keysym.scancode);
+            put_u(rp, e->key.keysym.mod);
+            put_b(rp, e->key.repeat);
+            break;
+        case R_MOTION:
+            put_s(rp, e->motion.x);    put_s(rp, e->motion.y);
+            put_s(rp, e->motion.xrel); put_s(rp, e->motion.yrel);
+            put_u(rp, e->motion.state);
+            break;
+        case R_BDOWN: case R_BUP:
+            put_b(rp, e->button.button); put_b(rp, e->button.clicks);
+            put_s(rp, e->button.x);      put_s(rp, e->button.y);
+            break;
+        case R_WINDOW:
+            put_b(rp, e->window.event);
+            put_s(rp, e->window.data1); put_s(rp, e->window.data2);
+            break;
+        case R_WHEEL:
+            put_s(rp, e->wheel.x); put_s(rp, e->wheel.y); put_u(rp, e->wheel.direction);
+            break;
+        default: break;
+    }
+    rp->events++;
+}
+
+void replay_record_frame(Replay* rp, float dt) {
+    if (!rp || !rp->writing) return;
+    Uint32 bits; memcpy(&bits, &dt, 4);   // точне значення, без округлення
+    put_b(rp, R_FRAME);
+    fwrite(&bits, 4, 1, rp->f);
+    rp->frames++;
+    rp->total_dt += dt;
+}
+
+Replay* replay_play_open(const char* path, Uint64* seed) {
+    size_t size = 0;
+    Uint8* buf = (Uint8*)SDL_LoadFile(path, &size);
+    if (!buf) { SDL_Log("replay: can't read %s: %s", path, SDL_GetError()); return NULL; }
+    RplHeader h;
+    if (size < sizeof(h)) { SDL_free(buf); SDL_Log("replay: %s is truncated", path); return NULL; }
+    memcpy(&h, buf, sizeof(h));
+    if (memcmp(h.magic, "HRPL", 4) != 0 || h.version != RPL_VERSION) {
+        SDL_free(buf); SDL_Log("replay: %s is not a replay v%u", path, RPL_VERSION); return NULL;
+    }
+    Replay* rp = (Replay*)calloc(1, sizeof(Replay));
+    if (!rp) { SDL_free(buf); return NULL; }
+    rp->buf = buf; rp->size = size; rp->pos = sizeof(h);
+    *seed = h.seed;
+    SDL_Log("replay: playing %s (seed %llu)", path, (unsigned long long)h.seed);
+    return rp;
+}
+
+int replay_play_next(Replay* rp, SDL_Event* e, float* dt) {
+    Uint8 tag;
+    if (!rp || rp->writing || !get_b(rp, &tag) || tag == R_END) return REPLAY_END;
+
+    if (tag == R_FRAME) {
+        Uint32 bits;
+        if (rp->pos + 4 > rp->size) return REPLAY_END;
+        memcpy(&bits, rp->buf + rp->pos, 4); rp->pos += 4;
+        memcpy(dt, &bits, 4);
+        if (*dt > rp->worst_dt) { rp->worst_dt = *dt; rp->worst_frame = rp->frames; }
+        rp->frames++;
+        rp->total_dt += *dt;
+        return REPLAY_FRAME;
+    }
+
+    Uint64 dus; Uint64 u = 0; Uint8 b1 = 0, b2 = 0; Sint32 s1 = 0, s2 = 0, s3 = 0, s4 = 0;
+    if (!get_u(rp, &dus)) return REPLAY_END;
+    rp->play_us += dus;
+    memset(e, 0, sizeof(*e));
+    e->common.timestamp = (Uint32)(rp->play_us / 1000);
+    bool ok = true;
+    switch (tag) {
+        case R_QUIT: e->type = SDL_QUIT; break;
+        case R_KEYDOWN: case R_KEYUP: {
+            Uint64 sym = 0, sc = 0;
+            ok = get_u(rp, &sym) && get_u(rp, &sc) && get_u(rp, &u) && get_b(rp, &b1);
+            e->type = (tag == R_KEYDOWN) ? SDL_KEYDOWN : SDL_KEYUP;
+            e->key.state = (tag == R_KEYDOWN) ? SDL_PRESSED : SDL_RELEASED;
+            e->key.keysym.sym = (SDL_Keycode)sym;
+            e->key.keysym.scancode = (SDL_Scancode)sc;
+            e->key.keysym.mod = (Uint16)u;
+            e->key.repeat = b1;
+        } break;
+        case R_MOTION:
+            ok = get_s(rp, &s1) && get_s(rp, &s2) && get_s(rp, &s3) && get_s(rp, &s4) && get_u(rp, &u);
+            e->type = SDL_MOUSEMOTION;
+            e->motion.x = s1; e->motion.y = s2; e->motion.xrel = s3; e->motion.yrel = s4;
+            e->motion.state = (Uint32)u;
+            break;
+        case R_BDOWN: case R_BUP:
+            ok = get_b(rp, &b1) && get_b(rp, &b2) && get_s(rp, &s1) && get_s(rp, &s2);
+            e->type = (tag == R_BDOWN) ? SDL_MOUSEBUTTONDOWN : SDL_MOUSEBUTTONUP;
+            e->button.state = (tag == R_BDOWN) ? SDL_PRESSED : SDL_RELEASED;
+            e->button.button = b1; e->button.clicks = b2;
+            e->button.x = s1; e->button.y = s2;
+            break;
+        case R_WINDOW:
+            ok = get_b(rp, &b1) && get_s(rp, &s1) && get_s(rp, &s2);
+            e->type = SDL_WINDOWEVENT;
+            e->window.event = b1; e->window.data1 = s1; e->window.data2 = s2;
+            break;
+        case R_WHEEL:
+            ok = get_s(rp, &s1) && get_s(rp, &s2) && get_u(rp, &u);
+            e->type = SDL_MOUSEWHEEL;
+            e->wheel.x = s1; e->wheel.y = s2; e->wheel.direction = (Uint32)u;
+            break;
+        default: ok = false; break;
+    }
+    if (!ok) { SDL_Log("replay: corrupt record at byte %zu", rp->pos); return REPLAY_END; }
+    rp->events++;
+    return REPLAY_EVENT;
+}
+
+void replay_close(Replay* rp) {
+    if (!rp) return;
+    if (rp->writing) {
+        put_b(rp, R_END);
+        if (fclose(rp->f) != 0) SDL_Log("replay: write failed");
+        SDL_Log("replay: recorded %u frames, %u events, %.2f s", rp->frames, rp->events, rp->total_dt);
+    } else {
+        SDL_Log("replay: played %u frames, %u events, %.2f s of game time; worst frame #%u = %.2f ms",
+                rp->frames, rp->events, rp->total_dt, rp->worst_frame, rp->worst_dt * 1000.0);
+        SDL_free(rp->buf);
+    }
+    free(rp);
+}
@@ -0,0 +1,26 @@
+#ifndef HYDRANGEA_REPLAY_H
+#define HYDRANGEA_REPLAY_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+// Запис і відтворення сесії: кожна подія, що пішла в game_handle_event, dt кожного кадру
+// (точні біти float) і seed ігрового Rng. Формат компактний: тег + varint-поля.
+// Відтворення детерміноване за умови тих самих config.json і контенту.
+
+typedef struct Replay Replay;
+
+enum { REPLAY_END = 0, REPLAY_EVENT = 1, REPLAY_FRAME = 2 };
+
+Replay* replay_record_open(const char* path, Uint64 seed);
+void    replay_record_event(Replay* rp, const SDL_Event* e);   // непотрібні грі типи пропускаються
+void    replay_record_frame(Replay* rp, float dt);
+
+Replay* replay_play_open(const char* path, Uint64* seed);
+// REPLAY_EVENT -> *e заповнено; REPLAY_FRAME -> *dt кадру (події кадру вже видані); REPLAY_END
+int     replay_play_next(Replay* rp, SDL_Event* e, float* dt);
+
+// закриває файл; для запису — дописує кінець, для відтворення — друкує підсумок
+void    replay_close(Replay* rp);
+
+#endif /* HYDRANGEA_REPLAY_H */
@@ -0,0 +1,259 @@
+#include "residency.h"
+#include "texcache.h"
+#include "assets.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define RES_MAX_SCENES  256   // стеля сусідства (великий hops на густому графі)
+#define RES_MAX_BG      32
+#define RES_MUSIC_SLOTS 4
+
+typedef enum { MUS_EMPTY, MUS_QUEUED, MUS_LOADING, MUS_READY, MUS_FAILED } MusState;
+
+typedef struct {
+    char     path[128];
+    MusState state;
+    Uint32   gen;       // +1 при кожній зміні слота: застарілий результат потоку відкидаємо
+    void*    data;
+    size_t   size;
+} MusicSlot;
+
+typedef struct {
+    char keys[RES_MAX_BG][256];   // ключі texcache
+    int  n;
+    char keep[256];
+} BgKeep;
+
+static int  g_hops = 2;
+static bool g_by_visits = true;
+
+static Uint32* g_seen = NULL;     // g_seen[i] == g_stamp — сцена i вже в плані
+static int     g_seen_n = 0;
+static Uint32  g_stamp = 0;
+static int     g_plan[RES_MAX_SCENES];
+static int     g_plan_n = 0;
+static BgKeep  g_bg;
+
+static MusicSlot   g_mus[RES_MUSIC_SLOTS];
+static SDL_Thread* g_worker = NULL;
+static SDL_mutex*  g_mx = NULL;
+static SDL_cond*   g_cv = NULL;
+static bool        g_quit = false;
+
+void residency_configure(int hops, bool by_visits) {
+    g_hops = SDL_clamp(hops, 0, 8);
+    g_by_visits = by_visits;
+}
+
+// ---------- план: сцени в межах g_hops ----------
+
+static void visit(const Scene* arr, int count, int to) {
+    if (to < 0 || to >= count || !arr[to].id || g_seen[to] == g_stamp || g_plan_n >= RES_MAX_SCENES) return;
+    g_seen[to] = g_stamp;
+    g_plan[g_plan_n++] = to;
+}
+
+// частіше відвідувані — раніше (стабільно: за рівних лишається порядок обходу)
+static void sort_layer(int from, int to, const int* visits) {
+    for (int i = from + 1; i < to; ++i) {
+        int v = g_plan[i], j = i;
+        while (j > from && visits[g_plan[j - 1]] < visits[v]) { g_plan[j] = g_plan[j - 1]; --j; }
+        g_plan[j] = v;
+    }
+}
+
+// обхід у ширину: план упорядкований за відстанню від cur
+static void make_plan(const Scene* arr, int count, int cur, const int* visits) {
+    g_plan_n = 0;
+    if (cur < 0 || cur >= count || !arr[cur].id) return;
+    if (g_seen_n != count) {
+        Uint32* seen = (Uint32*)realloc(g_seen, (size_t)count * sizeof(Uint32));
+        if (!seen) { SDL_Log("residency: out of memory for %d scenes", count); g_plan[g_plan_n++] = cur; return; }
+        memset(seen, 0, (size_t)count * sizeof(Uint32));
+        g_seen = seen; g_seen_n = count; g_stamp = 0;
+    }
+    if (++g_stamp == 0) { memset(g_seen, 0, (size_t)count * sizeof(Uint32)); g_stamp = 1; }
+
+    visit(arr, count, cur);
+    int layer = 0;
+    for (int d = 0; d < g_hops && layer < g_plan_n; ++d) {
+        int end = g_plan_n;
+        for (int i = layer; i < end; ++i) {
+            const Scene* s = &arr[g_plan[i]];
+            for (int c = 0; c < s->num_choices; ++c) visit(arr, count, s->choices[c].next);
+            visit(arr, count, s->auto_next);
+            for (int k = 0; k < s->checks_count; ++k) visit(arr, count, s->checks[k].goto_index);
+        }
+        if (g_by_visits && visits) sort_layer(end, g_plan_n, visits);
+        layer = end;
+    }
+}
+
+// ---------- фони ----------
+
+static bool bg_keep(const char* key, void* user) {
+    const BgKeep* k = (const BgKeep*)user;
+    if (k->keep[0] && SDL_strcasecmp(key, k->keep) == 0) return true;
+    for (int i = 0; i < k->n; ++i) if (SDL_strcasecmp(key, k->keys[i]) == 0) return true;
+    return false;
+}
+
+// для texcache: ближчі в плані — менший ранг; фон меню — після плану; решта — першими на вихід
+static int bg_rank(const char* key, void* user) {
+    const BgKeep* k = (const BgKeep*)user;
+    for (int i = 0; i < k->n; ++i) if (SDL_strcasecmp(key, k->keys[i]) == 0) return i;
+    if (k->keep[0] && SDL_strcasecmp(key, k->keep) == 0) return k->n;
+    return RES_MAX_BG + 1;
+}
+
+static void focus_backgrounds(const Scene* arr, const char* keep_bg, SDL_Texture* pinned) {
+    BgKeep* k = &g_bg;
+    k->n = 0;
+    k->keep[0] = '\0';
+    if (keep_bg && *keep_bg) texcache_key(keep_bg, k->keep, sizeof(k->keep));
+    int budget = SDL_min(texcache_capacity() - 1, RES_MAX_BG); // одне місце — фону меню
+    for (int i = 0; i < g_plan_n && k->n < budget; ++i) {
+        const char* bg = arr[g_plan[i]].background;
+        if (!bg) continue;
+        char key[256];
+        texcache_key(bg, key, sizeof(key));
+        if (bg_keep(key, k)) continue;
+        SDL_snprintf(k->keys[k->n++], sizeof(k->keys[0]), "%s", key);
+    }
+    texcache_evict_if(bg_keep, k, pinned); // спершу звільняємо місце, потім замовляємо ближчі
+    for (int i = 0; i < k->n; ++i)
+        if (!texcache_prefetch(k->keys[i])) break;
+}
+
+// ---------- музика ----------
+
+static int music_worker(void* ud) {
+    (void)ud;
+    SDL_LockMutex(g_mx);
+    for (;;) {
+        MusicSlot* s = NULL;
+        while (!g_quit) {
+            for (int i = 0; i < RES_MUSIC_SLOTS && !s; ++i) if (g_mus[i].state == MUS_QUEUED) s = &g_mus[i];
+            if (s) break;
+            SDL_CondWait(g_cv, g_mx);
+        }
+        if (g_quit) break;
+        char path[128];
+        SDL_snprintf(path, sizeof(path), "%s", s->path);
+        Uint32 gen = s->gen;
+        s->state = MUS_LOADING;
+        SDL_UnlockMutex(g_mx);
+
+        size_t size = 0;
+        void* data = asset_load(path, &size);
+
+        SDL_LockMutex(g_mx);
+        if (s->gen != gen) { free(data); continue; } // поки вантажили, слот звільнили
+        if (!data) SDL_Log("residency: can't load music %s", path);
+        s->data = data; s->size = size;
+        s->state = data ? MUS_READY : MUS_FAILED;   // FAILED не перезамовляємо, поки сцена поруч
+    }
+    SDL_UnlockMutex(g_mx);
+    return 0;
+}
+
+static void slot_clear(MusicSlot* s) {
+    free(s->data);
+    s->data = NULL; s->size = 0;
+    s->state = MUS_EMPTY;
+    s->path[0] = '\0';
+    s->gen++;
+}
+
+static void focus_music(const Scene* arr, const char* keep_music) {
+    const char* want[RES_MUSIC_SLOTS];
+    int n = 0;
+    for (int i = 0; i < g_plan_n && n < RES_MUSIC_SLOTS; ++i) {
+        const char* m = arr[g_plan[i]].music;
+        if (!m || !*m) continue;
+        bool dup = false;
+        for (int k = 0; k < n && !dup; ++k) dup = SDL_strcasecmp(want[k], m) == 0;
+        if (!dup) want[n++] = m;
+    }
+
+    SDL_LockMutex(g_mx);
+    for (int i = 0; i < RES_MUSIC_SLOTS; ++i) {
+        MusicSlot* s = &g_mus[i];
+        if (s->state == MUS_EMPTY) continue;
+        // музика, що грає, читає з цього буфера
+        bool keep = keep_music && SDL_strcasecmp(s->path, keep_music) == 0;
+        for (int k = 0; k < n && !keep; ++k) keep = SDL_strcasecmp(s->path, want[k]) == 0;
+        if (!keep) slot_clear(s);
+    }
+    bool queued = false;
+    for (int k = 0; k < n; ++k) {
+        MusicSlot* free_slot = NULL;
+        bool have = false;
+        for (int i = 0; i < RES_MUSIC_SLOTS && !have; ++i) {
+            if (g_mus[i].state == MUS_EMPTY) { if (!free_slot) free_slot = &g_mus[i]; }
+            else have = SDL_strcasecmp(g_mus[i].path, want[k]) == 0;
+        }
+        if (have) continue;
+        if (!free_slot) break;
+        SDL_snprintf(free_slot->path, sizeof(free_slot->path), "%s", want[k]);
+        free_slot->state = MUS_QUEUED;
+        free_slot->gen++;
+        queued = true;
+    }
+    if (queued) SDL_CondSignal(g_cv);
+    SDL_UnlockMutex(g_mx);
+}
+
+SDL_RWops* residency_music_open(const char* rel) {
+    if (!rel || !*rel) return NULL;
+    if (g_mx) {
+        SDL_RWops* rw = NULL;
+        SDL_LockMutex(g_mx);
+        for (int i = 0; i < RES_MUSIC_SLOTS && !rw; ++i) {
+            const MusicSlot* s = &g_mus[i];
+            if (s->state == MUS_READY && SDL_strcasecmp(s->path, rel) == 0)
+                rw = SDL_RWFromConstMem(s->data, (int)s->size);
+        }
+        SDL_UnlockMutex(g_mx);
+        if (rw) return rw;
+    }
+    return asset_open(rel);
+}
+
+// ---------- разом ----------
+
+void residency_focus(const Scene* arr, int count, int cur, const int* visits,
+                     const char* keep_bg, const char* keep_music, SDL_Texture* pinned) {
+    make_plan(arr, count, cur, visits);
+    focus_backgrounds(arr, keep_bg, pinned);
+    if (g_worker) focus_music(arr, keep_music);
+}
+
+bool residency_init(void) {
+    texcache_set_rank(bg_rank, &g_bg);
+    g_quit = false;
+    g_mx = SDL_CreateMutex();
+    g_cv = SDL_CreateCond();
+    if (g_mx && g_cv) g_worker = SDL_CreateThread(music_worker, "residency", NULL);
+    if (!g_worker) SDL_Log("residency: no loader thread, music streams from disk: %s", SDL_GetError());
+    return g_worker != NULL;
+}
+
+void residency_shutdown(void) {
+    texcache_set_rank(NULL, NULL);
+    if (g_worker) {
+        SDL_LockMutex(g_mx);
+        g_quit = true;
+        SDL_CondSignal(g_cv);
+        SDL_UnlockMutex(g_mx);
+        SDL_WaitThread(g_worker, NULL);
+        g_worker = NULL;
+    }
+    for (int i = 0; i < RES_MUSIC_SLOTS; ++i) slot_clear(&g_mus[i]);
+    if (g_cv) { SDL_DestroyCond(g_cv); g_cv = NULL; }
+    if (g_mx) { SDL_DestroyMutex(g_mx); g_mx = NULL; }
+
+    free(g_seen);
+    g_seen = NULL; g_seen_n = 0; g_stamp = 0;
+    g_plan_n = 0;
+}
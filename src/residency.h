@@ -0,0 +1,26 @@
+#ifndef HYDRANGEA_RESIDENCY_H
+#define HYDRANGEA_RESIDENCY_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include "scenes.h"
+
+// Які ассети тримати в пам'яті: фони й музику сцен, до яких від поточної не більше
+// hops переходів (вибори, auto_next, checks.goto). Ближчі замовляються першими,
+// у межах одного кроку — частіше відвідувані; усе далі вивантажується.
+// Фони живуть у texcache, музика — тут (байти файлу, Mix_Music читає з пам'яті).
+
+void residency_configure(int hops, bool by_visits);
+bool residency_init(void);       // потік підвантаження музики
+void residency_shutdown(void);   // після Mix_FreeMusic: буфери звільняються
+
+// головний потік: поточна сцена змінилась або сюжет перезібрано.
+// visits — лічильники відвідувань (може бути NULL); keep_bg / keep_music (фон меню,
+// музика, що грає зараз) і pinned не вивантажуються.
+void residency_focus(const Scene* arr, int count, int cur, const int* visits,
+                     const char* keep_bg, const char* keep_music, SDL_Texture* pinned);
+
+// музика з пам'яті, якщо вже підвантажена; інакше — asset_open
+SDL_RWops* residency_music_open(const char* rel);
+
+#endif /* HYDRANGEA_RESIDENCY_H */
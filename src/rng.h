@@ -0,0 +1,28 @@
+#ifndef HYDRANGEA_RNG_H
+#define HYDRANGEA_RNG_H
+
+#include <SDL2/SDL.h>
+
+// Детермінований генератор гри (splitmix64): однаковий seed -> однакова послідовність.
+// Усе «випадкове» у грі (ефекти тощо) бере числа звідси, а не з rand().
+
+typedef struct { Uint64 s; } Rng;
+
+static inline void rng_seed(Rng* r, Uint64 seed) { r->s = seed; }
+
+static inline Uint32 rng_next(Rng* r) {
+    Uint64 z = (r->s += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return (Uint32)((z ^ (z >> 31)) >> 32);
+}
+
+// [0, 1)
+static inline float rng_float(Rng* r) { return (rng_next(r) >> 8) * (1.f / 16777216.f); }
+
+// [lo, hi]
+static inline int rng_range(Rng* r, int lo, int hi) {
+    return hi <= lo ? lo : lo + (int)(rng_next(r) % (Uint32)(hi - lo + 1));
+}
+
+#endif /* HYDRANGEA_RNG_H */
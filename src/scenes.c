@@ -0,0 +1,571 @@
+#include "scenes.h"
+#include "jsonr.h"
+#include "assets.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define SCENE_MAX_STRS 64   // 7 полів + 4 вибори × 10 + 4 перевірки × 4
+#define SCENES_MAX_THREADS 8
+#define SCENES_PAR_BYTES (256 * 1024)   // авто: не менше стількох байтів сцен на потік
+
+static int g_threads = 0; // 0 — авто
+
+static inline float clampf(float v, float lo, float hi) {
+    return (v < lo) ? lo : (v > hi) ? hi : v;
+}
+
+// ---------- каталог рядків ----------
+
+bool lang_load(Lang* out, const char* path) {
+    memset(out, 0, sizeof(*out));
+    size_t n = 0;
+    char* buf = (char*)asset_load(path, &n);
+    if (!buf) return false;
+
+    JsonReader r;
+    jr_init(&r, buf, n);
+    int cap = 0;
+    char* key;
+    jr_obj_begin(&r);
+    while (jr_obj_key(&r, &key)) {
+        char* val = jr_str(&r);
+        if (!val) continue; // не рядок — пропущено
+        if (out->count == cap) {
+            cap = cap ? cap * 2 : 64;
+            StringKV* grown = (StringKV*)realloc(out->kv, (size_t)cap * sizeof(StringKV));
+            if (!grown) { SDL_Log("lang_load: out of memory"); break; }
+            out->kv = grown;
+        }
+        // повтор ключа: як і раніше, перемагає перший
+        if (strindex_put(&out->ix, key, out->count) != out->count) continue;
+        out->kv[out->count].key = key;
+        out->kv[out->count].val = val;
+        out->count++;
+    }
+    if (!jr_ok(&r)) {
+        jr_log_error(&r, path);
+        free(out->kv); free(buf); strindex_free(&out->ix);
+        memset(out, 0, sizeof(*out));
+        return false;
+    }
+    out->buf = buf;
+    return true;
+}
+
+const char* lang_get(const Lang* lang, const char* key) {
+    if (!lang || !key) return NULL;
+    int i = strindex_get(&lang->ix, key);
+    return i >= 0 ? lang->kv[i].val : NULL;
+}
+
+void lang_free(Lang* lang) {
+    if (!lang) return;
+    free(lang->kv);
+    free(lang->buf);
+    strindex_free(&lang->ix);
+    memset(lang, 0, sizeof(*lang));
+}
+
+// ---------- сцени ----------
+
+bool scenes_index(StrIndex* ix, const Scene* arr, int count) {
+    strindex_clear(ix);
+    if (!strindex_reserve(ix, count)) return false;
+    for (int i = 0; i < count; ++i)
+        if (arr[i].id) strindex_put(ix, arr[i].id, i);
+    return true;
+}
+
+static Uint32 fnv1a(Uint32 h, const void* data, size_t n) {
+    const unsigned char* p = (const unsigned char*)data;
+    for (size_t i = 0; i < n; ++i) { h ^= p[i]; h *= 16777619u; }
+    return h;
+}
+
+// Підтягнути локалізований рядок: "str:key" -> з lang (або сам ключ), інакше як є.
+static char* resolve_str(const Lang* lang, char* v) {
+    if (!v || strncmp(v, "str:", 4) != 0) return v;
+    const char* loc = lang_get(lang, v + 4);
+    return loc ? (char*)loc : v + 4; // копію зробить scene_pack
+}
+
+static void parse_cmp(const char* s, int* op, int* val) {
+    *op = -1; *val = 0;
+    if (!s) return;
+    if (s[0]=='<' && s[1]=='=') { *op=1; *val=SDL_atoi(s+2); return; }
+    if (s[0]=='>' && s[1]=='=') { *op=3; *val=SDL_atoi(s+2); return; }
+    if (s[0]=='<')             { *op=0; *val=SDL_atoi(s+1); return; }
+    if (s[0]=='>')             { *op=4; *val=SDL_atoi(s+1); return; }
+    if (s[0]=='=' )            { *op=2; *val=SDL_atoi(s+1); return; }
+    /* без оператора трактуємо як >= */
+    *op = 3; *val = SDL_atoi(s);
+}
+
+// число 0..1; інше — поле лишається незаданим
+static void parse_unit(JsonReader* r, float* dst) {
+    if (jr_peek(r) == JR_NUM) *dst = clampf((float)jr_num(r, 0.0), 0.f, 1.f);
+    else jr_skip(r);
+}
+
+// "vfx": { "grain": 0.3, "vignette": 0.5, "flash": true, "glitch": 0.2, "shake": [ms, сила], "red_overlay": 0.1 }
+static void parse_vfx(JsonReader* r, VfxParams* V) {
+    vfx_params_clear(V);
+    if (jr_peek(r) != JR_OBJ) { jr_skip(r); return; }
+    jr_obj_begin(r);
+    char* k;
+    while (jr_obj_key(r, &k)) {
+        switch (k[0]) {
+            case 'g':
+                if (!strcmp(k, "grain"))  { parse_unit(r, &V->grain);  continue; }
+                if (!strcmp(k, "glitch")) { parse_unit(r, &V->glitch); continue; }
+                break;
+            case 'v':
+                if (!strcmp(k, "vignette")) { parse_unit(r, &V->vignette); continue; }
+                break;
+            case 'r':
+                if (!strcmp(k, "red_overlay")) { parse_unit(r, &V->red_overlay); continue; }
+                break;
+            case 'f':
+                if (!strcmp(k, "flash")) { V->flash = jr_bool(r, false); continue; }
+                break;
+            case 's':
+                if (!strcmp(k, "shake") && jr_peek(r) == JR_ARR) {
+                    // рівно два числа: [мс, сила]
+                    double v[2] = {0, 0};
+                    int n = 0, nums = 0;
+                    jr_arr_begin(r);
+                    while (jr_arr_next(r)) {
+                        if (n < 2 && jr_peek(r) == JR_NUM) { v[n] = jr_num(r, 0.0); nums++; }
+                        else jr_skip(r);
+                        n++;
+                    }
+                    if (n == 2 && nums == 2) {
+                        V->shake_ms  = clampf((float)v[0], 0.f, 5000.f);
+                        V->shake_amp = clampf((float)v[1], 0.f, 10.f);
+                    }
+                    continue;
+                }
+                break;
+        }
+        jr_skip(r);
+    }
+}
+
+// масив рядків -> dst[0..max), решту пропускаємо
+static int parse_str_list(JsonReader* r, char** dst, int max) {
+    int n = 0;
+    if (jr_peek(r) != JR_ARR) { jr_skip(r); return 0; }
+    jr_arr_begin(r);
+    while (jr_arr_next(r)) {
+        char* s = jr_str(r);
+        if (s && n < max) dst[n++] = s;
+    }
+    return n;
+}
+
+static void parse_check_if(JsonReader* r, SceneCheck* C) {
+    jr_obj_begin(r);
+    char* k;
+    while (jr_obj_key(r, &k)) {
+        switch (k[0]) {
+            case 'c': if (!strcmp(k, "clarity")) { parse_cmp(jr_str(r), &C->op_cl,  &C->val_cl);  continue; } break;
+            case 'a': if (!strcmp(k, "anxiety")) { parse_cmp(jr_str(r), &C->op_anx, &C->val_anx); continue; } break;
+            case 'b': if (!strcmp(k, "balance")) { parse_cmp(jr_str(r), &C->op_bal, &C->val_bal); continue; } break;
+            case 'f':
+                if (!strcmp(k, "flag"))  { C->flag  = jr_str(r); continue; }
+                if (!strcmp(k, "flag2")) { C->flag2 = jr_str(r); continue; }
+                break;
+            case 'n': if (!strcmp(k, "not_flag")) { C->not_flag = jr_str(r); continue; } break;
+        }
+        jr_skip(r);
+    }
+}
+
+// "checks": [{ "if": {...}, "goto": "id" }] — до 4; без "if"-об'єкта чи "goto" перевірку відкидаємо
+static void parse_checks(JsonReader* r, Scene* S) {
+    if (jr_peek(r) != JR_ARR) { jr_skip(r); return; }
+    jr_arr_begin(r);
+    while (jr_arr_next(r)) {
+        if (S->checks_count >= 4 || jr_peek(r) != JR_OBJ) { jr_skip(r); continue; }
+        SceneCheck C;
+        memset(&C, 0, sizeof(C));
+        C.op_cl = C.op_anx = C.op_bal = -1;
+        C.goto_index = -1;
+        bool has_if = false;
+        jr_obj_begin(r);
+        char* k;
+        while (jr_obj_key(r, &k)) {
+            if (!strcmp(k, "if") && jr_peek(r) == JR_OBJ) { parse_check_if(r, &C); has_if = true; }
+            else if (!strcmp(k, "goto")) C.goto_id = jr_str(r);
+            else jr_skip(r);
+        }
+        if (has_if && C.goto_id) S->checks[S->checks_count++] = C;
+    }
+}
+
+static void parse_effects(JsonReader* r, SceneChoice* C) {
+    if (jr_peek(r) != JR_OBJ) { jr_skip(r); return; }
+    jr_obj_begin(r);
+    char* k;
+    while (jr_obj_key(r, &k)) {
+        if      (!strcmp(k, "clarity")) C->d_clarity = (int)jr_num(r, C->d_clarity);
+        else if (!strcmp(k, "anxiety")) C->d_anxiety = (int)jr_num(r, C->d_anxiety);
+        else if (!strcmp(k, "balance")) C->d_balance = (int)jr_num(r, C->d_balance);
+        else jr_skip(r);
+    }
+}
+
+static void parse_choice(JsonReader* r, const Lang* lang, SceneChoice* C) {
+    memset(C, 0, sizeof(*C));
+    C->next = -1;
+    vfx_params_clear(&C->vfx_on_pick);
+    if (jr_peek(r) != JR_OBJ) { jr_skip(r); return; } // порожня кнопка, як і раніше
+    jr_obj_begin(r);
+    char* k;
+    while (jr_obj_key(r, &k)) {
+        switch (k[0]) {
+            case 't': if (!strcmp(k, "text"))        { C->text = resolve_str(lang, jr_str(r)); continue; } break;
+            case 'e': if (!strcmp(k, "effects"))     { parse_effects(r, C); continue; } break;
+            case 'n': if (!strcmp(k, "next"))        { C->next_id = jr_str(r); continue; } break;
+            case 'v': if (!strcmp(k, "vfx_on_pick")) { parse_vfx(r, &C->vfx_on_pick); continue; } break;
+            case 'f':
+                if (!strcmp(k, "flags+")) { C->add_flags_n = parse_str_list(r, C->add_flags, 4); continue; }
+                if (!strcmp(k, "flags-")) { C->rem_flags_n = parse_str_list(r, C->rem_flags, 4); continue; }
+                break;
+        }
+        jr_skip(r);
+    }
+}
+
+static void parse_choices(JsonReader* r, const Lang* lang, Scene* S) {
+    if (jr_peek(r) != JR_ARR) { jr_skip(r); return; }
+    jr_arr_begin(r);
+    while (jr_arr_next(r)) {
+        if (S->num_choices >= 4) { jr_skip(r); continue; }
+        parse_choice(r, lang, &S->choices[S->num_choices++]);
+    }
+}
+
+// адреси всіх рядкових полів сцени
+static int scene_str_slots(Scene* S, char** slots[SCENE_MAX_STRS]) {
+    int n = 0;
+    slots[n++] = &S->id;    slots[n++] = &S->speaker; slots[n++] = &S->text;
+    slots[n++] = &S->background; slots[n++] = &S->music; slots[n++] = &S->title;
+    slots[n++] = &S->auto_next_id;
+    for (int c = 0; c < S->num_choices; ++c) {
+        SceneChoice* C = &S->choices[c];
+        slots[n++] = &C->text; slots[n++] = &C->next_id;
+        for (int k = 0; k < C->add_flags_n; ++k) slots[n++] = &C->add_flags[k];
+        for (int k = 0; k < C->rem_flags_n; ++k) slots[n++] = &C->rem_flags[k];
+    }
+    for (int k = 0; k < S->checks_count; ++k) {
+        SceneCheck* C = &S->checks[k];
+        slots[n++] = &C->flag; slots[n++] = &C->flag2; slots[n++] = &C->not_flag; slots[n++] = &C->goto_id;
+    }
+    return n;
+}
+
+static Uint32 vfx_hash(Uint32 h, const VfxParams* V) {
+    const float f[6] = { V->grain, V->vignette, V->glitch, V->red_overlay, V->shake_ms, V->shake_amp };
+    h = fnv1a(h, f, sizeof f);
+    return fnv1a(h, &V->flash, sizeof V->flash);
+}
+
+// Хеш розібраного вмісту (рядки, числа, vfx) — щоб hot-reload помітив, що сцена змінилась.
+// Форматування, порядок ключів і невідомі ключі на нього не впливають.
+static Uint32 scene_hash(Scene* S) {
+    char** slots[SCENE_MAX_STRS];
+    int n = scene_str_slots(S, slots);
+    Uint32 h = 2166136261u;
+    for (int i = 0; i < n; ++i) {
+        if (*slots[i]) h = fnv1a(h, *slots[i], strlen(*slots[i]) + 1);
+        else h = fnv1a(h, "\xff", 1); // NULL != ""
+    }
+    const int nums[3] = { S->num_choices, S->checks_count, (int)S->cinematic };
+    h = fnv1a(h, nums, sizeof nums);
+    h = fnv1a(h, &S->auto_time, sizeof S->auto_time);
+    h = vfx_hash(h, &S->vfx);
+    for (int c = 0; c < S->num_choices; ++c) {
+        const SceneChoice* C = &S->choices[c];
+        const int v[5] = { C->d_clarity, C->d_anxiety, C->d_balance, C->add_flags_n, C->rem_flags_n };
+        h = fnv1a(h, v, sizeof v);
+        h = vfx_hash(h, &C->vfx_on_pick);
+    }
+    for (int k = 0; k < S->checks_count; ++k) {
+        const SceneCheck* C = &S->checks[k];
+        const int v[6] = { C->op_cl, C->val_cl, C->op_anx, C->val_anx, C->op_bal, C->val_bal };
+        h = fnv1a(h, v, sizeof v);
+    }
+    return h;
+}
+
+// Рядки сцени вказують у буфер файлу чи каталогу -> копіюємо одним блоком (id першим)
+static bool scene_pack(Scene* S) {
+    char** slots[SCENE_MAX_STRS];
+    int n = scene_str_slots(S, slots);
+    size_t total = 0;
+    for (int i = 0; i < n; ++i) if (*slots[i]) total += strlen(*slots[i]) + 1;
+    char* arena = (char*)malloc(total);
+    if (!arena) return false;
+    char* w = arena;
+    for (int i = 0; i < n; ++i) {
+        if (!*slots[i]) continue;
+        size_t len = strlen(*slots[i]) + 1;
+        memcpy(w, *slots[i], len);
+        *slots[i] = w;
+        w += len;
+    }
+    S->arena = arena;
+    return true;
+}
+
+// Одна сцена. Індекси переходів лишаються -1 до scene_link().
+// 1 — готово, 0 — без id (пропустити), -1 — помилка JSON або немає пам'яті.
+static int scene_parse(JsonReader* r, const Lang* lang, Scene* S) {
+    memset(S, 0, sizeof(*S));
+    S->auto_next = -1;
+    vfx_params_clear(&S->vfx);
+    jr_obj_begin(r);
+    char* k;
+    while (jr_obj_key(r, &k)) {
+        switch (k[0]) {
+            case 'i': if (!strcmp(k, "id")) { S->id = jr_str(r); continue; } break;
+            case 's': if (!strcmp(k, "speaker")) { S->speaker = resolve_str(lang, jr_str(r)); continue; } break;
+            case 't':
+                if (!strcmp(k, "text"))  { S->text  = resolve_str(lang, jr_str(r)); continue; }
+                if (!strcmp(k, "title")) { S->title = resolve_str(lang, jr_str(r)); continue; }
+                break;
+            case 'b': if (!strcmp(k, "background")) { S->background = jr_str(r); continue; } break;
+            case 'm': if (!strcmp(k, "music")) { S->music = jr_str(r); continue; } break;
+            case 'a':
+                if (!strcmp(k, "auto_time")) { S->auto_time = (float)jr_num(r, 0.0); continue; }
+                if (!strcmp(k, "auto_next")) { S->auto_next_id = jr_str(r); continue; }
+                break;
+            case 'c':
+                if (!strcmp(k, "choices"))   { parse_choices(r, lang, S); continue; }
+                if (!strcmp(k, "checks"))    { parse_checks(r, S); continue; }
+                if (!strcmp(k, "cinematic")) { S->cinematic = jr_bool(r, false); continue; }
+                break;
+            case 'v': if (!strcmp(k, "vfx")) { parse_vfx(r, &S->vfx); continue; } break;
+        }
+        jr_skip(r);
+    }
+    if (!jr_ok(r)) return -1;
+    if (!S->id) return 0;
+    S->src_hash = scene_hash(S);
+    if (!scene_pack(S)) { SDL_Log("scene '%s': out of memory", S->id); S->id = NULL; return -1; }
+    return 1;
+}
+
+// ---------- розбір шматками ----------
+// Масив "scenes" спершу лише розмічається (jr_span, без змін у буфері), далі кожен потік
+// розбирає свій неперервний шматок сцен у власні arena. Порядок і індекс id збираються
+// в головному потоці в порядку файлу, тож результат той самий за будь-якої кількості потоків.
+
+typedef struct {
+    char* b;
+    char* e;
+    int   line;       // для повідомлень про помилки
+    char* line_at;
+} SceneSpan;
+
+typedef void (*PartFn)(void* ctx, int part);
+typedef struct { PartFn fn; void* ctx; int part; } PartArg;
+
+static int part_thread(void* ud) {
+    PartArg* a = (PartArg*)ud;
+    a->fn(a->ctx, a->part);
+    return 0;
+}
+
+// fn(ctx, 0..parts-1): частина 0 — у викликачі, решта — у тимчасових потоках
+static void run_parts(int parts, PartFn fn, void* ctx) {
+    SDL_Thread* th[SCENES_MAX_THREADS] = {0};
+    PartArg arg[SCENES_MAX_THREADS];
+    for (int p = 1; p < parts; ++p) {
+        arg[p] = (PartArg){ fn, ctx, p };
+        th[p] = SDL_CreateThread(part_thread, "scenes", &arg[p]);
+        if (!th[p]) fn(ctx, p); // потоку немає — робимо тут
+    }
+    fn(ctx, 0);
+    for (int p = 1; p < parts; ++p) if (th[p]) SDL_WaitThread(th[p], NULL);
+}
+
+typedef struct {
+    const SceneSpan* spans;
+    Scene*       scenes;       // [i] — сцена spans[i]
+    Sint8*       state;        // результат scene_parse
+    const Lang*  lang;
+    int          bounds[SCENES_MAX_THREADS + 1];   // шматок p: [bounds[p], bounds[p+1])
+    JsonReader   err[SCENES_MAX_THREADS];          // де зупинився шматок з помилкою
+    // лінкування
+    const StrIndex* ix;
+    int          count;
+    int          parts;
+} ParseJob;
+
+static void parse_part(void* ud, int part) {
+    ParseJob* J = (ParseJob*)ud;
+    for (int i = J->bounds[part]; i < J->bounds[part + 1]; ++i) {
+        const SceneSpan* sp = &J->spans[i];
+        JsonReader r;
+        jr_init_span(&r, sp->b, sp->e, sp->line, sp->line_at);
+        J->state[i] = (Sint8)scene_parse(&r, J->lang, &J->scenes[i]);
+        if (J->state[i] < 0) { J->err[part] = r; return; } // решта шматка вже не потрібна
+    }
+}
+
+static void link_part(void* ud, int part) {
+    ParseJob* J = (ParseJob*)ud;
+    int from = (int)((Sint64)J->count * part / J->parts);
+    int to   = (int)((Sint64)J->count * (part + 1) / J->parts);
+    for (int i = from; i < to; ++i) scene_link(&J->scenes[i], J->scenes, J->ix, false);
+}
+
+static int pick_threads(size_t bytes, int n) {
+    int t = g_threads;
+    if (t <= 0) {
+        t = SDL_GetCPUCount();
+        int by_size = (int)(bytes / SCENES_PAR_BYTES) + 1; // дрібний сюжет — один потік
+        if (t > by_size) t = by_size;
+    }
+    if (t > SCENES_MAX_THREADS) t = SCENES_MAX_THREADS;
+    if (t > n) t = n;
+    return t < 1 ? 1 : t;
+}
+
+void scenes_set_threads(int n) { g_threads = n < 0 ? 0 : n; }
+
+// Розмічені сцени -> *out (стиснутий, без пропущених), індекс і ребра
+static bool parse_spans(ParseJob* J, int n, size_t bytes, const char* what, Scene** out, int* out_n, StrIndex* ix) {
+    Scene* scenes = (Scene*)calloc(n > 0 ? (size_t)n : 1, sizeof(Scene));
+    Sint8* state  = (Sint8*)calloc(n > 0 ? (size_t)n : 1, 1);
+    if (!scenes || !state) { free(scenes); free(state); SDL_Log("scenes: out of memory"); return false; }
+    J->scenes = scenes; J->state = state;
+
+    // шматки приблизно однакові за байтами
+    J->parts = pick_threads(bytes, n);
+    J->bounds[0] = 0;
+    for (int p = 1, i = 0; p < J->parts; ++p) {
+        const char* at = n ? J->spans[0].b + bytes * (size_t)p / (size_t)J->parts : NULL;
+        while (i < n && J->spans[i].b < at) ++i;
+        J->bounds[p] = i;
+    }
+    J->bounds[J->parts] = n;
+    run_parts(J->parts, parse_part, J);
+
+    bool ok = strindex_reserve(ix, n);
+    int count = 0;
+    for (int i = 0; i < n; ++i) {
+        if (!ok) { scene_free_content(&scenes[i]); continue; }
+        if (state[i] < 0) {
+            int part = 0;
+            while (i >= J->bounds[part + 1]) ++part;
+            if (!jr_ok(&J->err[part])) jr_log_error(&J->err[part], what);
+            ok = false; scene_free_content(&scenes[i]); continue;
+        }
+        if (state[i] == 0) { SDL_Log("scenes: scene #%d without \"id\" skipped", i); continue; } // номер у файлі, не серед прийнятих
+        Scene* S = &scenes[i];
+        int at = strindex_put(ix, S->id, count); // ключ живе в arena, тож переміщення сцени його не зачепить
+        if (at == count) { scenes[count++] = *S; continue; }
+        if (at < 0) ok = false;
+        else SDL_Log("scenes: duplicate id '%s' skipped (first is scene #%d)", S->id, at);
+        scene_free_content(S);
+    }
+    free(state);
+    if (!ok) {
+        for (int i = 0; i < count; ++i) scene_free_content(&scenes[i]);
+        free(scenes);
+        return false;
+    }
+
+    J->ix = ix; J->count = count;
+    J->parts = count < J->parts ? (count ? count : 1) : J->parts;
+    run_parts(J->parts, link_part, J);
+    *out = scenes; *out_n = count;
+    return true;
+}
+
+bool scenes_parse_buffer(char* buf, size_t size, const char* what, const Lang* lang,
+                         Scene** out, int* out_n, int* out_start, StrIndex* out_ix)
+{
+    *out = NULL; *out_n = 0; *out_start = -1;
+    memset(out_ix, 0, sizeof(*out_ix));
+
+    JsonReader r;
+    jr_init(&r, buf, size);
+    ParseJob J;
+    memset(&J, 0, sizeof(J));
+    J.lang = lang;
+    SceneSpan* spans = NULL;
+    int n = 0, cap = 0;
+    const char* start = NULL; // "start" може стояти і після "scenes"
+    bool has_scenes = false, ok = true;
+
+    char* k;
+    jr_obj_begin(&r);
+    while (ok && jr_obj_key(&r, &k)) {
+        if (!strcmp(k, "start")) { start = jr_str(&r); continue; }
+        if (strcmp(k, "scenes") != 0 || jr_peek(&r) != JR_ARR) { jr_skip(&r); continue; }
+        has_scenes = true;
+        jr_arr_begin(&r);
+        while (jr_arr_next(&r)) {
+            if (jr_peek(&r) != JR_OBJ) { jr_skip(&r); continue; }
+            if (n == cap) {
+                int ncap = cap ? cap * 2 : 64;
+                SceneSpan* grown = (SceneSpan*)realloc(spans, (size_t)ncap * sizeof(SceneSpan));
+                if (!grown) { SDL_Log("scenes: out of memory"); ok = false; break; }
+                spans = grown; cap = ncap;
+            }
+            SceneSpan* sp = &spans[n];
+            sp->line = r.line; sp->line_at = r.line_at;
+            if (jr_span(&r, &sp->b, &sp->e)) n++;
+        }
+    }
+
+    if (!jr_ok(&r)) { jr_log_error(&r, what); ok = false; }
+    if (ok && (!start || !has_scenes)) { SDL_Log("scenes: %s needs \"start\" and \"scenes\"", what); ok = false; }
+
+    if (ok) {
+        J.spans = spans;
+        size_t bytes = n ? (size_t)(spans[n - 1].e - spans[0].b) : 0;
+        ok = parse_spans(&J, n, bytes, what, out, out_n, out_ix);
+    }
+    if (ok) *out_start = strindex_get(out_ix, start);
+    else strindex_free(out_ix);
+    free(spans);
+    return ok;
+}
+
+bool scenes_parse_file(const char* path, const Lang* lang, Scene** out, int* out_n, int* out_start, StrIndex* out_ix)
+{
+    size_t size = 0;
+    char* buf = (char*)asset_load(path, &size);
+    if (!buf) { *out = NULL; *out_n = 0; *out_start = -1; memset(out_ix, 0, sizeof(*out_ix)); return false; }
+    bool ok = scenes_parse_buffer(buf, size, path, lang, out, out_n, out_start, out_ix);
+    free(buf);
+    return ok;
+}
+
+void scene_link(Scene* S, const Scene* arr, const StrIndex* ix, bool only_stale) {
+    for (int c = 0; c < S->num_choices; ++c) {
+        SceneChoice* C = &S->choices[c];
+        if (!C->next_id) continue;
+        if (only_stale && C->next >= 0 && arr[C->next].id) continue;
+        C->next = strindex_get(ix, C->next_id); // лишимо -1 якщо не знайдено
+    }
+    if (S->auto_next_id && !(only_stale && S->auto_next >= 0 && arr[S->auto_next].id)) {
+        S->auto_next = strindex_get(ix, S->auto_next_id);
+    }
+    for (int k = 0; k < S->checks_count; ++k) {
+        SceneCheck* C = &S->checks[k];
+        if (!C->goto_id) continue;
+        if (only_stale && C->goto_index >= 0 && arr[C->goto_index].id) continue;
+        C->goto_index = strindex_get(ix, C->goto_id);
+    }
+}
+
+void scene_free_content(Scene* S) {
+    free(S->arena);
+    memset(S, 0, sizeof(*S));
+}
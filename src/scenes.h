@@ -0,0 +1,95 @@
+#ifndef HYDRANGEA_SCENES_H
+#define HYDRANGEA_SCENES_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include "vfx.h"
+#include "strindex.h"
+
+// Сюжет і каталог рядків. Обидва файли читаються потоково (jsonr) прямо у
+// своєму буфері, без проміжного дерева. Рядки каталогу живуть у буфері файлу
+// (Lang.buf); рядки сцени після розбору пакуються в один блок (Scene.arena).
+
+typedef struct {
+    char* key;
+    char* val;
+} StringKV;
+
+typedef struct {
+    StringKV* kv;     // ключі й значення вказують у buf
+    int count;
+    char* buf;        // вміст файлу, розекранований на місці
+    StrIndex ix;      // ключ -> індекс у kv
+} Lang;
+
+typedef struct {
+    int op_cl,  val_cl;   // clarity
+    int op_anx, val_anx;  // anxiety
+    int op_bal, val_bal;  // balance
+    char* flag;           // "flag"
+    char* flag2;          // "flag2"
+    char* not_flag;       // "not_flag"
+    char* goto_id;        // id сцени для переходу
+    int   goto_index;     // індекс (резолвимо після завантаження)
+} SceneCheck;
+
+typedef struct {
+    char* text;
+    int d_clarity, d_anxiety, d_balance;
+    int next;
+
+    char* next_id;        // id сцени (резолвимо в next після завантаження)
+
+    char* add_flags[4];   int add_flags_n;   // із "flags+"
+    char* rem_flags[4];   int rem_flags_n;   // із "flags-"
+
+    VfxParams vfx_on_pick;
+} SceneChoice;
+
+typedef struct {
+    char* id;
+    char* speaker;
+    char* text;
+    int num_choices;
+    SceneChoice choices[4];
+
+    char* background;
+    char* music;
+
+    char* title;
+    float auto_time;      // скільки показувати перед auto_next (відлік — у SceneRuntime)
+    char* auto_next_id;
+    int   auto_next;
+
+    SceneCheck checks[4];
+    int checks_count;
+
+    bool cinematic;
+    VfxParams vfx;
+
+    Uint32 src_hash;   // хеш JSON-опису сцени (для hot-reload)
+    char*  arena;      // усі рядки сцени одним блоком (id == arena)
+} Scene;
+
+bool        lang_load(Lang* out, const char* path);
+const char* lang_get(const Lang* lang, const char* key);
+void        lang_free(Lang* lang);
+
+// Увесь файл сцен -> новий масив і індекс id -> позиція; переходи вже зв'язані.
+// Game не чіпає — годиться для фонового потоку. Сцени без id і повтори id пропускаються (з логом).
+// *out_start == -1, якщо стартової сцени немає.
+// Великий масив сцен розбирається кількома потоками; результат не залежить від їх кількості.
+bool scenes_parse_file(const char* path, const Lang* lang, Scene** out, int* out_n, int* out_start, StrIndex* out_ix);
+// те саме з готового буфера (buf[size] == '\0'; вміст змінюється на місці, після виклику не потрібен)
+bool scenes_parse_buffer(char* buf, size_t size, const char* what, const Lang* lang,
+                         Scene** out, int* out_n, int* out_start, StrIndex* out_ix);
+void scenes_set_threads(int n);   // 0 — авто (за кількістю ядер і розміром файлу), 1 — в один потік
+
+// індекс по непорожніх слотах arr (після hot-reload ключі старих сцен уже звільнені)
+bool scenes_index(StrIndex* ix, const Scene* arr, int count);
+// next / auto_next / checks.goto однієї сцени.
+// only_stale: чіпаємо лише ребра, що вказують в нікуди (-1) або на видалену сцену.
+void scene_link(Scene* S, const Scene* arr, const StrIndex* ix, bool only_stale);
+void scene_free_content(Scene* S);   // слот лишається порожнім (id == NULL)
+
+#endif /* HYDRANGEA_SCENES_H */
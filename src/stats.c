@@ -0,0 +1,105 @@
+#include "stats.h"
+#include <math.h>
+
+#define ANX_DECAY   0.05   // од./с
+#define ANX_HIGH    60.0
+#define ANX_LOW     30.0
+#define DRIFT_HIGH  0.20   // при A > 60: -(A-60)*0.20
+#define DRIFT_LOW   0.12   // при A < 30: (30-A)*0.12
+#define BAL_DAMP    0.20   // k у db/dt = d - k*b
+#define CL_K_UP     0.30   // ясність набирається повільно...
+#define CL_K_DOWN   0.60   // ...і втрачається швидше
+
+static double clampd(double v, double lo, double hi) { return v < lo ? lo : (v > hi ? hi : v); }
+
+void stats_clamp(StatState* s) {
+    s->clarity = clampd(s->clarity, 0.0, 100.0);
+    s->anxiety = clampd(s->anxiety, 0.0, 100.0);
+    s->balance = clampd(s->balance, -100.0, 100.0);
+}
+
+// Шматок з лінійним дрейфом d(t) = p + q*t:
+//   b(t) = E*e^(-kt) + P + Q*t,  Q = q/k,  P = p/k - q/k^2,  E = b0 - P
+typedef struct { double E, P, Q; } BalCurve;
+
+static double bal_at(const BalCurve* c, double t) { return c->E * exp(-BAL_DAMP * t) + c->P + c->Q * t; }
+
+// ∫ b dt на [a, b]
+static double bal_integral(const BalCurve* c, double a, double b) {
+    return c->E * (exp(-BAL_DAMP * a) - exp(-BAL_DAMP * b)) / BAL_DAMP
+         + c->P * (b - a) + 0.5 * c->Q * (b*b - a*a);
+}
+
+// корінь на монотонному відрізку зі зміною знака (бісекція: фіксована кількість кроків)
+static double bal_root(const BalCurve* c, double a, double b) {
+    double fa = bal_at(c, a);
+    for (int i = 0; i < 64; ++i) {
+        double m = 0.5 * (a + b), fm = bal_at(c, m);
+        if ((fm < 0.0) == (fa < 0.0)) { a = m; fa = fm; } else b = m;
+    }
+    return 0.5 * (a + b);
+}
+
+static void advance_piece(StatState* s, double p, double q, double h) {
+    const double k = BAL_DAMP;
+    BalCurve c;
+    c.Q = q / k;
+    c.P = p / k - q / (k * k);
+    c.E = s->balance - c.P;
+
+    // b'' = k^2*E*e^(-kt) не змінює знак -> не більше одного екстремуму -> не більше двох нулів
+    double cuts[4]; int n = 0;
+    cuts[n++] = 0.0;
+    double ext = -1.0;
+    if (c.E != 0.0) {
+        double r = c.Q / (k * c.E);            // e^(-k*t_ext)
+        if (r > 0.0 && r < 1.0) ext = -log(r) / k;
+    }
+    double mono[3] = { 0.0, h, h }; int nm = 2;
+    if (ext > 0.0 && ext < h) { mono[1] = ext; mono[2] = h; nm = 3; }
+    for (int i = 0; i + 1 < nm; ++i) {
+        double a = mono[i], b = mono[i+1];
+        double fa = bal_at(&c, a), fb = bal_at(&c, b);
+        if (fa != 0.0 && fb != 0.0 && (fa < 0.0) != (fb < 0.0)) cuts[n++] = bal_root(&c, a, b);
+    }
+    cuts[n++] = h;
+
+    // на кожному відрізку знак b сталий -> ясність монотонна -> клампу в кінці досить
+    for (int i = 0; i + 1 < n; ++i) {
+        double a = cuts[i], b = cuts[i+1];
+        if (b <= a) continue;
+        double rate = bal_at(&c, 0.5 * (a + b)) >= 0.0 ? CL_K_UP : CL_K_DOWN;
+        s->clarity = clampd(s->clarity + bal_integral(&c, a, b) / 100.0 * rate, 0.0, 100.0);
+    }
+
+    // |drift|/k <= 40, тож із [-100, 100] баланс не виходить; кламп — від похибок
+    s->balance = clampd(bal_at(&c, h), -100.0, 100.0);
+}
+
+void stats_advance(StatState* s, double dt) {
+    stats_clamp(s);
+    double left = dt;
+    while (left > 0.0) {
+        const double A = s->anxiety;
+        double p, q, span, A_end;
+        if (A > ANX_HIGH) {          // drift = -(A0 - 0.05t - 60)*0.2
+            span = (A - ANX_HIGH) / ANX_DECAY;  A_end = ANX_HIGH;
+            p = -(A - ANX_HIGH) * DRIFT_HIGH;   q = ANX_DECAY * DRIFT_HIGH;
+        } else if (A > ANX_LOW) {    // нейтральна зона
+            span = (A - ANX_LOW) / ANX_DECAY;   A_end = ANX_LOW;
+            p = 0.0; q = 0.0;
+        } else if (A > 0.0) {        // drift = (30 - A0 + 0.05t)*0.12
+            span = A / ANX_DECAY;               A_end = 0.0;
+            p = (ANX_LOW - A) * DRIFT_LOW;      q = ANX_DECAY * DRIFT_LOW;
+        } else {                     // тривога на нулі: сталий дрейф
+            span = left;                        A_end = 0.0;
+            p = ANX_LOW * DRIFT_LOW;            q = 0.0;
+        }
+
+        double h = span < left ? span : left;
+        advance_piece(s, p, q, h);
+        s->anxiety = (h < span) ? A - ANX_DECAY * h : A_end;
+        if (s->anxiety < 0.0) s->anxiety = 0.0;
+        left -= h;
+    }
+}
@@ -0,0 +1,20 @@
+#ifndef HYDRANGEA_STATS_H
+#define HYDRANGEA_STATS_H
+
+// Модель статів (цільові значення, без HUD-згладжування):
+//   тривога A:  dA/dt = -0.05, не нижче 0
+//   баланс b:   db/dt = drift(A) - 0.2*b,  drift = -(A-60)*0.2 при A>60, (30-A)*0.12 при A<30, інакше 0
+//   ясність c:  dc/dt = b/100 * (b >= 0 ? 0.3 : 0.6), у межах 0..100
+// Розв'язується в замкненій формі по шматках (межі режимів тривоги, нулі балансу),
+// тож результат не залежить від кроку, а stats_advance(s, будь-яке dt) — O(1).
+
+typedef struct {
+    double clarity;   // 0..100
+    double anxiety;   // 0..100
+    double balance;   // -100..+100
+} StatState;
+
+void stats_clamp(StatState* s);
+void stats_advance(StatState* s, double dt);
+
+#endif /* HYDRANGEA_STATS_H */
@@ -0,0 +1,63 @@
+#include "strindex.h"
+#include <stdlib.h>
+#include <string.h>
+
+static Uint32 str_hash(const char* s) {
+    Uint32 h = 2166136261u; // FNV-1a
+    for (; *s; ++s) { h ^= (unsigned char)*s; h *= 16777619u; }
+    return h;
+}
+
+// слот ключа або перший вільний на його ланцюжку
+static StrSlot* probe(StrSlot* slots, int cap, const char* key, Uint32 h) {
+    Uint32 mask = (Uint32)cap - 1;
+    for (Uint32 i = h & mask;; i = (i + 1) & mask) {
+        StrSlot* s = &slots[i];
+        if (!s->key || (s->hash == h && strcmp(s->key, key) == 0)) return s;
+    }
+}
+
+static bool rehash(StrIndex* ix, int cap) {
+    StrSlot* slots = (StrSlot*)calloc((size_t)cap, sizeof(StrSlot));
+    if (!slots) { SDL_Log("strindex: out of memory (%d slots)", cap); return false; }
+    for (int i = 0; i < ix->cap; ++i) {
+        const StrSlot* s = &ix->slots[i];
+        if (s->key) *probe(slots, cap, s->key, s->hash) = *s;
+    }
+    free(ix->slots);
+    ix->slots = slots;
+    ix->cap = cap;
+    return true;
+}
+
+bool strindex_reserve(StrIndex* ix, int n) {
+    int cap = ix->cap ? ix->cap : 16;
+    while (cap < n * 2) cap *= 2;
+    return cap == ix->cap || rehash(ix, cap);
+}
+
+int strindex_put(StrIndex* ix, const char* key, int val) {
+    if (!strindex_reserve(ix, ix->count + 1)) return -1;
+    Uint32 h = str_hash(key);
+    StrSlot* s = probe(ix->slots, ix->cap, key, h);
+    if (s->key) return s->val;
+    s->key = key; s->hash = h; s->val = val;
+    ix->count++;
+    return val;
+}
+
+int strindex_get(const StrIndex* ix, const char* key) {
+    if (!ix->count || !key) return -1;
+    const StrSlot* s = probe(ix->slots, ix->cap, key, str_hash(key));
+    return s->key ? s->val : -1;
+}
+
+void strindex_clear(StrIndex* ix) {
+    if (ix->slots) memset(ix->slots, 0, (size_t)ix->cap * sizeof(StrSlot));
+    ix->count = 0;
+}
+
+void strindex_free(StrIndex* ix) {
+    free(ix->slots);
+    memset(ix, 0, sizeof(*ix));
+}
@@ -0,0 +1,30 @@
+#ifndef HYDRANGEA_STRINDEX_H
+#define HYDRANGEA_STRINDEX_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+// Хеш-індекс «рядок -> int» (відкрита адресація, лінійне пробування, заповнення <= 1/2).
+// Ключі не копіюються: рядок має жити, поки живе запис (id у Scene.arena, ключі в Lang.buf).
+// Видалення немає — таблицю простіше перебудувати (strindex_clear + put).
+
+typedef struct {
+    const char* key;    // NULL — вільно
+    Uint32      hash;
+    int         val;
+} StrSlot;
+
+typedef struct {
+    StrSlot* slots;
+    int      cap;       // степінь двійки або 0
+    int      count;
+} StrIndex;
+
+bool strindex_reserve(StrIndex* ix, int n);            // місце під n ключів без перехешування
+// значення, що тепер стоїть за key: val, якщо ключ новий; наявне, якщо вже був (не замінюється); -1 — немає пам'яті
+int  strindex_put(StrIndex* ix, const char* key, int val);
+int  strindex_get(const StrIndex* ix, const char* key); // -1, якщо немає
+void strindex_clear(StrIndex* ix);                     // пам'ять лишається
+void strindex_free(StrIndex* ix);
+
+#endif /* HYDRANGEA_STRINDEX_H */
@@ -0,0 +1,401 @@
+#include "swcomp.h"
+#include "prim.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SWC_X86 1
+#include <immintrin.h>
+#endif
+#if defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#define SWC_ARM 1
+#include <arm_neon.h>
+#endif
+
+// набір інструкцій — на рівні функції: решта файлу збирається під базовий процесор
+#if defined(__GNUC__) || defined(__clang__)
+#define SWC_TARGET(isa) __attribute__((target(isa)))
+#else
+#define SWC_TARGET(isa)
+#endif
+
+// ---------- скалярні ядра (еталон: SIMD-версії дають ті самі байти) ----------
+
+static void fill_c(Uint32* px, int pitch, int w, int h, Uint32 premul, Uint8 inva, Uint32 mask) {
+    const Uint8* pm = (const Uint8*)&premul;
+    const Uint8* mk = (const Uint8*)&mask;
+    for (int y = 0; y < h; ++y) {
+        Uint8* p = (Uint8*)(px + (size_t)y * pitch);
+        for (int i = 0; i < w * 4; ++i) p[i] = (Uint8)((p[i] * inva / 255 + pm[i & 3]) & mk[i & 3]);
+    }
+}
+
+static void lerp_rows_c(const Uint32* a, const Uint32* b, Uint32* out, int n, int w) {
+    const Uint8* pa = (const Uint8*)a;
+    const Uint8* pb = (const Uint8*)b;
+    Uint8* po = (Uint8*)out;
+    const int iw = 256 - w;
+    for (int i = 0; i < n * 4; ++i) po[i] = (Uint8)((pa[i] * iw + pb[i] * w) >> 8);
+}
+
+static void stretch_row_c(const Uint32* v, const int* x0, const Uint16* wx, Uint32* out, int n) {
+    for (int i = 0; i < n; ++i) {
+        const Uint8* p = (const Uint8*)(v + x0[i]);
+        Uint8* o = (Uint8*)(out + i);
+        const int w = wx[i], iw = 256 - w;
+        for (int c = 0; c < 4; ++c) o[c] = (Uint8)((p[c] * iw + p[c + 4] * w) >> 8);
+    }
+}
+
+// ---------- x86: SSE2 / AVX2 ----------
+#ifdef SWC_X86
+
+// x / 255 без ділення, точно для x <= 65025 (добуток двох байтів)
+#define DIV255_SSE2(x, one) _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16((x), (one)), _mm_srli_epi16((x), 8)), 8)
+#define DIV255_AVX2(x, one) _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16((x), (one)), _mm256_srli_epi16((x), 8)), 8)
+
+SWC_TARGET("sse2")
+static void fill_sse2(Uint32* px, int pitch, int w, int h, Uint32 premul, Uint8 inva, Uint32 mask) {
+    const __m128i z = _mm_setzero_si128(), one = _mm_set1_epi16(1);
+    const __m128i ia = _mm_set1_epi16(inva), pm = _mm_set1_epi32((int)premul), mk = _mm_set1_epi32((int)mask);
+    for (int y = 0; y < h; ++y) {
+        Uint32* p = px + (size_t)y * pitch;
+        int x = 0;
+        for (; x + 4 <= w; x += 4) {
+            __m128i d = _mm_loadu_si128((const __m128i*)(p + x));
+            __m128i lo = _mm_mullo_epi16(_mm_unpacklo_epi8(d, z), ia);
+            __m128i hi = _mm_mullo_epi16(_mm_unpackhi_epi8(d, z), ia);
+            lo = DIV255_SSE2(lo, one);
+            hi = DIV255_SSE2(hi, one);
+            _mm_storeu_si128((__m128i*)(p + x), _mm_and_si128(_mm_add_epi8(_mm_packus_epi16(lo, hi), pm), mk));
+        }
+        if (x < w) fill_c(p + x, pitch, w - x, 1, premul, inva, mask);
+    }
+}
+
+SWC_TARGET("sse2")
+static void lerp_rows_sse2(const Uint32* a, const Uint32* b, Uint32* out, int n, int w) {
+    const __m128i z = _mm_setzero_si128();
+    const __m128i wa = _mm_set1_epi16((short)(256 - w)), wb = _mm_set1_epi16((short)w);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i va = _mm_loadu_si128((const __m128i*)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i*)(b + i));
+        __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(va, z), wa),
+                                   _mm_mullo_epi16(_mm_unpacklo_epi8(vb, z), wb));
+        __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(va, z), wa),
+                                   _mm_mullo_epi16(_mm_unpackhi_epi8(vb, z), wb));
+        _mm_storeu_si128((__m128i*)(out + i), _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8)));
+    }
+    if (i < n) lerp_rows_c(a + i, b + i, out + i, n - i, w);
+}
+
+// по два вихідні пікселі: кожен — пара сусідніх пікселів джерела зі своїми вагами
+SWC_TARGET("sse2")
+static void stretch_row_sse2(const Uint32* v, const int* x0, const Uint16* wx, Uint32* out, int n) {
+    const __m128i z = _mm_setzero_si128(), full = _mm_set1_epi16(256);
+    int i = 0;
+    for (; i + 2 <= n; i += 2) {
+        // [wa wb . . . . . .] -> [256-wa x4 | wa x4], [256-wb x4 | wb x4]
+        __m128i w2 = _mm_cvtsi32_si128((int)wx[i] | ((int)wx[i + 1] << 16));
+        __m128i wa = _mm_shufflelo_epi16(w2, 0x00), wb = _mm_shufflelo_epi16(w2, 0x55);
+        wa = _mm_unpacklo_epi64(_mm_sub_epi16(full, wa), wa);
+        wb = _mm_unpacklo_epi64(_mm_sub_epi16(full, wb), wb);
+        __m128i pa = _mm_mullo_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(v + x0[i])), z), wa);
+        __m128i pb = _mm_mullo_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(v + x0[i + 1])), z), wb);
+        // сума половин: для a — у нижніх 64 бітах, для b — у верхніх
+        __m128i s = _mm_add_epi16(_mm_unpacklo_epi64(pa, pb), _mm_unpackhi_epi64(pa, pb));
+        s = _mm_srli_epi16(s, 8);
+        _mm_storel_epi64((__m128i*)(out + i), _mm_packus_epi16(s, s));
+    }
+    if (i < n) stretch_row_c(v, x0 + i, wx + i, out + i, n - i);
+}
+
+SWC_TARGET("avx2")
+static void fill_avx2(Uint32* px, int pitch, int w, int h, Uint32 premul, Uint8 inva, Uint32 mask) {
+    const __m256i z = _mm256_setzero_si256(), one = _mm256_set1_epi16(1);
+    const __m256i ia = _mm256_set1_epi16(inva), pm = _mm256_set1_epi32((int)premul), mk = _mm256_set1_epi32((int)mask);
+    for (int y = 0; y < h; ++y) {
+        Uint32* p = px + (size_t)y * pitch;
+        int x = 0;
+        for (; x + 8 <= w; x += 8) {
+            __m256i d = _mm256_loadu_si256((const __m256i*)(p + x));
+            __m256i lo = _mm256_mullo_epi16(_mm256_unpacklo_epi8(d, z), ia);
+            __m256i hi = _mm256_mullo_epi16(_mm256_unpackhi_epi8(d, z), ia);
+            lo = DIV255_AVX2(lo, one);
+            hi = DIV255_AVX2(hi, one);
+            // unpack і pack — у межах 128-бітних половин, тож порядок пікселів зберігається
+            _mm256_storeu_si256((__m256i*)(p + x), _mm256_and_si256(_mm256_add_epi8(_mm256_packus_epi16(lo, hi), pm), mk));
+        }
+        if (x < w) fill_c(p + x, pitch, w - x, 1, premul, inva, mask);
+    }
+}
+
+SWC_TARGET("avx2")
+static void lerp_rows_avx2(const Uint32* a, const Uint32* b, Uint32* out, int n, int w) {
+    const __m256i z = _mm256_setzero_si256();
+    const __m256i wa = _mm256_set1_epi16((short)(256 - w)), wb = _mm256_set1_epi16((short)w);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i va = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m256i vb = _mm256_loadu_si256((const __m256i*)(b + i));
+        __m256i lo = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(va, z), wa),
+                                      _mm256_mullo_epi16(_mm256_unpacklo_epi8(vb, z), wb));
+        __m256i hi = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(va, z), wa),
+                                      _mm256_mullo_epi16(_mm256_unpackhi_epi8(vb, z), wb));
+        _mm256_storeu_si256((__m256i*)(out + i),
+                            _mm256_packus_epi16(_mm256_srli_epi16(lo, 8), _mm256_srli_epi16(hi, 8)));
+    }
+    if (i < n) lerp_rows_c(a + i, b + i, out + i, n - i, w);
+}
+#endif
+
+// ---------- ARM: NEON ----------
+#ifdef SWC_ARM
+static void fill_neon(Uint32* px, int pitch, int w, int h, Uint32 premul, Uint8 inva, Uint32 mask) {
+    const uint8x8_t ia = vdup_n_u8(inva);
+    const uint16x8_t one = vdupq_n_u16(1);
+    const uint8x16_t pm = vreinterpretq_u8_u32(vdupq_n_u32(premul));
+    const uint8x16_t mk = vreinterpretq_u8_u32(vdupq_n_u32(mask));
+    for (int y = 0; y < h; ++y) {
+        Uint32* p = px + (size_t)y * pitch;
+        int x = 0;
+        for (; x + 4 <= w; x += 4) {
+            uint8x16_t d = vld1q_u8((const uint8_t*)(p + x));
+            uint16x8_t lo = vmull_u8(vget_low_u8(d), ia);
+            uint16x8_t hi = vmull_u8(vget_high_u8(d), ia);
+            lo = vshrq_n_u16(vaddq_u16(vaddq_u16(lo, one), vshrq_n_u16(lo, 8)), 8);
+            hi = vshrq_n_u16(vaddq_u16(vaddq_u16(hi, one), vshrq_n_u16(hi, 8)), 8);
+            vst1q_u8((uint8_t*)(p + x), vandq_u8(vaddq_u8(vcombine_u8(vmovn_u16(lo), vmovn_u16(hi)), pm), mk));
+        }
+        if (x < w) fill_c(p + x, pitch, w - x, 1, premul, inva, mask);
+    }
+}
+
+static void lerp_rows_neon(const Uint32* a, const Uint32* b, Uint32* out, int n, int w) {
+    const uint16x8_t wa = vdupq_n_u16((uint16_t)(256 - w)), wb = vdupq_n_u16((uint16_t)w);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        uint8x16_t va = vld1q_u8((const uint8_t*)(a + i));
+        uint8x16_t vb = vld1q_u8((const uint8_t*)(b + i));
+        uint16x8_t lo = vmlaq_u16(vmulq_u16(vmovl_u8(vget_low_u8(va)), wa), vmovl_u8(vget_low_u8(vb)), wb);
+        uint16x8_t hi = vmlaq_u16(vmulq_u16(vmovl_u8(vget_high_u8(va)), wa), vmovl_u8(vget_high_u8(vb)), wb);
+        vst1q_u8((uint8_t*)(out + i), vcombine_u8(vshrn_n_u16(lo, 8), vshrn_n_u16(hi, 8)));
+    }
+    if (i < n) lerp_rows_c(a + i, b + i, out + i, n - i, w);
+}
+
+static void stretch_row_neon(const Uint32* v, const int* x0, const Uint16* wx, Uint32* out, int n) {
+    for (int i = 0; i < n; ++i) {
+        uint16x8_t p = vmovl_u8(vld1_u8((const uint8_t*)(v + x0[i])));
+        uint16x4_t s = vadd_u16(vmul_n_u16(vget_low_u16(p), (uint16_t)(256 - wx[i])),
+                                vmul_n_u16(vget_high_u16(p), wx[i]));
+        uint8x8_t r = vshrn_n_u16(vcombine_u16(s, s), 8);
+        vst1_lane_u32((uint32_t*)(out + i), vreinterpret_u32_u8(r), 0);
+    }
+}
+#endif
+
+static const SwcKernels k_scalar = { "scalar", fill_c, lerp_rows_c, stretch_row_c };
+#ifdef SWC_X86
+static const SwcKernels k_sse2 = { "SSE2", fill_sse2, lerp_rows_sse2, stretch_row_sse2 };
+static const SwcKernels k_avx2 = { "AVX2", fill_avx2, lerp_rows_avx2, stretch_row_sse2 }; // вибірка пар — без виграшу від 256 біт
+#endif
+#ifdef SWC_ARM
+static const SwcKernels k_neon = { "NEON", fill_neon, lerp_rows_neon, stretch_row_neon };
+#endif
+
+bool swc_kernels(SwcKind kind, SwcKernels* out) {
+    switch (kind) {
+    case SWC_SCALAR: *out = k_scalar; return true;
+#ifdef SWC_X86
+    case SWC_SSE2: if (!SDL_HasSSE2()) return false; *out = k_sse2; return true;
+    case SWC_AVX2: if (!SDL_HasAVX2()) return false; *out = k_avx2; return true;
+#endif
+#ifdef SWC_ARM
+    case SWC_NEON: if (!SDL_HasNEON()) return false; *out = k_neon; return true;
+#endif
+    default: return false;
+    }
+}
+
+SwcKind swc_best_kind(void) {
+    static const SwcKind order[] = { SWC_AVX2, SWC_SSE2, SWC_NEON };
+    SwcKernels k;
+    for (size_t i = 0; i < SDL_arraysize(order); ++i) if (swc_kernels(order[i], &k)) return order[i];
+    return SWC_SCALAR;
+}
+
+// ---------- поверхні ----------
+
+static void*  g_scratch = NULL;   // таблиці стовпців і рядок після вертикального кроку
+static size_t g_scratch_n = 0;
+static void*  g_corner = NULL;    // копія кута кадру для swc_stretch_corner
+static size_t g_corner_n = 0;
+
+static void* grow(void** buf, size_t* cap, size_t n) {
+    if (n <= *cap) return *buf;
+    void* p = realloc(*buf, n);
+    if (!p) { SDL_Log("swcomp: out of memory (%u bytes)", (unsigned)n); return NULL; }
+    *buf = p; *cap = n;
+    return p;
+}
+
+static bool fmt_ok(const SDL_PixelFormat* f) {
+    return f && f->BytesPerPixel == 4 && f->Rloss == 0 && f->Gloss == 0 && f->Bloss == 0;
+}
+
+bool swc_fill(SDL_Surface* s, const SDL_Rect* r, SDL_Color c, const SwcKernels* k) {
+    if (!s || !fmt_ok(s->format)) return false;
+    SDL_Rect full = { 0, 0, s->w, s->h }, area;
+    if (c.a == 0 || !SDL_IntersectRect(r ? r : &full, &full, &area)) return true;
+
+    const Uint8 a = c.a;
+    const Uint32 premul = SDL_MapRGBA(s->format, (Uint8)(c.r * a / 255), (Uint8)(c.g * a / 255),
+                                      (Uint8)(c.b * a / 255), a);
+    if (SDL_MUSTLOCK(s) && SDL_LockSurface(s) != 0) return false;
+    Uint32* px = (Uint32*)((Uint8*)s->pixels + (size_t)area.y * s->pitch) + area.x;
+    // без альфа-каналу SDL пише в зайвий байт нуль — так само
+    const Uint32 mask = s->format->Amask ? 0xFFFFFFFFu : (s->format->Rmask | s->format->Gmask | s->format->Bmask);
+    k->fill(px, s->pitch / 4, area.w, area.h, premul, (Uint8)(255 - a), mask);
+    if (SDL_MUSTLOCK(s)) SDL_UnlockSurface(s);
+    return true;
+}
+
+// центр вихідного пікселя i -> ліва з двох сусідніх точок джерела і вага правої (0..255)
+static void map_axis(int i, int dn, int sn, int* s0, int* w) {
+    Sint64 f = (Sint64)(2 * i + 1) * sn * 65536 / (2 * (Sint64)dn) - 32768; // 16.16
+    if (f < 0) f = 0;
+    int p = (int)(f >> 16);
+    if (p >= sn - 1) { *s0 = sn - 1; *w = 0; return; }
+    *s0 = p;
+    *w = (int)((f >> 8) & 0xFF);
+}
+
+typedef struct { Uint32* px[2]; int tag[2]; } RowPair;
+
+// рядок sy джерела, розтягнутий по горизонталі; keep — рядок, який зараз не можна витісняти
+static const Uint32* hrow(RowPair* rp, int sy, int keep, const Uint32* sp, int spitch, int sw,
+                          const int* x0, const Uint16* wx, int dw, const SwcKernels* k) {
+    for (int i = 0; i < 2; ++i) if (rp->tag[i] == sy) return rp->px[i];
+    int slot = rp->tag[0] < rp->tag[1] ? 0 : 1;   // рядки йдуть згори вниз — витісняємо вищий
+    if (rp->tag[slot] == keep) slot ^= 1;
+    const Uint32* r = sp + (size_t)sy * spitch;
+    Uint32 pad[2];
+    if (sw == 1) { pad[0] = pad[1] = r[0]; r = pad; } // stretch_row читає два сусідні пікселі
+    k->stretch_row(r, x0, wx, rp->px[slot], dw);
+    rp->tag[slot] = sy;
+    return rp->px[slot];
+}
+
+// спершу горизонталь (кожен рядок джерела — один раз), потім вертикаль — зважена сума
+// двох уже розтягнутих рядків прямо в ціль
+static bool scale_px(const Uint32* sp, int spitch, int sw, int sh,
+                     Uint32* dp, int dpitch, int dw, int dh, const SwcKernels* k) {
+    if (sw <= 0 || sh <= 0 || dw <= 0 || dh <= 0) return true;
+    size_t tab = (size_t)dw * (sizeof(int) + sizeof(Uint16));
+    tab = (tab + 15) & ~(size_t)15;
+    Uint8* mem = (Uint8*)grow(&g_scratch, &g_scratch_n, tab + 2 * (size_t)dw * sizeof(Uint32));
+    if (!mem) return false;
+    int*    x0 = (int*)mem;
+    Uint16* wx = (Uint16*)(x0 + dw);
+    for (int i = 0; i < dw; ++i) {
+        int s, w;
+        map_axis(i, dw, sw, &s, &w);
+        if (s == sw - 1 && sw > 1) { s = sw - 2; w = 256; } // правий край: сусід x0 + 1 лишається в рядку
+        x0[i] = s; wx[i] = (Uint16)w;
+    }
+    RowPair rp = { { (Uint32*)(mem + tab), (Uint32*)(mem + tab) + dw }, { -1, -1 } };
+    for (int y = 0; y < dh; ++y) {
+        int sy, wy;
+        map_axis(y, dh, sh, &sy, &wy);
+        Uint32* out = dp + (size_t)y * dpitch;
+        const Uint32* a = hrow(&rp, sy, -1, sp, spitch, sw, x0, wx, dw, k);
+        if (wy == 0) { memcpy(out, a, (size_t)dw * sizeof(Uint32)); continue; }
+        const Uint32* b = hrow(&rp, sy + 1, sy, sp, spitch, sw, x0, wx, dw, k);
+        k->lerp_rows(a, b, out, dw, wy);
+    }
+    return true;
+}
+
+bool swc_scale(const SDL_Surface* src, const SDL_Rect* sr, SDL_Surface* dst, const SDL_Rect* dr, const SwcKernels* k) {
+    if (!src || !dst || !fmt_ok(src->format) || src->format->format != dst->format->format) return false;
+    SDL_Rect s = sr ? *sr : (SDL_Rect){ 0, 0, src->w, src->h };
+    SDL_Rect d = dr ? *dr : (SDL_Rect){ 0, 0, dst->w, dst->h };
+    if (s.x < 0 || s.y < 0 || s.x + s.w > src->w || s.y + s.h > src->h ||
+        d.x < 0 || d.y < 0 || d.x + d.w > dst->w || d.y + d.h > dst->h) return false;
+
+    SDL_Surface* ms = (SDL_Surface*)src; // блокування не змінює пікселів
+    if (SDL_MUSTLOCK(ms) && SDL_LockSurface(ms) != 0) return false;
+    if (SDL_MUSTLOCK(dst) && SDL_LockSurface(dst) != 0) { if (SDL_MUSTLOCK(ms)) SDL_UnlockSurface(ms); return false; }
+    bool ok = scale_px((const Uint32*)((const Uint8*)src->pixels + (size_t)s.y * src->pitch) + s.x, src->pitch / 4, s.w, s.h,
+                       (Uint32*)((Uint8*)dst->pixels + (size_t)d.y * dst->pitch) + d.x, dst->pitch / 4, d.w, d.h, k);
+    if (SDL_MUSTLOCK(dst)) SDL_UnlockSurface(dst);
+    if (SDL_MUSTLOCK(ms)) SDL_UnlockSurface(ms);
+    return ok;
+}
+
+// ---------- кадр програмного рендерера ----------
+
+static SDL_Renderer* g_r = NULL;
+static SDL_Window*   g_win = NULL;
+static bool          g_on = false;
+static SwcKernels    g_k;
+
+bool swc_init(SDL_Renderer* r, SDL_Window* w, bool enabled) {
+    g_r = r; g_win = w; g_on = false;
+    swc_kernels(swc_best_kind(), &g_k);
+    SDL_RendererInfo info;
+    if (!enabled || !r || !w || SDL_GetRendererInfo(r, &info) != 0 || !(info.flags & SDL_RENDERER_SOFTWARE)) return false;
+    SDL_Surface* s = SDL_GetWindowSurface(w); // програмний рендерер малює саме в неї
+    if (!s || !fmt_ok(s->format)) {
+        SDL_Log("swcomp: window surface %s is not supported, using SDL blending",
+                s ? SDL_GetPixelFormatName(s->format->format) : SDL_GetError());
+        return false;
+    }
+    g_on = true;
+    SDL_Log("swcomp: software renderer, CPU compositing with %s", g_k.name);
+    return true;
+}
+
+void swc_shutdown(void) {
+    free(g_scratch);
+    free(g_corner);
+    g_scratch = NULL; g_scratch_n = 0;
+    g_corner = NULL; g_corner_n = 0;
+    g_r = NULL; g_win = NULL; g_on = false;
+}
+
+bool swc_active(void) { return g_on; }
+
+// поверхня вікна з усім, що вже намальовано; NULL — зараз ціль рендера текстура
+static SDL_Surface* frame_surface(void) {
+    if (!g_on || SDL_GetRenderTarget(g_r)) return NULL;
+    prim_flush();           // пакет примітивів лягає раніше за нашу заливку
+    SDL_RenderFlush(g_r);   // і все, що SDL ще тримає в черзі команд
+    return SDL_GetWindowSurface(g_win);
+}
+
+bool swc_fill_view(SDL_Color c) {
+    SDL_Surface* s = frame_surface();
+    if (!s) return false;
+    SDL_Rect vp;
+    SDL_RenderGetViewport(g_r, &vp);
+    return swc_fill(s, &vp, c, &g_k);
+}
+
+bool swc_stretch_corner(int ow, int oh) {
+    SDL_Surface* s = frame_surface();
+    if (!s || !fmt_ok(s->format) || ow <= 0 || oh <= 0 || ow > s->w || oh > s->h) return false;
+    if (ow == s->w && oh == s->h) return true;
+
+    // розтягування пише поверх джерела — спершу копія кута
+    const size_t row = (size_t)ow * sizeof(Uint32);
+    Uint32* copy = (Uint32*)grow(&g_corner, &g_corner_n, row * oh);
+    if (!copy) return false;
+    if (SDL_MUSTLOCK(s) && SDL_LockSurface(s) != 0) return false;
+    for (int y = 0; y < oh; ++y) memcpy((Uint8*)copy + row * y, (const Uint8*)s->pixels + (size_t)y * s->pitch, row);
+    bool ok = scale_px(copy, ow, ow, oh, (Uint32*)s->pixels, s->pitch / 4, s->w, s->h, &g_k);
+    if (SDL_MUSTLOCK(s)) SDL_UnlockSurface(s);
+    return ok;
+}
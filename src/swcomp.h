@@ -0,0 +1,49 @@
+#ifndef HYDRANGEA_SWCOMP_H
+#define HYDRANGEA_SWCOMP_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+// Композитинг на CPU для програмного рендерера (машини без GPU): напівпрозорі заливки
+// на весь екран, fade і розтягування світу зі зниженої роздільності йдуть прямо в
+// поверхню вікна SIMD-ядрами (AVX2 / SSE2 / NEON, скалярний запасний варіант),
+// вибраними під процесор під час запуску. Із GPU-рендерером модуль нічого не робить.
+//
+// Заливка рахується рівно як SDL_BLENDMODE_BLEND у програмному рендері:
+// d = d * (255 - a) / 255 + c * a / 255 (обидва ділення цілі); fade — заливка чорним.
+
+typedef enum { SWC_SCALAR = 0, SWC_SSE2, SWC_AVX2, SWC_NEON, SWC_KIND_COUNT } SwcKind;
+
+// Ядра над 32-бітними пікселями з 8-бітними каналами (порядок каналів не важливий).
+// pitch — у пікселях. premul — колір, уже помножений на a (усі 4 байти), inva = 255 - a,
+// mask — біти, що лишаються в результаті (без альфа-каналу зайвий байт обнуляється).
+// lerp_rows: out = (a * (256 - w) + b * w) >> 8, w = 0..255.
+// stretch_row: out[i] = v[x0[i]] і v[x0[i] + 1] у пропорції (256 - wx[i]) : wx[i], wx = 0..256.
+typedef struct {
+    const char* name;
+    void (*fill)(Uint32* px, int pitch, int w, int h, Uint32 premul, Uint8 inva, Uint32 mask);
+    void (*lerp_rows)(const Uint32* a, const Uint32* b, Uint32* out, int n, int w);
+    void (*stretch_row)(const Uint32* v, const int* x0, const Uint16* wx, Uint32* out, int n);
+} SwcKernels;
+
+// false — цей набір недоступний (збірка чи процесор)
+bool swc_kernels(SwcKind kind, SwcKernels* out);
+SwcKind swc_best_kind(void);
+
+// над довільними поверхнями (32 біт/піксель); false — формат не підходить
+bool swc_fill(SDL_Surface* s, const SDL_Rect* r, SDL_Color c, const SwcKernels* k);
+// білінійне розтягування; src і dst не перекриваються
+bool swc_scale(const SDL_Surface* src, const SDL_Rect* sr, SDL_Surface* dst, const SDL_Rect* dr, const SwcKernels* k);
+
+// вмикається лише для програмного рендерера з поверхнею вікна придатного формату
+bool swc_init(SDL_Renderer* r, SDL_Window* w, bool enabled);
+void swc_shutdown(void);
+bool swc_active(void);
+
+// Заливка поточного viewport, якщо малюємо прямо у вікно (не в текстуру-ціль).
+// false — зробити звичайним шляхом (prim / SDL_RenderFillRect).
+bool swc_fill_view(SDL_Color c);
+// ow x oh у лівому верхньому куті кадру -> на весь кадр (світ при render_scale < 1)
+bool swc_stretch_corner(int ow, int oh);
+
+#endif /* HYDRANGEA_SWCOMP_H */
@@ -0,0 +1,369 @@
+#include "texcache.h"
+#include "imgcache.h"
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    char path[128];
+    SDL_Texture* tex;     // NULL — ще передзавантажується
+    int src_w, src_h;     // розмір оригінального PNG
+    int tex_w, tex_h;     // розмір текстури, що зараз у VRAM
+    int want_w, want_h;   // варіант, який уже замовили у воркера (0 = нічого)
+    Uint32 gen;           // номер останнього замовлення (старі результати відкидаємо)
+    Uint32 serial;        // номер поточної tex: новий на кожну заміну (див. texcache_serial)
+} TexCacheEntry;
+
+typedef struct ScaleJob {
+    char path[128];
+    Uint32 gen;
+    int w, h;             // 0 — передзавантаження: розмір визначить воркер під out_w x out_h
+    int out_w, out_h;
+    int src_w, src_h;
+    SDL_Surface* src;     // вже декодований оригінал або NULL (тоді декодуємо з диска)
+    SDL_Surface* out;
+    struct ScaleJob* next;
+} ScaleJob;
+
+static TexCacheEntry g_tex_cache[16];
+static int g_tex_cache_n = 0;
+static SDL_Renderer* g_tex_renderer = NULL;
+static int g_out_w = 0, g_out_h = 0;
+static Uint32 g_gen = 0;
+static Uint32 g_serial = 0;
+static TexRankFn g_rank = NULL;    // хто витісняється, коли кеш повний (residency)
+static void*     g_rank_user = NULL;
+
+static SDL_Thread* g_worker = NULL;
+static SDL_mutex*  g_mx = NULL;
+static SDL_cond*   g_cv = NULL;
+static bool        g_quit = false;
+static ScaleJob*   g_todo = NULL;   // FIFO
+static ScaleJob*   g_done = NULL;
+
+void texcache_key(const char* relpath, char* out, size_t n) {
+    if (SDL_strncasecmp(relpath, "assets/", 7) == 0) {
+        SDL_snprintf(out, n, "%s", relpath);
+    } else {
+        SDL_snprintf(out, n, "assets/%s", relpath);
+    }
+}
+
+// розмір, у якому фон займе вікно (як у render_bg_fit), але не більше оригіналу
+static void fit_size(int src_w, int src_h, int out_w, int out_h, int* w, int* h) {
+    *w = src_w; *h = src_h;
+    if (out_w <= 0 || out_h <= 0 || src_w <= 0 || src_h <= 0) return;
+    float s = SDL_min((float)out_w/src_w, (float)out_h/src_h);
+    if (s >= 1.f) return;
+    *w = SDL_max(1, (int)(src_w * s + 0.5f));
+    *h = SDL_max(1, (int)(src_h * s + 0.5f));
+}
+
+// Зменшення з якістю: ділимо навпіл, поки різниця більша за 2x, далі — білінійно до цілі
+static SDL_Surface* scale_surface(SDL_Surface* src, int w, int h) {
+    SDL_Surface* cur = SDL_ConvertSurfaceFormat(src, SDL_PIXELFORMAT_ARGB8888, 0);
+    if (!cur) return NULL;
+    while (cur->w != w || cur->h != h) {
+        int nw = (cur->w > w*2) ? cur->w/2 : w;
+        int nh = (cur->h > h*2) ? cur->h/2 : h;
+        SDL_Surface* next = SDL_CreateRGBSurfaceWithFormat(0, nw, nh, 32, SDL_PIXELFORMAT_ARGB8888);
+        if (!next) break;
+        if (SDL_SoftStretchLinear(cur, NULL, next, NULL) != 0) SDL_BlitScaled(cur, NULL, next, NULL);
+        SDL_FreeSurface(cur);
+        cur = next;
+    }
+    return cur;
+}
+
+static SDL_Surface* make_variant(ScaleJob* j) {
+    if (!j->w) { // передзавантаження: розмір оригіналу стане відомий лише після декодування
+        j->src = imgcache_load(j->path);
+        if (!j->src) { SDL_Log("texcache: prefetch %s: %s", j->path, SDL_GetError()); return NULL; }
+        j->src_w = j->src->w; j->src_h = j->src->h;
+        fit_size(j->src_w, j->src_h, j->out_w, j->out_h, &j->w, &j->h);
+    }
+    // готовий варіант з дискового кешу: ні декодування, ні масштабування
+    if (j->w != j->src_w || j->h != j->src_h) {
+        SDL_Surface* hit = imgcache_fetch(j->path, j->w, j->h);
+        if (hit) { imgcache_free_surface(j->src); j->src = NULL; return hit; }
+    }
+
+    SDL_Surface* src = j->src ? j->src : imgcache_load(j->path);
+    j->src = NULL;
+    if (!src) { SDL_Log("texcache: load %s: %s", j->path, SDL_GetError()); return NULL; }
+    if (src->w == j->w && src->h == j->h) return src;
+    SDL_Surface* out = scale_surface(src, j->w, j->h);
+    imgcache_free_surface(src);
+    if (out) imgcache_store(j->path, j->w, j->h, out);
+    return out;
+}
+
+static int scale_worker(void* ud) {
+    (void)ud;
+    SDL_LockMutex(g_mx);
+    for (;;) {
+        while (!g_quit && !g_todo) SDL_CondWait(g_cv, g_mx);
+        if (g_quit) break;
+        ScaleJob* j = g_todo; g_todo = j->next;
+        SDL_UnlockMutex(g_mx);
+
+        j->out = make_variant(j);
+
+        SDL_LockMutex(g_mx);
+        j->next = g_done; g_done = j;
+    }
+    SDL_UnlockMutex(g_mx);
+    return 0;
+}
+
+static void free_jobs(ScaleJob* j) {
+    while (j) {
+        ScaleJob* n = j->next;
+        imgcache_free_surface(j->src);
+        imgcache_free_surface(j->out);
+        free(j);
+        j = n;
+    }
+}
+
+// src (якщо є) переходить у власність воркера; w = h = 0 — передзавантажити «під вікно»
+static void request_variant(TexCacheEntry* e, int w, int h, SDL_Surface* src) {
+    if (!g_worker) { imgcache_free_surface(src); return; }
+    ScaleJob* j = (ScaleJob*)calloc(1, sizeof(ScaleJob));
+    if (!j) { imgcache_free_surface(src); return; }
+    SDL_snprintf(j->path, sizeof(j->path), "%s", e->path);
+    j->src_w = e->src_w; j->src_h = e->src_h;
+    j->gen = e->gen = ++g_gen;
+    j->w = e->want_w = w;
+    j->h = e->want_h = h;
+    j->out_w = g_out_w; j->out_h = g_out_h;
+    j->src = src;
+
+    SDL_LockMutex(g_mx);
+    ScaleJob** tail = &g_todo;
+    while (*tail) tail = &(*tail)->next;
+    *tail = j;
+    SDL_CondSignal(g_cv);
+    SDL_UnlockMutex(g_mx);
+}
+
+// прибрати з черги замовлення, яке воркер ще не взяв (його результат уже не потрібен)
+static void cancel_job(Uint32 gen) {
+    if (!g_worker || !gen) return;
+    SDL_LockMutex(g_mx);
+    for (ScaleJob** p = &g_todo; *p; p = &(*p)->next) {
+        if ((*p)->gen != gen) continue;
+        ScaleJob* j = *p;
+        *p = j->next;
+        j->next = NULL;
+        free_jobs(j);
+        break;
+    }
+    SDL_UnlockMutex(g_mx);
+}
+
+bool texcache_init(SDL_Renderer* r) {
+    g_tex_renderer = r;
+    g_quit = false;
+    g_mx = SDL_CreateMutex();
+    g_cv = SDL_CreateCond();
+    if (g_mx && g_cv) g_worker = SDL_CreateThread(scale_worker, "texcache", NULL);
+    if (!g_worker) SDL_Log("texcache: no worker thread, backgrounds stay full-size: %s", SDL_GetError());
+    return g_worker != NULL;
+}
+
+void texcache_shutdown(void) {
+    if (g_worker) {
+        SDL_LockMutex(g_mx);
+        g_quit = true;
+        SDL_CondSignal(g_cv);
+        SDL_UnlockMutex(g_mx);
+        SDL_WaitThread(g_worker, NULL);
+        g_worker = NULL;
+    }
+    free_jobs(g_todo); g_todo = NULL;
+    free_jobs(g_done); g_done = NULL;
+    if (g_cv) { SDL_DestroyCond(g_cv); g_cv = NULL; }
+    if (g_mx) { SDL_DestroyMutex(g_mx); g_mx = NULL; }
+
+    for (int i=0;i<g_tex_cache_n;i++) if (g_tex_cache[i].tex) SDL_DestroyTexture(g_tex_cache[i].tex);
+    g_tex_cache_n = 0;
+    g_tex_renderer = NULL;
+    g_rank = NULL; g_rank_user = NULL;
+}
+
+static TexCacheEntry* find(const char* path) {
+    for (int i=0;i<g_tex_cache_n;i++)
+        if (SDL_strcasecmp(g_tex_cache[i].path, path) == 0)
+            return &g_tex_cache[i];
+    return NULL;
+}
+
+static TexCacheEntry* add_entry(const char* path) {
+    if (g_tex_cache_n >= (int)(sizeof g_tex_cache/sizeof g_tex_cache[0])) return NULL;
+    TexCacheEntry* e = &g_tex_cache[g_tex_cache_n++];
+    memset(e, 0, sizeof(*e));
+    SDL_snprintf(e->path, sizeof(e->path), "%s", path);
+    return e;
+}
+
+static void drop(int i) {
+    TexCacheEntry* e = &g_tex_cache[i];
+    cancel_job(e->gen);
+    if (e->tex) SDL_DestroyTexture(e->tex);
+    g_tex_cache[i] = g_tex_cache[--g_tex_cache_n];
+}
+
+// кеш повний: звільнити місце під path. Першим іде запис з найбільшим рангом
+// (residency: поза планом, далі — найдальший); за рівних — ще не завантажений
+static TexCacheEntry* add_entry_evicting(const char* path) {
+    TexCacheEntry* e = add_entry(path);
+    if (e || g_tex_cache_n == 0) return e;
+    int victim = 0, best = -1;
+    for (int i=0;i<g_tex_cache_n;i++) {
+        int rank = g_rank ? g_rank(g_tex_cache[i].path, g_rank_user) : 0;
+        int score = rank * 2 + (g_tex_cache[i].tex ? 0 : 1);
+        if (score > best) { best = score; victim = i; }
+    }
+    SDL_Log("tex cache: full, evict %s for %s", g_tex_cache[victim].path, path);
+    drop(victim);
+    return add_entry(path);
+}
+
+// декодований surface -> запис кешу; surface забираємо
+static SDL_Texture* insert(const char* path, SDL_Surface* s) {
+    SDL_Texture* t = SDL_CreateTextureFromSurface(g_tex_renderer, s);
+    if (!t) { imgcache_free_surface(s); return NULL; }
+
+    // передзавантаження ще в дорозі — займаємо його запис (gen = 0: його результат застарів)
+    // без запису текстуру ніхто б не звільнив, тож кеш звільняє місце сам
+    TexCacheEntry* e = find(path);
+    if (!e) e = add_entry_evicting(path);
+    if (!e) {
+        SDL_DestroyTexture(t);
+        imgcache_free_surface(s);
+        return NULL;
+    }
+    cancel_job(e->gen);
+    e->gen = 0;
+    e->want_w = e->want_h = 0;
+    e->tex = t;
+    e->serial = ++g_serial;
+    e->src_w = e->tex_w = s->w;
+    e->src_h = e->tex_h = s->h;
+
+    // показуємо повнорозмірну одразу, а зменшений варіант готуємо з уже декодованого surface
+    int w, h; fit_size(e->src_w, e->src_h, g_out_w, g_out_h, &w, &h);
+    if (w != e->tex_w || h != e->tex_h) request_variant(e, w, h, s);
+    else imgcache_free_surface(s);
+    return t;
+}
+
+SDL_Texture* texcache_get(const char* relpath) {
+    if (!relpath || !*relpath || !g_tex_renderer) return NULL;
+
+    char path[256];
+    texcache_key(relpath, path, sizeof(path));
+    TexCacheEntry* hit = find(path);
+    if (hit && hit->tex) return hit->tex;
+
+    SDL_Surface* s = imgcache_load(path); // передзавантаження не встигло — вантажимо тут
+    if (!s) { SDL_Log("IMG_Load(%s): %s", path, SDL_GetError()); return NULL; }
+    return insert(path, s);
+}
+
+SDL_Texture* texcache_adopt(const char* relpath, SDL_Surface* s) {
+    if (!s) return NULL;
+    if (!relpath || !*relpath || !g_tex_renderer) { imgcache_free_surface(s); return NULL; }
+
+    char path[256];
+    texcache_key(relpath, path, sizeof(path));
+    TexCacheEntry* hit = find(path);
+    if (hit && hit->tex) { imgcache_free_surface(s); return hit->tex; }
+    return insert(path, s);
+}
+
+bool texcache_prefetch(const char* relpath) {
+    if (!relpath || !*relpath || !g_tex_renderer || !g_worker) return false;
+
+    char path[256];
+    texcache_key(relpath, path, sizeof(path));
+    if (find(path)) return true;
+    TexCacheEntry* e = add_entry(path);
+    if (!e) return false;
+    request_variant(e, 0, 0, NULL);
+    return true;
+}
+
+void texcache_set_rank(TexRankFn rank, void* user) {
+    g_rank = rank;
+    g_rank_user = user;
+}
+
+Uint32 texcache_serial(const SDL_Texture* t) {
+    if (!t) return 0;
+    for (int i=0;i<g_tex_cache_n;i++)
+        if (g_tex_cache[i].tex == t) return g_tex_cache[i].serial;
+    return 0;
+}
+
+int texcache_capacity(void) {
+    return (int)(sizeof g_tex_cache/sizeof g_tex_cache[0]);
+}
+
+void texcache_set_output_size(int w, int h) {
+    if (w == g_out_w && h == g_out_h) return;
+    g_out_w = w; g_out_h = h;
+    for (int i=0;i<g_tex_cache_n;i++) {
+        TexCacheEntry* e = &g_tex_cache[i];
+        if (!e->tex) { // передзавантаження — наново, під новий розмір
+            cancel_job(e->gen);
+            request_variant(e, 0, 0, NULL);
+            continue;
+        }
+        int vw, vh; fit_size(e->src_w, e->src_h, w, h, &vw, &vh);
+        if (e->want_w || e->want_h) {
+            if (vw == e->want_w && vh == e->want_h) continue;
+        } else if (vw == e->tex_w && vh == e->tex_h) continue;
+        request_variant(e, vw, vh, NULL);
+    }
+}
+
+void texcache_pump(SDL_Texture** watch) {
+    if (!g_worker) return;
+    SDL_LockMutex(g_mx);
+    ScaleJob* done = g_done; g_done = NULL;
+    SDL_UnlockMutex(g_mx);
+
+    for (ScaleJob* j = done; j; j = j->next) {
+        for (int i=0;i<g_tex_cache_n;i++) {
+            TexCacheEntry* e = &g_tex_cache[i];
+            if (e->gen != j->gen || SDL_strcasecmp(e->path, j->path) != 0) continue;
+
+            SDL_Texture* t = j->out ? SDL_CreateTextureFromSurface(g_tex_renderer, j->out) : NULL;
+            if (t) {
+                if (e->tex) {
+                    if (watch && *watch == e->tex) *watch = t;
+                    SDL_DestroyTexture(e->tex); // повнорозмірна більше не потрібна
+                } else {
+                    e->src_w = j->src_w; e->src_h = j->src_h;
+                }
+                e->tex = t;
+                e->serial = ++g_serial;
+                e->tex_w = j->out->w; e->tex_h = j->out->h;
+            }
+            e->want_w = e->want_h = 0;
+            if (!e->tex) g_tex_cache[i] = g_tex_cache[--g_tex_cache_n]; // передзавантаження не вдалося
+            break;
+        }
+    }
+    free_jobs(done);
+}
+
+void texcache_evict_if(TexKeepFn keep, void* user, SDL_Texture* pinned) {
+    for (int i = 0; i < g_tex_cache_n; ) {
+        TexCacheEntry* e = &g_tex_cache[i];
+        if ((e->tex && e->tex == pinned) || keep(e->path, user)) { ++i; continue; }
+        SDL_Log("tex cache: evict %s%s", e->path, e->tex ? "" : " (prefetch)");
+        drop(i);
+    }
+}
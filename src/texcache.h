@@ -0,0 +1,44 @@
+#ifndef HYDRANGEA_TEXCACHE_H
+#define HYDRANGEA_TEXCACHE_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+// Кеш текстур фонів. Кожна текстура тримається в розмірі «під вікно»:
+// після завантаження (і на кожен resize) фоновий потік готує зменшений варіант,
+// а головний потік у texcache_pump() підміняє ним повнорозмірну текстуру.
+// Що тримати в кеші, вирішує residency.c (сусідство поточної сцени).
+
+typedef bool (*TexKeepFn)(const char* key, void* user);
+// ранг для витіснення, коли кеш повний: більший — звільняється першим
+typedef int  (*TexRankFn)(const char* key, void* user);
+
+bool         texcache_init(SDL_Renderer* r);
+void         texcache_shutdown(void);
+
+// relpath відносно assets/ (префікс "assets/" можна не писати)
+SDL_Texture* texcache_get(const char* relpath);
+// те саме, але картинку вже декодовано (imgcache_load в іншому потоці); surface забирає кеш
+SDL_Texture* texcache_adopt(const char* relpath, SDL_Surface* s);
+void         texcache_key(const char* relpath, char* out, size_t n);
+// декодувати й зменшити у фоні; false — кеш повний або немає воркера
+bool         texcache_prefetch(const char* relpath);
+int          texcache_capacity(void);
+// номер вмісту текстури з кешу, новий на кожну заміну; 0 — не з кешу.
+// Для ключів шарів замість адреси: адресу знищеної текстури SDL може віддати наступній
+Uint32       texcache_serial(const SDL_Texture* t);
+
+// розмір виводу змінився -> перебудувати варіанти, що не пасують
+void         texcache_set_output_size(int w, int h);
+
+// головний потік, раз на кадр: залити готові варіанти. *watch оновлюється, якщо його текстуру замінено
+void         texcache_pump(SDL_Texture** watch);
+
+// texcache_get/adopt у повний кеш витісняють запис з найбільшим rank (без rank — будь-який);
+// повернута текстура завжди належить кешу
+void         texcache_set_rank(TexRankFn rank, void* user);
+
+// звільнити все, для чого keep() повертає false (pinned не чіпаємо)
+void         texcache_evict_if(TexKeepFn keep, void* user, SDL_Texture* pinned);
+
+#endif /* HYDRANGEA_TEXCACHE_H */
@@ -0,0 +1,135 @@
+#include "tween.h"
+#include <string.h>
+
+#define TWEEN_MAX 256
+
+enum { TW_LIVE = 1, TW_FOLLOW = 2, TW_PAUSED = 4 };
+
+// структура масивів: прохід у tween_update читає лише те, що йому треба, підряд
+static float* g_out[TWEEN_MAX];
+static float  g_from[TWEEN_MAX];
+static float  g_to[TWEEN_MAX];     // для follow — ціль
+static float  g_t[TWEEN_MAX];      // 0..1 по кривій
+static float  g_inv[TWEEN_MAX];    // 1/dur; для follow — швидкість
+static Uint8  g_ease[TWEEN_MAX];
+static Uint8  g_flags[TWEEN_MAX];
+static Uint16 g_gen[TWEEN_MAX];
+
+static Uint16 g_free[TWEEN_MAX];   // стек вільних слотів
+static int    g_free_n = -1;       // -1 — пул ще не ініціалізовано
+static int    g_hi;                // вище за цей індекс живих немає
+static int    g_live;
+
+static float ease(Ease e, float t) {
+    switch (e) {
+    case EASE_IN_QUAD:     return t * t;
+    case EASE_OUT_QUAD:    return t * (2.f - t);
+    case EASE_IN_OUT_QUAD: return t < 0.5f ? 2.f * t * t : 1.f - 2.f * (1.f - t) * (1.f - t);
+    case EASE_OUT_CUBIC:   { float u = 1.f - t; return 1.f - u * u * u; }
+    default:               return t;
+    }
+}
+
+void tween_reset(void) {
+    memset(g_flags, 0, sizeof(g_flags));
+    memset(g_out, 0, sizeof(g_out));
+    // менші індекси — нагорі стеку: живі тісняться на початку, прохід коротший
+    for (int i = 0; i < TWEEN_MAX; ++i) g_free[i] = (Uint16)(TWEEN_MAX - 1 - i);
+    g_free_n = TWEEN_MAX;
+    g_hi = 0;
+    g_live = 0;
+}
+
+static int slot_of(TweenId id) {
+    const int i = (int)(id & 0xFFFF) - 1;
+    if (id == 0 || i < 0 || i >= TWEEN_MAX) return -1;
+    if (!(g_flags[i] & TW_LIVE) || g_gen[i] != (Uint16)(id >> 16)) return -1;
+    return i;
+}
+
+static int alloc(void) {
+    if (g_free_n < 0) tween_reset();
+    if (g_free_n == 0) { SDL_Log("tween: pool full (%d)", TWEEN_MAX); return -1; }
+    const int i = g_free[--g_free_n];
+    ++g_gen[i];
+    g_flags[i] = TW_LIVE;
+    if (i >= g_hi) g_hi = i + 1;
+    ++g_live;
+    return i;
+}
+
+static void release(int i) {
+    g_flags[i] = 0;
+    g_out[i] = NULL;
+    g_free[g_free_n++] = (Uint16)i;
+    --g_live;
+    while (g_hi > 0 && !(g_flags[g_hi - 1] & TW_LIVE)) --g_hi;
+}
+
+static TweenId id_of(int i) { return (TweenId)g_gen[i] << 16 | (TweenId)(i + 1); }
+
+TweenId tween_start(float* out, float from, float to, float dur, Ease e) {
+    if (!out) return 0;
+    if (dur <= 0.f) { *out = to; return 0; }
+    const int i = alloc();
+    if (i < 0) { *out = to; return 0; }
+    g_out[i] = out;
+    g_from[i] = from;
+    g_to[i] = to;
+    g_t[i] = 0.f;
+    g_inv[i] = 1.f / dur;
+    g_ease[i] = (Uint8)((unsigned)e < EASE_COUNT ? e : EASE_LINEAR);
+    *out = from;
+    return id_of(i);
+}
+
+TweenId tween_follow(float* out, float target, float rate) {
+    if (!out) return 0;
+    const int i = alloc();
+    if (i < 0) { *out = target; return 0; }
+    g_out[i] = out;
+    g_to[i] = target;
+    g_inv[i] = rate;
+    g_flags[i] |= TW_FOLLOW;
+    return id_of(i);
+}
+
+void tween_retarget(TweenId id, float target) {
+    const int i = slot_of(id);
+    if (i >= 0 && (g_flags[i] & TW_FOLLOW)) g_to[i] = target;
+}
+
+void tween_pause(TweenId id, bool paused) {
+    const int i = slot_of(id);
+    if (i < 0) return;
+    if (paused) g_flags[i] |= TW_PAUSED;
+    else        g_flags[i] &= (Uint8)~TW_PAUSED;
+}
+
+void tween_cancel(TweenId id) {
+    const int i = slot_of(id);
+    if (i >= 0) release(i);
+}
+
+bool tween_active(TweenId id) { return slot_of(id) >= 0; }
+
+void tween_update(float dt) {
+    if (dt <= 0.f) return;
+    const int hi = g_hi;
+    for (int i = 0; i < hi; ++i) {
+        const Uint8 f = g_flags[i];
+        if ((f & (TW_LIVE | TW_PAUSED)) != TW_LIVE) continue;
+        float* out = g_out[i];
+        if (f & TW_FOLLOW) { // як approachf: сталий крок до цілі
+            const float diff = g_to[i] - *out, step = g_inv[i] * dt;
+            *out = diff > step ? *out + step : diff < -step ? *out - step : g_to[i];
+            continue;
+        }
+        const float t = g_t[i] + dt * g_inv[i];
+        if (t >= 1.f) { *out = g_to[i]; release(i); continue; } // рівно в ціль, без похибки кривої
+        g_t[i] = t;
+        *out = g_from[i] + (g_to[i] - g_from[i]) * ease((Ease)g_ease[i], t);
+    }
+}
+
+int tween_count(void) { return g_live < 0 ? 0 : g_live; }
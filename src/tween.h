@@ -0,0 +1,39 @@
+#ifndef HYDRANGEA_TWEEN_H
+#define HYDRANGEA_TWEEN_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+// Усі анімації гри — в одному пулі: fade, бари статів, нотифікації, таймер auto_next.
+// Твін рухає чужий float (out) одним із двох способів:
+//   крива  — from -> to за dur секунд з easing; після кінця слот звільняється;
+//   follow — без кінця: до цілі, яку можна міняти щокадру, зі сталою швидкістю (од./с).
+// Пул — структура масивів фіксованого розміру; tween_update — один прохід по ньому.
+// Власник out має жити, поки твін активний (або скасувати його).
+
+typedef Uint32 TweenId;   // 0 — немає; у id є покоління, тож застарілий id нічого не зачепить
+
+typedef enum {
+    EASE_LINEAR = 0,
+    EASE_IN_QUAD,         // повільний старт
+    EASE_OUT_QUAD,        // повільний кінець
+    EASE_IN_OUT_QUAD,
+    EASE_OUT_CUBIC,
+    EASE_COUNT
+} Ease;
+
+void    tween_reset(void);   // скасувати все
+
+// dur <= 0 — одразу to. 0, якщо пул повний (тоді *out = to одразу)
+TweenId tween_start(float* out, float from, float to, float dur, Ease ease);
+TweenId tween_follow(float* out, float target, float rate);
+void    tween_retarget(TweenId id, float target);   // лише для follow
+
+void    tween_pause(TweenId id, bool paused);
+void    tween_cancel(TweenId id);                   // *out лишається як є
+bool    tween_active(TweenId id);                   // крива ще йде (або це живий follow)
+
+void    tween_update(float dt);
+int     tween_count(void);
+
+#endif /* HYDRANGEA_TWEEN_H */
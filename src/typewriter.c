@@ -0,0 +1,233 @@
+#include "typewriter.h"
+#include "font.h"
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct { int a, b; int xoff; } TwLine;   // байти [a, b) і зсув рядка в текстурі
+
+static SDL_Renderer* g_r = NULL;
+
+static char*  g_text = NULL;
+static int    g_total = 0;      // кодпоінтів без '\n'
+static float  g_shown = 0.f;
+
+// розкладка
+static bool         g_valid = false;
+static float        g_size = 0.f;
+static int          g_max_w = 0;
+static bool         g_center = false;
+static SDL_Texture* g_tex = NULL;
+static int          g_tex_w = 0, g_skip = 0, g_lines = 0;
+static int*         g_gline = NULL;   // рядок символу
+static int*         g_gx0 = NULL;     // лівий край символу в текстурі
+static int*         g_gx1 = NULL;     // правий край
+
+static int utf8_len(unsigned char c) {
+    if (c < 0x80) return 1;
+    if ((c & 0xE0) == 0xC0) return 2;
+    if ((c & 0xF0) == 0xE0) return 3;
+    if ((c & 0xF8) == 0xF0) return 4;
+    return 1; // битий байт — як окремий символ
+}
+
+static int count_glyphs(const char* s) {
+    int n = 0;
+    for (const char* p = s; *p; p += utf8_len((unsigned char)*p)) if (*p != '\n') ++n;
+    return n;
+}
+
+static void drop_layout(void) {
+    if (g_tex) { SDL_DestroyTexture(g_tex); g_tex = NULL; }
+    free(g_gline); free(g_gx0); free(g_gx1);
+    g_gline = g_gx0 = g_gx1 = NULL;
+    g_lines = 0; g_tex_w = 0;
+    g_valid = false;
+}
+
+bool typewriter_init(SDL_Renderer* r) {
+    g_r = r;
+    return true;
+}
+
+void typewriter_shutdown(void) {
+    drop_layout();
+    free(g_text); g_text = NULL;
+    g_total = 0; g_shown = 0.f;
+    g_size = 0.f;
+    g_r = NULL;
+}
+
+void typewriter_set_text(const char* text, bool keep_progress) {
+    if (!text) text = "";
+    const bool same = g_text && strcmp(g_text, text) == 0;
+    if (!keep_progress) g_shown = 0.f;
+    if (same) return;
+    free(g_text);
+    size_t n = strlen(text);
+    g_text = (char*)malloc(n + 1);
+    if (g_text) memcpy(g_text, text, n + 1);
+    g_total = g_text ? count_glyphs(g_text) : 0;
+    if (g_shown > (float)g_total) g_shown = (float)g_total;
+    drop_layout();
+}
+
+void typewriter_update(float dt, float chars_per_sec) {
+    if (g_shown >= (float)g_total) return;
+    if (chars_per_sec <= 0.f) { g_shown = (float)g_total; return; }
+    g_shown += dt * chars_per_sec;
+    if (g_shown > (float)g_total) g_shown = (float)g_total;
+}
+
+void typewriter_complete(void) { g_shown = (float)g_total; }
+bool typewriter_done(void)     { return g_shown >= (float)g_total; }
+
+// ширина байтів [a, b) тексту
+static int measure(int a, int b) {
+    return b > a ? font_width_n(g_size, g_text + a, b - a) : 0;
+}
+
+// жадібне перенесення по пробілах; задовге слово ріжеться по символах
+static int break_lines(TwLine* out, int cap) {
+    int n = 0, p = 0;
+    const int len = (int)strlen(g_text);
+    while (p <= len && n < cap) {
+        int para_end = p;
+        while (para_end < len && g_text[para_end] != '\n') ++para_end;
+
+        int a = p;
+        do {
+            int end = a, fit = a;
+            while (end < para_end) {
+                int e = end;
+                while (e < para_end && g_text[e] == ' ') ++e;
+                while (e < para_end && g_text[e] != ' ') e += utf8_len((unsigned char)g_text[e]);
+                if (e > para_end) e = para_end;
+                if (measure(a, e) <= g_max_w) { fit = e; end = e; continue; }
+                if (fit == a) { // навіть одне слово не влазить
+                    int c = a + utf8_len((unsigned char)g_text[a]);
+                    fit = c;
+                    while (c < e) {
+                        int nc = c + utf8_len((unsigned char)g_text[c]);
+                        if (measure(a, nc) > g_max_w) break;
+                        fit = c = nc;
+                    }
+                }
+                break;
+            }
+            out[n++] = (TwLine){ a, fit, 0 };
+            a = fit;
+            while (a < para_end && g_text[a] == ' ') ++a;   // пробіли на переносі не малюємо
+        } while (a < para_end && n < cap);
+
+        p = para_end + 1;
+    }
+    return n;
+}
+
+void typewriter_layout(float size, int max_w, bool center) {
+    if (max_w < 1) max_w = 1;
+    if (g_valid && size == g_size && max_w == g_max_w && center == g_center) return;
+    drop_layout();
+    g_size = size; g_max_w = max_w; g_center = center;
+    g_valid = true;
+    if (!g_text || !g_r) return;
+
+    const int len = (int)strlen(g_text);
+    const int cap = len + 1;             // рядків не більше, ніж байтів + 1
+    int*    edges = (int*)malloc(sizeof(int) * (size_t)cap);
+    TwLine* lines = (TwLine*)malloc(sizeof(TwLine) * (size_t)cap);
+    g_gline = (int*)malloc(sizeof(int) * (size_t)(g_total + 1));
+    g_gx0   = (int*)malloc(sizeof(int) * (size_t)(g_total + 1));
+    g_gx1   = (int*)malloc(sizeof(int) * (size_t)(g_total + 1));
+    if (!edges || !lines || !g_gline || !g_gx0 || !g_gx1) {
+        free(edges); free(lines); drop_layout(); g_valid = true;
+        return;
+    }
+
+    g_lines = g_total > 0 ? break_lines(lines, cap) : 0;
+    g_skip  = font_line_skip(size);
+    g_tex_w = max_w;
+
+    // позиції символів: усі кодпоінти по порядку; пропущені пробіли й '\n' — нульової ширини
+    int gi = 0, p = 0, last_line = 0, last_x = 0;
+    for (int li = 0; li < g_lines; ++li) {
+        TwLine* L = &lines[li];
+        int lw = measure(L->a, L->b);
+        L->xoff = center ? SDL_max(0, (max_w - lw) / 2) : 0;
+        if (li == 0) last_x = L->xoff;
+        for (; p < L->a; p += utf8_len((unsigned char)g_text[p])) {   // хвіст попереднього рядка
+            if (g_text[p] == '\n' || gi >= g_total) continue;
+            g_gline[gi] = last_line; g_gx0[gi] = g_gx1[gi] = last_x; ++gi;
+        }
+        // краї символів — з тієї ж розкладки, що й растеризація; останній точно на ширині рядка
+        const int x_end = L->xoff + lw;
+        const int ncp = font_glyph_edges(size, g_text + L->a, L->b - L->a, edges);
+        int x = L->xoff;
+        for (int c = 0; c < ncp && gi < g_total; ++c, ++gi) {
+            g_gline[gi] = li;
+            g_gx0[gi] = x;
+            x = (c == ncp - 1) ? x_end : SDL_min(L->xoff + edges[c], x_end);
+            g_gx1[gi] = x;
+        }
+        p = L->b;
+        last_line = li; last_x = x_end;
+    }
+    for (; gi < g_total; ++gi) {   // кінцеві пробіли
+        g_gline[gi] = last_line; g_gx0[gi] = g_gx1[gi] = last_x;
+    }
+
+    // растеризація: кожен рядок раз, білим (колір задається color mod при малюванні)
+    int tex_h = g_lines * g_skip;
+    if (tex_h > 0) {
+        SDL_Surface* all = SDL_CreateRGBSurfaceWithFormat(0, g_tex_w, tex_h, 32, SDL_PIXELFORMAT_ARGB8888);
+        if (all) {
+            SDL_FillRect(all, NULL, 0);
+            for (int li = 0; li < g_lines; ++li) {
+                const TwLine* L = &lines[li];
+                if (L->b <= L->a) continue;
+                SDL_Surface* s = font_render_n(size, g_text + L->a, L->b - L->a);
+                if (!s) continue;
+                SDL_SetSurfaceBlendMode(s, SDL_BLENDMODE_NONE);
+                SDL_Rect dst = { L->xoff, li * g_skip, s->w, s->h };
+                SDL_BlitSurface(s, NULL, all, &dst);
+                SDL_FreeSurface(s);
+            }
+            g_tex = SDL_CreateTextureFromSurface(g_r, all);
+            if (g_tex) SDL_SetTextureBlendMode(g_tex, SDL_BLENDMODE_BLEND);
+            else SDL_Log("typewriter: texture failed: %s", SDL_GetError());
+            SDL_FreeSurface(all);
+        }
+    }
+    free(edges); free(lines);
+}
+
+int typewriter_height(void) { return g_lines * g_skip; }
+
+void typewriter_draw(int x, int y, SDL_Color col) {
+    if (!g_tex || g_total == 0) return;
+    int n = (int)g_shown;
+    if (n > g_total) n = g_total;
+    float frac = g_shown - (float)n;
+
+    SDL_SetTextureColorMod(g_tex, col.r, col.g, col.b);
+    SDL_SetTextureAlphaMod(g_tex, col.a);
+    if (n > 0) {
+        int k = g_gline[n - 1];
+        if (k > 0) {   // усі завершені рядки — одним прямокутником
+            SDL_Rect src = { 0, 0, g_tex_w, k * g_skip };
+            SDL_Rect dst = { x, y, src.w, src.h };
+            SDL_RenderCopy(g_r, g_tex, &src, &dst);
+        }
+        SDL_Rect src = { 0, k * g_skip, g_gx1[n - 1], g_skip };
+        SDL_Rect dst = { x, y + src.y, src.w, src.h };
+        if (src.w > 0) SDL_RenderCopy(g_r, g_tex, &src, &dst);
+    }
+    if (n < g_total && frac > 0.f) {   // наступний символ проявляється
+        SDL_Rect src = { g_gx0[n], g_gline[n] * g_skip, g_gx1[n] - g_gx0[n], g_skip };
+        SDL_Rect dst = { x + src.x, y + src.y, src.w, src.h };
+        if (src.w > 0) {
+            SDL_SetTextureAlphaMod(g_tex, (Uint8)(col.a * frac));
+            SDL_RenderCopy(g_r, g_tex, &src, &dst);
+        }
+    }
+}
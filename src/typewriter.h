@@ -0,0 +1,28 @@
+#ifndef HYDRANGEA_TYPEWRITER_H
+#define HYDRANGEA_TYPEWRITER_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+// Поступова поява репліки («друкарська машинка»).
+// Текст розкладається й растеризується в одну текстуру лише при зміні тексту/розміру/ширини;
+// для кожного символу зберігається рядок і правий край. Кадр = не більше трьох RenderCopy
+// (готові рядки, поточний рядок, напівпрозорий наступний символ) незалежно від довжини.
+// Прогрес рахується в кодпоінтах і від рендеру не залежить (детермінований replay).
+
+bool typewriter_init(SDL_Renderer* r);
+void typewriter_shutdown(void);
+
+// новий показ з нуля; keep_progress (hot-reload) — той самий текст лишається як є,
+// змінений показується не далі, ніж було
+void typewriter_set_text(const char* text, bool keep_progress);
+void typewriter_update(float dt, float chars_per_sec);   // cps <= 0 -> одразу весь текст
+void typewriter_complete(void);
+bool typewriter_done(void);
+
+// розкладка під розмір шрифту й ширину (дешево, якщо нічого не змінилось); center — рядки по центру
+void typewriter_layout(float size, int max_w, bool center);
+int  typewriter_height(void);
+void typewriter_draw(int x, int y, SDL_Color col);
+
+#endif /* HYDRANGEA_TYPEWRITER_H */
@@ -0,0 +1,370 @@
+#include "ui.h"
+#include "font.h"
+#include "prim.h"
+#include <string.h>
+
+static SDL_Renderer* g_r = NULL;
+
+#define LIST_ITEM_H    34   // пункт розкритого списку
+#define LIST_ITEM_STEP 36
+#define LIST_TOP       40   // від верху заголовка до першого пункту
+#define KNOB_W 12
+#define KNOB_H 20
+
+bool ui_init(SDL_Renderer* r) {
+    g_r = r;
+    return true;
+}
+
+void ui_shutdown(void) { g_r = NULL; }
+
+void ui_tree_init(UiTree* t) {
+    memset(t, 0, sizeof(*t));
+    t->hot = t->focus = t->drag = -1;
+}
+
+void ui_tree_free(UiTree* t) {
+    for (int i = 0; i < t->count; ++i) {
+        Widget* w = &t->w[i];
+        if (w->tex) SDL_DestroyTexture(w->tex);
+        if (w->tex_list) SDL_DestroyTexture(w->tex_list);
+    }
+    ui_tree_init(t);
+}
+
+int ui_add(UiTree* t, UiKind kind, int id) {
+    if (t->count >= UI_MAX_WIDGETS) { SDL_Log("ui: widget limit reached"); return -1; }
+    Widget* w = &t->w[t->count];
+    memset(w, 0, sizeof(*w));
+    w->kind = kind;
+    w->id = id;
+    w->visible = true;
+    w->font_px = 20.f;
+    w->pad_x = w->pad_y = 10;
+    w->bg        = (SDL_Color){ 28, 32, 40, 255};
+    w->bg_active = (SDL_Color){ 40, 48, 60, 255};
+    w->border    = (SDL_Color){ 36, 42, 51, 180};
+    w->border_active = w->border;
+    w->fg        = (SDL_Color){234,239,244,255};
+    w->fg_sub    = (SDL_Color){170,178,190,255};
+    w->dirty = true;
+    t->rev++;
+    return t->count++;
+}
+
+static bool valid(const UiTree* t, int w) { return w >= 0 && w < t->count; }
+
+// вигляд віджета змінився: перемалювати його кеш і все, що з нього складено
+static void touch(UiTree* t, Widget* W) { W->dirty = true; t->rev++; }
+
+void ui_mark_dirty(UiTree* t, int w) { if (valid(t, w)) touch(t, &t->w[w]); }
+
+void ui_tree_invalidate(UiTree* t) {
+    for (int i = 0; i < t->count; ++i) t->w[i].dirty = true;
+    t->rev++;
+}
+
+Uint32 ui_tree_rev(const UiTree* t) { return t->rev; }
+
+void ui_set_rect(UiTree* t, int w, SDL_Rect r) {
+    if (!valid(t, w)) return;
+    Widget* W = &t->w[w];
+    // зсув — це лише інше місце копіювання; перемальовуємо тільки при зміні розміру
+    if (r.w != W->rect.w || r.h != W->rect.h) W->dirty = true;
+    if (memcmp(&r, &W->rect, sizeof(r)) != 0) t->rev++;
+    W->rect = r;
+}
+
+void ui_set_text(UiTree* t, int w, const char* txt) {
+    if (!valid(t, w)) return;
+    if (!txt) txt = "";
+    if (strcmp(t->w[w].text, txt) == 0) return;
+    SDL_strlcpy(t->w[w].text, txt, sizeof(t->w[w].text));
+    touch(t, &t->w[w]);
+}
+
+void ui_set_sub(UiTree* t, int w, const char* txt) {
+    if (!valid(t, w)) return;
+    if (!txt) txt = "";
+    if (strcmp(t->w[w].sub, txt) == 0) return;
+    SDL_strlcpy(t->w[w].sub, txt, sizeof(t->w[w].sub));
+    touch(t, &t->w[w]);
+}
+
+void ui_set_font(UiTree* t, int w, float px) {
+    if (!valid(t, w) || t->w[w].font_px == px) return;
+    t->w[w].font_px = px;
+    touch(t, &t->w[w]);
+}
+
+void ui_set_value(UiTree* t, int w, int v) {
+    if (!valid(t, w) || t->w[w].value == v) return;
+    t->w[w].value = v;
+    touch(t, &t->w[w]);
+}
+
+void ui_set_visible(UiTree* t, int w, bool on) {
+    if (!valid(t, w) || t->w[w].visible == on) return;
+    t->w[w].visible = on;
+    if (!on && t->hot == w) t->hot = -1;
+    t->rev++;
+}
+
+void ui_set_focus(UiTree* t, int w) {
+    if (t->focus == w) return;
+    ui_mark_dirty(t, t->focus);
+    ui_mark_dirty(t, w);
+    t->focus = w;
+}
+
+void ui_set_item(UiTree* t, int w, int i, const char* txt) {
+    if (!valid(t, w) || i < 0 || i >= UI_MAX_ITEMS) return;
+    Widget* W = &t->w[w];
+    if (i >= W->item_n) { W->item_n = i + 1; touch(t, W); }
+    if (strcmp(W->items[i], txt) == 0) return;
+    SDL_strlcpy(W->items[i], txt, sizeof(W->items[i]));
+    touch(t, W);
+}
+
+// ---- hit-test ----
+
+static bool interactive(UiKind k) {
+    return k == UI_BUTTON || k == UI_TOGGLE || k == UI_DROPDOWN || k == UI_SLIDER;
+}
+
+static SDL_Rect list_item_rect(const Widget* W, int i) {
+    return (SDL_Rect){ W->rect.x, W->rect.y + LIST_TOP + i*LIST_ITEM_STEP, W->rect.w, LIST_ITEM_H };
+}
+
+// повзунок ловимо з запасом по висоті, доріжка тонка
+static bool slider_hit(const Widget* W, SDL_Point p) {
+    const SDL_Rect* r = &W->rect;
+    return SDL_PointInRect(&p, r) ||
+           (p.x >= r->x && p.x <= r->x + r->w && p.y >= r->y - 8 && p.y <= r->y + 16);
+}
+
+static int hit(const UiTree* t, SDL_Point p) {
+    for (int i = t->count - 1; i >= 0; --i) {   // згори вниз
+        const Widget* W = &t->w[i];
+        if (!W->visible || !interactive(W->kind)) continue;
+        if (W->kind == UI_SLIDER ? slider_hit(W, p) : SDL_PointInRect(&p, &W->rect)) return i;
+    }
+    return -1;
+}
+
+void ui_hover(UiTree* t, int x, int y) {
+    int h = hit(t, (SDL_Point){ x, y });
+    if (h == t->hot) return;
+    ui_mark_dirty(t, t->hot);
+    ui_mark_dirty(t, h);
+    t->hot = h;
+}
+
+static bool slider_set(UiTree* t, Widget* W, int x) {
+    float k = SDL_clamp((x - W->rect.x) / (float)SDL_max(W->rect.w, 1), 0.f, 1.f);
+    int v = (int)(k * (float)W->vmax);
+    if (v == W->value) return false;
+    W->value = v;
+    touch(t, W);
+    return true;
+}
+
+bool ui_dispatch(UiTree* t, const SDL_Event* e, UiAction* out) {
+    out->kind = UI_ACT_NONE; out->id = -1; out->value = 0;
+
+    if (e->type == SDL_MOUSEMOTION) {
+        if (valid(t, t->drag)) {
+            Widget* W = &t->w[t->drag];
+            if (slider_set(t, W, e->motion.x)) { out->kind = UI_ACT_CHANGE; out->id = W->id; out->value = W->value; }
+            return true;
+        }
+        ui_hover(t, e->motion.x, e->motion.y);
+        return false;
+    }
+    if (e->type == SDL_MOUSEBUTTONUP && e->button.button == SDL_BUTTON_LEFT) {
+        if (t->drag < 0) return false;
+        t->drag = -1;
+        return true;
+    }
+    if (e->type != SDL_MOUSEBUTTONDOWN || e->button.button != SDL_BUTTON_LEFT) return false;
+
+    SDL_Point p = { e->button.x, e->button.y };
+
+    // розкритий список лежить поверх усього
+    for (int i = 0; i < t->count; ++i) {
+        Widget* W = &t->w[i];
+        if (!W->visible || W->kind != UI_DROPDOWN || !W->open) continue;
+        for (int k = 0; k < W->item_n; ++k) {
+            SDL_Rect r = list_item_rect(W, k);
+            if (!SDL_PointInRect(&p, &r)) continue;
+            W->value = k; W->open = false; touch(t, W);
+            out->kind = UI_ACT_CHANGE; out->id = W->id; out->value = k;
+            return true;
+        }
+    }
+
+    int i = hit(t, p);
+    if (i < 0) return false;
+    Widget* W = &t->w[i];
+    out->id = W->id;
+    switch (W->kind) {
+        case UI_BUTTON:
+            out->kind = UI_ACT_CLICK;
+            break;
+        case UI_TOGGLE:
+            W->value = !W->value; touch(t, W);
+            out->kind = UI_ACT_CHANGE; out->value = W->value;
+            break;
+        case UI_DROPDOWN:
+            W->open = !W->open; touch(t, W);
+            out->kind = UI_ACT_OPEN; out->value = W->open;
+            break;
+        case UI_SLIDER:
+            t->drag = i;
+            slider_set(t, W, p.x);
+            out->kind = UI_ACT_CHANGE; out->value = W->value;
+            break;
+        default: break;
+    }
+    return true;
+}
+
+// ---- відмальовка в кеш ----
+
+// текстура-ціль потрібного розміру (стара, якщо розмір той самий)
+static SDL_Texture* target(SDL_Texture* tex, int w, int h) {
+    if (tex) {
+        int tw, th;
+        if (SDL_QueryTexture(tex, NULL, NULL, &tw, &th) == 0 && tw == w && th == h) return tex;
+        SDL_DestroyTexture(tex);
+    }
+    if (w <= 0 || h <= 0) return NULL;
+    tex = SDL_CreateTexture(g_r, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, w, h);
+    if (!tex) { SDL_Log("ui: target texture failed: %s", SDL_GetError()); return NULL; }
+    SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
+    return tex;
+}
+
+static bool begin(SDL_Texture* tex) {
+    if (!tex || SDL_SetRenderTarget(g_r, tex) != 0) return false;
+    SDL_SetRenderDrawColor(g_r, 0, 0, 0, 0);
+    SDL_RenderClear(g_r);
+    return true;
+}
+
+// плашка з рамкою й підписом; текст лягає на непрозоре тло, тож кеш змішується без ореолів
+static void box(const Widget* W, int w, int h, bool active, const char* txt) {
+    SDL_Rect r = { 0, 0, w, h };
+    prim_rect_i(&r, active ? W->bg_active : W->bg);
+    prim_outline_i(&r, active ? W->border_active : W->border);
+    prim_flush();
+    if (!txt || !*txt) return;
+    int x = W->pad_x, y = W->pad_y;
+    if (W->center) {
+        int tw = 0, th = 0; font_size_text(W->font_px, txt, &tw, &th);
+        x = (w - tw)/2; y = (h - th)/2;
+    }
+    font_draw(W->font_px, W->fg, txt, x, y);
+    if (W->sub[0]) font_draw(W->font_px, W->fg_sub, W->sub, x, y + W->sub_dy);
+}
+
+static void render_widget(UiTree* t, int i) {
+    Widget* W = &t->w[i];
+    const bool active = (t->hot == i) || (t->hot < 0 && t->focus == i);
+
+    if (W->kind == UI_LABEL) {
+        // біла маска покриття; колір — color mod при копіюванні
+        if (W->tex) { SDL_DestroyTexture(W->tex); W->tex = NULL; }
+        W->tex_w = W->tex_h = 0;
+        if (!W->text[0]) return;
+        SDL_Surface* s = font_render_n(W->font_px, W->text, (int)strlen(W->text));
+        if (!s) return;
+        W->tex = SDL_CreateTextureFromSurface(g_r, s);
+        if (W->tex) { SDL_SetTextureBlendMode(W->tex, SDL_BLENDMODE_BLEND); W->tex_w = s->w; W->tex_h = s->h; }
+        SDL_FreeSurface(s);
+        return;
+    }
+
+    SDL_Texture* prev = SDL_GetRenderTarget(g_r);
+    if (W->kind == UI_SLIDER) {
+        W->tex = target(W->tex, W->rect.w, KNOB_H);
+        if (begin(W->tex)) {
+            const int track_y = (KNOB_H - W->rect.h) / 2;
+            float k = W->vmax > 0 ? SDL_clamp(W->value / (float)W->vmax, 0.f, 1.f) : 0.f;
+            SDL_Rect track = { 0, track_y, W->rect.w, W->rect.h };
+            SDL_Rect knob  = { (int)(k * (W->rect.w - KNOB_W)), 0, KNOB_W, KNOB_H };
+            prim_rect_i(&track, W->bg);
+            prim_rect_i(&knob, W->bg_active);
+            prim_flush();
+        }
+    } else {
+        W->tex = target(W->tex, W->rect.w, W->rect.h);
+        // у списку bg_active — вибраний пункт, заголовок не підсвічуємо
+        if (begin(W->tex)) box(W, W->rect.w, W->rect.h, active && W->kind != UI_DROPDOWN, W->text);
+        if (W->kind == UI_DROPDOWN && W->open && W->item_n > 0) {
+            W->tex_list = target(W->tex_list, W->rect.w, (W->item_n - 1) * LIST_ITEM_STEP + LIST_ITEM_H);
+            if (begin(W->tex_list)) {
+                for (int k = 0; k < W->item_n; ++k) {
+                    SDL_Rect r = { 0, k * LIST_ITEM_STEP, W->rect.w, LIST_ITEM_H };
+                    prim_rect_i(&r, k == W->value ? W->bg_active : W->bg);
+                    prim_outline_i(&r, W->border);
+                }
+                prim_flush();
+                for (int k = 0; k < W->item_n; ++k)
+                    font_draw(W->font_px, W->fg, W->items[k], W->pad_x, k * LIST_ITEM_STEP + 8);
+            }
+        }
+    }
+    SDL_SetRenderTarget(g_r, prev);
+}
+
+void ui_draw(UiTree* t) {
+    if (!g_r) return;
+    prim_flush(); // накопичене раніше — під віджетами
+
+    // спершу оновлюємо кеші тих, що змінились, потім копіюємо все
+    for (int i = 0; i < t->count; ++i) {
+        Widget* W = &t->w[i];
+        if (!W->visible || !W->dirty || W->kind == UI_PANEL) continue;
+        render_widget(t, i);
+        W->dirty = false;
+    }
+
+    for (int i = 0; i < t->count; ++i) {
+        const Widget* W = &t->w[i];
+        if (!W->visible) continue;
+        switch (W->kind) {
+            case UI_PANEL:
+                // одна напівпрозора плашка — кешувати нічого
+                prim_rect_i(&W->rect, W->bg);
+                prim_flush();
+                break;
+            case UI_LABEL:
+                if (W->tex) {
+                    SDL_Rect dst = { W->rect.x, W->rect.y, W->tex_w, W->tex_h };
+                    SDL_SetTextureColorMod(W->tex, W->fg.r, W->fg.g, W->fg.b);
+                    SDL_SetTextureAlphaMod(W->tex, W->fg.a);
+                    SDL_RenderCopy(g_r, W->tex, NULL, &dst);
+                }
+                break;
+            case UI_SLIDER:
+                if (W->tex) {
+                    SDL_Rect dst = { W->rect.x, W->rect.y - (KNOB_H - W->rect.h) / 2, W->rect.w, KNOB_H };
+                    SDL_RenderCopy(g_r, W->tex, NULL, &dst);
+                }
+                break;
+            default:
+                if (W->tex) SDL_RenderCopy(g_r, W->tex, NULL, &W->rect);
+                break;
+        }
+    }
+
+    // розкриті списки — поверх усього
+    for (int i = 0; i < t->count; ++i) {
+        const Widget* W = &t->w[i];
+        if (!W->visible || W->kind != UI_DROPDOWN || !W->open || !W->tex_list) continue;
+        int tw, th; SDL_QueryTexture(W->tex_list, NULL, NULL, &tw, &th);
+        SDL_Rect dst = { W->rect.x, W->rect.y + LIST_TOP, tw, th };
+        SDL_RenderCopy(g_r, W->tex_list, NULL, &dst);
+    }
+}
@@ -0,0 +1,98 @@
+#ifndef HYDRANGEA_UI_H
+#define HYDRANGEA_UI_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+// Віджети меню, налаштувань і діалогу (retained mode).
+// Дерево живе між кадрами: кожен віджет тримає свій готовий вигляд у текстурі й перемальовує
+// її лише після зміни стану (текст, значення, hover, розмір). Кадр = по одному RenderCopy на віджет.
+// Hit-test і вся взаємодія — через ui_dispatch.
+
+#define UI_MAX_WIDGETS 16
+#define UI_MAX_ITEMS   8
+
+typedef enum {
+    UI_LABEL = 0,
+    UI_BUTTON,
+    UI_TOGGLE,
+    UI_DROPDOWN,
+    UI_SLIDER,
+    UI_PANEL,
+} UiKind;
+
+typedef struct {
+    UiKind   kind;
+    int      id;          // ідентифікатор дії для гри
+    bool     visible;
+    SDL_Rect rect;        // у слайдера — доріжка; у списку — заголовок
+
+    char  text[96];
+    char  sub[64];        // другий рядок кнопки (підказка)
+    float font_px;
+    bool  center;         // підпис по центру
+    int   pad_x, pad_y, sub_dy;
+
+    SDL_Color bg, bg_active, border, border_active, fg, fg_sub;
+
+    int  value, vmax;     // toggle 0/1, slider 0..vmax, dropdown — вибраний пункт
+    bool open;            // розкритий список
+    char items[UI_MAX_ITEMS][24];
+    int  item_n;
+
+    // кеш відмальовки
+    bool         dirty;
+    SDL_Texture* tex;
+    SDL_Texture* tex_list;    // розкритий список
+    int          tex_w, tex_h;
+} Widget;
+
+typedef struct {
+    Widget w[UI_MAX_WIDGETS];
+    int    count;
+    int    hot;           // під курсором (-1)
+    int    focus;         // вибір з клавіатури (-1)
+    int    drag;          // слайдер, що тягнуть (-1)
+    Uint32 rev;           // росте з кожною зміною вигляду (для кешованих шарів)
+} UiTree;
+
+typedef enum {
+    UI_ACT_NONE = 0,
+    UI_ACT_CLICK,         // кнопка
+    UI_ACT_CHANGE,        // нове value (toggle/slider/пункт списку)
+    UI_ACT_OPEN,          // список розкрито/згорнуто (геометрія нижче зсувається)
+} UiActKind;
+
+typedef struct {
+    UiActKind kind;
+    int id;
+    int value;
+} UiAction;
+
+bool ui_init(SDL_Renderer* r);
+void ui_shutdown(void);
+
+void ui_tree_init(UiTree* t);
+void ui_tree_free(UiTree* t);
+int  ui_add(UiTree* t, UiKind kind, int id);   // індекс віджета або -1
+
+// сеттери позначають віджет брудним лише при справжній зміні
+void ui_set_rect(UiTree* t, int w, SDL_Rect r);
+void ui_set_text(UiTree* t, int w, const char* txt);
+void ui_set_sub(UiTree* t, int w, const char* txt);
+void ui_set_font(UiTree* t, int w, float px);
+void ui_set_value(UiTree* t, int w, int v);
+void ui_set_visible(UiTree* t, int w, bool on);
+void ui_set_focus(UiTree* t, int w);
+void ui_set_item(UiTree* t, int w, int i, const char* txt);
+void ui_mark_dirty(UiTree* t, int w);
+void ui_tree_invalidate(UiTree* t);   // усі кеші втрачено (RENDER_TARGETS_RESET)
+Uint32 ui_tree_rev(const UiTree* t);
+
+// hover за позицією курсора (після перерахунку розкладки теж)
+void ui_hover(UiTree* t, int x, int y);
+// true — подію спожито; дія (якщо є) — в *out
+bool ui_dispatch(UiTree* t, const SDL_Event* e, UiAction* out);
+void ui_draw(UiTree* t);
+
+#endif /* HYDRANGEA_UI_H */
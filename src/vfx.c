@@ -0,0 +1,231 @@
+#include "vfx.h"
+#include "rng.h"
+#include "swcomp.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NOISE_SIZE    256
+#define NOISE_SCALE   2      // піксель шуму = 2x2 пікселі екрана
+#define NOISE_FPS     24.f   // зерно «плівкове», не міняється кожен кадр
+#define VIGNETTE_SIZE 128
+#define GRAIN_TILES   64     // максимум плиток зерна в одному RenderGeometry
+#define GLITCH_BANDS  4
+
+enum { P_GRAIN, P_VIGNETTE, P_GLITCH, P_RED, P_COUNT };
+
+typedef struct { float y, h, dx; } GlitchBand; // y/h — частки висоти фону, dx — частка ширини
+
+static SDL_Texture* g_noise = NULL;
+static SDL_Texture* g_vignette = NULL;
+static Rng   g_rng;
+static float g_cur[P_COUNT], g_tgt[P_COUNT];
+static float g_flash = 0.f;
+static float g_shake_t = 0.f, g_shake_len = 0.f, g_shake_amp = 0.f;
+static float g_shake_x = 0.f, g_shake_y = 0.f;
+static int   g_noise_x = 0, g_noise_y = 0;
+static float g_noise_tick = 0.f;
+static float g_glitch_t = 0.f;
+static GlitchBand g_bands[GLITCH_BANDS];
+static int   g_bands_n = 0;
+
+void vfx_params_clear(VfxParams* p) {
+    memset(p, 0, sizeof(*p));
+    p->grain = p->vignette = p->glitch = p->red_overlay = -1.f;
+}
+
+static SDL_Texture* make_texture(SDL_Renderer* r, int w, int h, const Uint32* px, SDL_ScaleMode sm) {
+    SDL_Texture* t = SDL_CreateTexture(r, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, w, h);
+    if (!t) return NULL;
+    SDL_UpdateTexture(t, NULL, px, w * 4);
+    SDL_SetTextureBlendMode(t, SDL_BLENDMODE_BLEND);
+    SDL_SetTextureScaleMode(t, sm);
+    return t;
+}
+
+bool vfx_init(SDL_Renderer* r, Uint64 seed) {
+    rng_seed(&g_rng, seed);
+    vfx_reset();
+
+    Uint32* px = (Uint32*)malloc(sizeof(Uint32) * NOISE_SIZE * NOISE_SIZE);
+    if (!px) return false;
+
+    // шум: сірий, непрозорий — силу задає alpha mod
+    Rng nr; rng_seed(&nr, 0x6E6F697365ull); // сама текстура однакова для будь-якого seed
+    for (int i = 0; i < NOISE_SIZE * NOISE_SIZE; ++i) {
+        Uint32 v = rng_next(&nr) & 0xFF;
+        px[i] = 0xFF000000u | (v << 16) | (v << 8) | v;
+    }
+    g_noise = make_texture(r, NOISE_SIZE, NOISE_SIZE, px, SDL_ScaleModeNearest);
+
+    // віньєтка: чорний з альфою, що росте до кутів; розтягується на все вікно
+    for (int y = 0; y < VIGNETTE_SIZE; ++y) {
+        for (int x = 0; x < VIGNETTE_SIZE; ++x) {
+            float dx = (x + 0.5f) / VIGNETTE_SIZE * 2.f - 1.f;
+            float dy = (y + 0.5f) / VIGNETTE_SIZE * 2.f - 1.f;
+            float d = SDL_clamp((sqrtf(dx*dx + dy*dy) - 0.55f) / 0.85f, 0.f, 1.f);
+            Uint32 a = (Uint32)(d * d * (3.f - 2.f * d) * 255.f);
+            px[y * VIGNETTE_SIZE + x] = a << 24;
+        }
+    }
+    g_vignette = make_texture(r, VIGNETTE_SIZE, VIGNETTE_SIZE, px, SDL_ScaleModeLinear);
+
+    free(px);
+    if (!g_noise || !g_vignette) SDL_Log("vfx: texture creation failed: %s", SDL_GetError());
+    return g_noise && g_vignette;
+}
+
+void vfx_shutdown(void) {
+    if (g_noise)    { SDL_DestroyTexture(g_noise);    g_noise = NULL; }
+    if (g_vignette) { SDL_DestroyTexture(g_vignette); g_vignette = NULL; }
+}
+
+void vfx_reset(void) {
+    memset(g_cur, 0, sizeof(g_cur));
+    memset(g_tgt, 0, sizeof(g_tgt));
+    g_flash = 0.f;
+    g_shake_t = g_shake_len = g_shake_amp = 0.f;
+    g_shake_x = g_shake_y = 0.f;
+    g_glitch_t = 0.f; g_bands_n = 0;
+}
+
+static void fire_oneshots(const VfxParams* p) {
+    if (p->flash) g_flash = 1.f;
+    if (p->shake_ms > 0.f && p->shake_amp > 0.f) {
+        g_shake_len = g_shake_t = p->shake_ms / 1000.f;
+        g_shake_amp = p->shake_amp;
+    }
+}
+
+void vfx_enter_scene(const VfxParams* p, bool oneshots) {
+    g_tgt[P_GRAIN]    = SDL_max(p->grain, 0.f);
+    g_tgt[P_VIGNETTE] = SDL_max(p->vignette, 0.f);
+    g_tgt[P_GLITCH]   = SDL_max(p->glitch, 0.f);
+    g_tgt[P_RED]      = SDL_max(p->red_overlay, 0.f);
+    if (oneshots) fire_oneshots(p);
+}
+
+void vfx_trigger(const VfxParams* p) {
+    if (p->grain >= 0.f)       g_tgt[P_GRAIN]    = p->grain;
+    if (p->vignette >= 0.f)    g_tgt[P_VIGNETTE] = p->vignette;
+    if (p->glitch >= 0.f)      g_tgt[P_GLITCH]   = p->glitch;
+    if (p->red_overlay >= 0.f) g_tgt[P_RED]      = p->red_overlay;
+    fire_oneshots(p);
+}
+
+static void glitch_burst(void) {
+    g_glitch_t = 0.06f + rng_float(&g_rng) * 0.08f;
+    g_bands_n = rng_range(&g_rng, 2, GLITCH_BANDS);
+    for (int i = 0; i < g_bands_n; ++i) {
+        g_bands[i].h  = 0.02f + rng_float(&g_rng) * 0.06f;
+        g_bands[i].y  = rng_float(&g_rng) * (1.f - g_bands[i].h);
+        g_bands[i].dx = (rng_float(&g_rng) * 2.f - 1.f) * 0.08f * g_cur[P_GLITCH];
+    }
+}
+
+void vfx_update(float dt) {
+    // постійні ефекти плавно підтягуються до значень нової сцени
+    for (int i = 0; i < P_COUNT; ++i) {
+        float d = g_tgt[i] - g_cur[i], step = 2.5f * dt;
+        g_cur[i] = (fabsf(d) <= step) ? g_tgt[i] : g_cur[i] + (d > 0.f ? step : -step);
+    }
+
+    if (g_flash > 0.f) g_flash = SDL_max(0.f, g_flash - dt / 0.35f);
+
+    if (g_shake_t > 0.f) {
+        g_shake_t = SDL_max(0.f, g_shake_t - dt);
+        g_shake_x = rng_float(&g_rng) * 2.f - 1.f;
+        g_shake_y = rng_float(&g_rng) * 2.f - 1.f;
+    }
+
+    if (g_cur[P_GRAIN] > 0.f) {
+        g_noise_tick += dt;
+        if (g_noise_tick >= 1.f / NOISE_FPS) {
+            g_noise_tick = 0.f;
+            g_noise_x = rng_range(&g_rng, 0, NOISE_SIZE - 1);
+            g_noise_y = rng_range(&g_rng, 0, NOISE_SIZE - 1);
+        }
+    }
+
+    if (g_glitch_t > 0.f) g_glitch_t = SDL_max(0.f, g_glitch_t - dt);
+    else if (g_cur[P_GLITCH] > 0.f && rng_float(&g_rng) < g_cur[P_GLITCH] * 6.f * dt) glitch_burst();
+}
+
+void vfx_shake_offset(int out_h, int* dx, int* dy) {
+    *dx = *dy = 0;
+    if (g_shake_t <= 0.f || g_shake_len <= 0.f) return;
+    float px = g_shake_amp * 12.f * (out_h / 720.f) * (g_shake_t / g_shake_len);
+    *dx = (int)lroundf(g_shake_x * px);
+    *dy = (int)lroundf(g_shake_y * px);
+}
+
+static void fill_full(SDL_Renderer* r, int w, int h, Uint8 cr, Uint8 cg, Uint8 cb, Uint8 a, SDL_BlendMode bm) {
+    if (bm == SDL_BLENDMODE_BLEND && swc_fill_view((SDL_Color){cr, cg, cb, a})) return; // програмний рендерер
+    SDL_SetRenderDrawBlendMode(r, bm);
+    SDL_SetRenderDrawColor(r, cr, cg, cb, a);
+    SDL_Rect full = {0, 0, w, h};
+    SDL_RenderFillRect(r, &full);
+    SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_BLEND);
+}
+
+static void render_glitch(SDL_Renderer* r, SDL_Texture* bg, const SDL_Rect* dst) {
+    if (g_glitch_t <= 0.f || !bg || !dst || dst->w <= 0 || dst->h <= 0) return;
+    int tw = 0, th = 0;
+    SDL_QueryTexture(bg, NULL, NULL, &tw, &th);
+    for (int i = 0; i < g_bands_n; ++i) {
+        const GlitchBand* b = &g_bands[i];
+        SDL_Rect src = { 0, (int)(b->y * th), tw, SDL_max(1, (int)(b->h * th)) };
+        SDL_Rect out = { dst->x + (int)(b->dx * dst->w), dst->y + (int)(b->y * dst->h),
+                         dst->w, SDL_max(1, (int)(b->h * dst->h)) };
+        // зміщена смуга фону з кольоровим зсувом (червоний/бірюзовий по черзі)
+        if (i & 1) SDL_SetTextureColorMod(bg, 120, 255, 255);
+        else       SDL_SetTextureColorMod(bg, 255, 110, 120);
+        SDL_RenderCopy(r, bg, &src, &out);
+    }
+    SDL_SetTextureColorMod(bg, 255, 255, 255); // текстура спільна з кешем
+}
+
+// зерно: сітка плиток одним RenderGeometry, зсув сітки = «прокрутка UV»
+static void render_grain(SDL_Renderer* r, int out_w, int out_h) {
+    if (!g_noise || g_cur[P_GRAIN] <= 0.f) return;
+    const float tile = (float)(NOISE_SIZE * NOISE_SCALE);
+    const float ox = -(float)(g_noise_x * NOISE_SCALE), oy = -(float)(g_noise_y * NOISE_SCALE);
+    const int nx = (int)ceilf((out_w - ox) / tile), ny = (int)ceilf((out_h - oy) / tile);
+
+    SDL_Vertex v[GRAIN_TILES * 4];
+    int idx[GRAIN_TILES * 6];
+    int n = 0;
+    const SDL_Color c = {255, 255, 255, (Uint8)SDL_clamp((int)(g_cur[P_GRAIN] * 90.f), 0, 255)};
+    for (int ty = 0; ty < ny; ++ty) {
+        for (int tx = 0; tx < nx && n < GRAIN_TILES; ++tx, ++n) {
+            float x0 = ox + tx * tile, y0 = oy + ty * tile;
+            SDL_Vertex* q = &v[n * 4];
+            q[0] = (SDL_Vertex){ {x0,        y0},        c, {0.f, 0.f} };
+            q[1] = (SDL_Vertex){ {x0 + tile, y0},        c, {1.f, 0.f} };
+            q[2] = (SDL_Vertex){ {x0 + tile, y0 + tile}, c, {1.f, 1.f} };
+            q[3] = (SDL_Vertex){ {x0,        y0 + tile}, c, {0.f, 1.f} };
+            int* k = &idx[n * 6];
+            k[0] = n*4; k[1] = n*4 + 1; k[2] = n*4 + 2;
+            k[3] = n*4; k[4] = n*4 + 2; k[5] = n*4 + 3;
+        }
+    }
+    SDL_RenderGeometry(r, g_noise, v, n * 4, idx, n * 6);
+}
+
+void vfx_render_world(SDL_Renderer* r, SDL_Texture* bg, const SDL_Rect* bg_dst, int out_w, int out_h) {
+    render_glitch(r, bg, bg_dst);
+    render_grain(r, out_w, out_h);
+
+    if (g_vignette && g_cur[P_VIGNETTE] > 0.f) {
+        SDL_SetTextureAlphaMod(g_vignette, (Uint8)SDL_clamp((int)(g_cur[P_VIGNETTE] * 255.f), 0, 255));
+        SDL_RenderCopy(r, g_vignette, NULL, NULL);
+    }
+
+    if (g_cur[P_RED] > 0.f)
+        fill_full(r, out_w, out_h, 150, 10, 20, (Uint8)SDL_clamp((int)(g_cur[P_RED] * 255.f), 0, 255), SDL_BLENDMODE_BLEND);
+}
+
+void vfx_render_flash(SDL_Renderer* r, int out_w, int out_h) {
+    if (g_flash <= 0.f) return;
+    fill_full(r, out_w, out_h, 255, 255, 255, (Uint8)(g_flash * g_flash * 255.f), SDL_BLENDMODE_ADD);
+}
@@ -0,0 +1,43 @@
+#ifndef HYDRANGEA_VFX_H
+#define HYDRANGEA_VFX_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+// Ефекти сцени з блоку "vfx" (і "vfx_on_pick" у виборах).
+// Шум і віньєтка генеруються один раз у текстури; зерно анімується зсувом src-rect,
+// трясіння — зсув фону, спалах і червоний тон — заливка з потрібним blend-режимом.
+// Увесь стек — кілька draw call'ів на кадр.
+
+typedef struct {
+    float grain;        // 0..1, < 0 = не задано
+    float vignette;
+    float glitch;
+    float red_overlay;
+    bool  flash;        // одноразовий білий спалах
+    float shake_ms;     // одноразове трясіння: тривалість
+    float shake_amp;    // ...і сила (1 ≈ 12 px при 720p)
+} VfxParams;
+
+void vfx_params_clear(VfxParams* p);   // «нічого не задано»
+
+bool vfx_init(SDL_Renderer* r, Uint64 seed);
+void vfx_shutdown(void);
+
+// вхід у сцену: постійні ефекти замінюються (незадані -> 0); oneshots — ще й спалах/трясіння
+void vfx_enter_scene(const VfxParams* p, bool oneshots);
+// вибір: спалах/трясіння + перевизначення лише заданих постійних ефектів
+void vfx_trigger(const VfxParams* p);
+void vfx_reset(void);
+
+void vfx_update(float dt);
+
+// зсув фону від трясіння (px) для вікна висотою out_h
+void vfx_shake_offset(int out_h, int* dx, int* dy);
+
+// над фоном: глітч-смуги (з тієї ж текстури фону), зерно, віньєтка, червоний тон
+void vfx_render_world(SDL_Renderer* r, SDL_Texture* bg, const SDL_Rect* bg_dst, int out_w, int out_h);
+// над усім UI (перед загальним fade)
+void vfx_render_flash(SDL_Renderer* r, int out_w, int out_h);
+
+#endif /* HYDRANGEA_VFX_H */
@@ -0,0 +1,185 @@
+// Пакувальник assets.hpak.
+//   hydrangea_pack <out.hpak> <assets_dir> <file> [file...]
+// file — шлях відносно assets_dir ("fonts/Inter-Medium.ttf").
+// Уже стиснені формати (png/jpg/mp3/ogg) лежать як є, решта — LZ4, якщо це економить >10%.
+
+#include "hpak.h"
+#include "lz4blk.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    const char* rel;
+    char norm[256];
+    size_t norm_len;
+    uint64_t hash;
+    int order;
+} PackItem;
+
+static unsigned char* read_all(const char* path, long* size) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    long n = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    unsigned char* buf = (unsigned char*)malloc(n > 0 ? (size_t)n : 1);
+    if (buf && n > 0 && fread(buf, 1, (size_t)n, f) != (size_t)n) { free(buf); buf = NULL; }
+    fclose(f);
+    *size = n;
+    return buf;
+}
+
+static const char* ext_of(const char* s) {
+    const char* dot = strrchr(s, '.');
+    return dot ? dot + 1 : "";
+}
+
+static bool ext_is(const char* s, const char* e) {
+    const char* x = ext_of(s);
+    for (; *x && *e; ++x, ++e) if ((*x | 0x20) != *e) return false;
+    return !*x && !*e;
+}
+
+static bool already_compressed(const char* s) {
+    return ext_is(s, "png") || ext_is(s, "jpg") || ext_is(s, "mp3") || ext_is(s, "ogg");
+}
+
+// шрифти й тексти на початку: їх читають першими при старті
+static int pack_order(const char* s) {
+    if (ext_is(s, "ttf")) return 0;
+    if (ext_is(s, "json")) return 1;
+    return 2;
+}
+
+static int cmp_items(const void* a, const void* b) {
+    const PackItem* x = (const PackItem*)a;
+    const PackItem* y = (const PackItem*)b;
+    if (x->order != y->order) return x->order - y->order;
+    return strcmp(x->norm, y->norm);
+}
+
+static bool pad_to(FILE* f, uint64_t* pos, uint64_t align) {
+    static const unsigned char zero[16] = {0};
+    uint64_t pad = (align - (*pos % align)) % align;
+    if (pad && fwrite(zero, 1, (size_t)pad, f) != pad) return false;
+    *pos += pad;
+    return true;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 4) {
+        fprintf(stderr, "usage: %s <out.hpak> <assets_dir> <file> [file...]\n", argv[0]);
+        return 2;
+    }
+    const char* out_path = argv[1];
+    const char* root = argv[2];
+    const int count = argc - 3;
+
+    PackItem* items = (PackItem*)calloc((size_t)count, sizeof(PackItem));
+    uint32_t slots = 16;
+    while (slots < (uint32_t)count * 2) slots <<= 1; // заповнення <= 50%
+    HpakSlot* index = (HpakSlot*)calloc(slots, sizeof(HpakSlot));
+    if (!items || !index) { fprintf(stderr, "out of memory\n"); return 1; }
+
+    for (int i = 0; i < count; ++i) {
+        items[i].rel = argv[3 + i];
+        items[i].norm_len = hpak_normalize(items[i].rel, items[i].norm, sizeof(items[i].norm));
+        items[i].hash = hpak_hash(items[i].norm, items[i].norm_len);
+        items[i].order = pack_order(items[i].rel);
+    }
+    qsort(items, (size_t)count, sizeof(PackItem), cmp_items);
+
+    char tmp_path[1024];
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", out_path);
+    FILE* f = fopen(tmp_path, "wb");
+    if (!f) { fprintf(stderr, "can't create %s\n", tmp_path); return 1; }
+
+    HpakHeader hd;
+    memset(&hd, 0, sizeof(hd));
+    uint64_t pos = sizeof(hd);
+    bool ok = fwrite(&hd, sizeof(hd), 1, f) == 1;
+    uint32_t name_off = 0, packed = 0;
+    uint64_t total_raw = 0, total_stored = 0;
+
+    for (int i = 0; ok && i < count; ++i) {
+        PackItem* it = &items[i];
+        if (i > 0 && strcmp(it->norm, items[i-1].norm) == 0) {
+            fprintf(stderr, "duplicate %s skipped\n", it->rel);
+            continue;
+        }
+        char path[1024];
+        snprintf(path, sizeof(path), "%s/%s", root, it->rel);
+        long size = 0;
+        unsigned char* raw = read_all(path, &size);
+        if (!raw) { fprintf(stderr, "can't read %s\n", path); ok = false; break; }
+
+        const unsigned char* payload = raw;
+        uint32_t stored = (uint32_t)size, flags = 0;
+        unsigned char* lz = NULL;
+        if (!already_compressed(it->rel) && size > 64) {
+            int cap = lz4_compress_bound((int)size);
+            lz = (unsigned char*)malloc((size_t)cap);
+            int n = lz ? lz4_compress(raw, (int)size, lz, cap) : 0;
+            if (n > 0 && (long)n < size - size / 10) { payload = lz; stored = (uint32_t)n; flags = HPAK_FLAG_LZ4; }
+        }
+
+        ok = pad_to(f, &pos, 16);
+        uint32_t mask = slots - 1, s = (uint32_t)it->hash & mask;
+        while (index[s].hash) s = (s + 1) & mask;
+        index[s].hash = it->hash;
+        index[s].data_off = pos;
+        index[s].name_off = name_off;
+        index[s].name_len = (uint32_t)it->norm_len;
+        index[s].stored_size = stored;
+        index[s].raw_size = (uint32_t)size;
+        index[s].flags = flags;
+        name_off += (uint32_t)it->norm_len;
+
+        if (ok && stored) ok = fwrite(payload, 1, stored, f) == stored;
+        pos += stored;
+        total_raw += (uint64_t)size; total_stored += stored;
+        packed++;
+        printf("  %-40s %9ld -> %9u%s\n", it->norm, size, stored, flags ? " lz4" : "");
+        free(lz);
+        free(raw);
+    }
+
+    // імена у тому ж порядку, в якому роздавали name_off
+    if (ok) {
+        hd.names_off = pos;
+        for (int i = 0; ok && i < count; ++i) {
+            if (i > 0 && strcmp(items[i].norm, items[i-1].norm) == 0) continue;
+            ok = fwrite(items[i].norm, 1, items[i].norm_len, f) == items[i].norm_len;
+        }
+        pos += name_off;
+    }
+    if (ok) ok = pad_to(f, &pos, 8);
+    if (ok) {
+        hd.index_off = pos;
+        ok = fwrite(index, sizeof(HpakSlot), slots, f) == slots;
+    }
+    if (ok) {
+        memcpy(hd.magic, "HPAK", 4);
+        hd.version = HPAK_VERSION;
+        hd.count = packed;
+        hd.slots = slots;
+        ok = fseek(f, 0, SEEK_SET) == 0 && fwrite(&hd, sizeof(hd), 1, f) == 1;
+    }
+    if (fclose(f) != 0) ok = false;
+    if (ok) {
+        remove(out_path);
+        ok = rename(tmp_path, out_path) == 0;
+    }
+    if (!ok) {
+        remove(tmp_path);
+        fprintf(stderr, "failed to write %s\n", out_path);
+        return 1;
+    }
+    printf("%s: %u files, %llu -> %llu bytes\n", out_path, packed,
+           (unsigned long long)total_raw, (unsigned long long)total_stored);
+    free(index);
+    free(items);
+    return 0;
+}
@@ -0,0 +1,107 @@
+// Замір декодування фонів: PNG (SDL_image) проти QOI і сирих пікселів у LZ4 (як у imgcache).
+//   hydrangea_imgbench <file.png> [file.png...]
+// QOI і LZ4 кодуються тут же, в пам'яті; диск не чіпаємо — міряється лише декодування
+// з уже прочитаного буфера. Результат QOI порівнюється з PNG попіксельно.
+
+#include "qoi.h"
+#include "lz4blk.h"
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RUNS 5
+
+static unsigned char* read_all(const char* path, size_t* size) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    long n = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    unsigned char* buf = (unsigned char*)malloc(n > 0 ? (size_t)n : 1);
+    if (buf && n > 0 && fread(buf, 1, (size_t)n, f) != (size_t)n) { free(buf); buf = NULL; }
+    fclose(f);
+    *size = n > 0 ? (size_t)n : 0;
+    return buf;
+}
+
+static double now_ms(void) {
+    return (double)SDL_GetPerformanceCounter() * 1000.0 / (double)SDL_GetPerformanceFrequency();
+}
+
+// щільні рядки ARGB8888 — як пише imgcache
+static unsigned char* argb_bytes(SDL_Surface* s, int* size) {
+    *size = s->w * s->h * 4;
+    unsigned char* p = (unsigned char*)malloc((size_t)*size);
+    if (p) for (int y = 0; y < s->h; ++y) memcpy(p + (size_t)y * s->w * 4, (Uint8*)s->pixels + (size_t)y * s->pitch, (size_t)s->w * 4);
+    return p;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) { fprintf(stderr, "usage: %s <file.png> [file.png...]\n", argv[0]); return 1; }
+    if (SDL_Init(0) != 0 || (IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG) == 0) { fprintf(stderr, "init: %s\n", SDL_GetError()); return 1; }
+
+    printf("best of %d runs, decode from memory\n", RUNS);
+    printf("%-26s %9s %7s %7s %7s %8s %8s %8s %7s\n", "", "size", "PNG MB", "QOI MB", "LZ4 MB", "PNG ms", "QOI ms", "LZ4 ms", "QOI x");
+    double tot_png = 0, tot_qoi = 0, tot_lz4 = 0;
+    bool all_same = true;
+    for (int i = 1; i < argc; ++i) {
+        size_t png_n = 0;
+        unsigned char* png = read_all(argv[i], &png_n);
+        SDL_Surface* ref = png ? IMG_Load_RW(SDL_RWFromConstMem(png, (int)png_n), 1) : NULL;
+        SDL_Surface* argb = ref ? SDL_ConvertSurfaceFormat(ref, SDL_PIXELFORMAT_ARGB8888, 0) : NULL;
+        if (!argb) { fprintf(stderr, "%s: %s\n", argv[i], png ? SDL_GetError() : "can't read"); free(png); SDL_FreeSurface(ref); continue; }
+
+        size_t qoi_n = 0;
+        void* qoi = qoi_encode(argb, &qoi_n);
+        int raw_n = 0;
+        unsigned char* raw = argb_bytes(argb, &raw_n);
+        int cap = lz4_compress_bound(raw_n);
+        unsigned char* lz = raw ? (unsigned char*)malloc((size_t)cap) : NULL;
+        int lz_n = lz ? lz4_compress(raw, raw_n, lz, cap) : 0;
+        if (!qoi || !lz_n) { fprintf(stderr, "%s: encode failed\n", argv[i]); return 1; }
+
+        double t_png = 1e9, t_qoi = 1e9, t_lz4 = 1e9;
+        for (int r = 0; r < RUNS; ++r) {
+            double t = now_ms();
+            SDL_Surface* s = IMG_Load_RW(SDL_RWFromConstMem(png, (int)png_n), 1);
+            t_png = SDL_min(t_png, now_ms() - t);
+            SDL_FreeSurface(s);
+
+            t = now_ms();
+            s = qoi_decode(qoi, qoi_n);
+            t_qoi = SDL_min(t_qoi, now_ms() - t);
+            if (r == 0) { // той самий вміст, що й PNG
+                bool same = s && s->w == argb->w && s->h == argb->h;
+                for (int y = 0; same && y < s->h; ++y)
+                    same = memcmp((Uint8*)s->pixels + (size_t)y * s->pitch, (Uint8*)argb->pixels + (size_t)y * argb->pitch, (size_t)s->w * 4) == 0;
+                if (!same) { all_same = false; printf("  %s: QOI pixels differ\n", argv[i]); }
+            }
+            SDL_FreeSurface(s);
+
+            t = now_ms();
+            s = SDL_CreateRGBSurfaceWithFormat(0, argb->w, argb->h, 32, SDL_PIXELFORMAT_ARGB8888);
+            if (s && lz4_decompress(lz, lz_n, (unsigned char*)s->pixels, raw_n) != raw_n) all_same = false;
+            t_lz4 = SDL_min(t_lz4, now_ms() - t);
+            SDL_FreeSurface(s);
+        }
+
+        const char* name = strrchr(argv[i], '/');
+        name = name ? name + 1 : argv[i];
+        char size[32];
+        snprintf(size, sizeof(size), "%dx%d", argb->w, argb->h);
+        printf("%-26s %9s %7.2f %7.2f %7.2f %8.2f %8.2f %8.2f %6.1fx\n", name, size,
+               png_n / 1048576.0, qoi_n / 1048576.0, lz_n / 1048576.0, t_png, t_qoi, t_lz4, t_png / t_qoi);
+        tot_png += t_png; tot_qoi += t_qoi; tot_lz4 += t_lz4;
+
+        free(lz); free(raw); free(qoi); free(png);
+        SDL_FreeSurface(argb); SDL_FreeSurface(ref);
+    }
+    if (tot_qoi > 0) printf("total: PNG %.1f ms, QOI %.1f ms (x%.1f), LZ4 %.1f ms\n", tot_png, tot_qoi, tot_png / tot_qoi, tot_lz4);
+    printf("QOI identical to PNG: %s\n", all_same ? "yes" : "NO");
+
+    IMG_Quit();
+    SDL_Quit();
+    return all_same ? 0 : 1;
+}
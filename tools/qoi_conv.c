@@ -0,0 +1,80 @@
+// Конвертер фонів у QOI.
+//   hydrangea_qoiconv [--force] <file.png> [file.png...]
+// Поруч із кожним x.png пише x.qoi — гра бере його замість PNG (imgcache.c).
+// Уже свіжі (QOI не старший за PNG) пропускаються; кожен результат перевіряється
+// декодуванням назад до запису.
+
+#include "qoi.h"
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+static bool up_to_date(const char* src, const char* dst) {
+    struct stat a, b;
+    return stat(src, &a) == 0 && stat(dst, &b) == 0 && b.st_mtime >= a.st_mtime;
+}
+
+// той самий вміст, що дає PNG (після приведення до ARGB8888)
+static bool same_pixels(SDL_Surface* png, const void* qoi, size_t n) {
+    SDL_Surface* a = SDL_ConvertSurfaceFormat(png, SDL_PIXELFORMAT_ARGB8888, 0);
+    SDL_Surface* b = qoi_decode(qoi, n);
+    bool ok = a && b && a->w == b->w && a->h == b->h;
+    for (int y = 0; ok && y < a->h; ++y)
+        ok = memcmp((Uint8*)a->pixels + (size_t)y * a->pitch, (Uint8*)b->pixels + (size_t)y * b->pitch, (size_t)a->w * 4) == 0;
+    SDL_FreeSurface(a);
+    SDL_FreeSurface(b);
+    return ok;
+}
+
+static int convert(const char* src, bool force, double* in_mb, double* out_mb) {
+    const char* ext = strrchr(src, '.');
+    if (!ext || SDL_strcasecmp(ext, ".png") != 0) { fprintf(stderr, "skip %s: not a .png\n", src); return 0; }
+    char dst[1024];
+    snprintf(dst, sizeof(dst), "%.*s.qoi", (int)(ext - src), src);
+    if (!force && up_to_date(src, dst)) { printf("%-48s up to date\n", dst); return 0; }
+
+    SDL_Surface* s = IMG_Load(src);
+    if (!s) { fprintf(stderr, "%s: %s\n", src, IMG_GetError()); return 1; }
+    size_t n = 0;
+    void* q = qoi_encode(s, &n);
+    if (!q || !same_pixels(s, q, n)) {
+        fprintf(stderr, "%s: %s\n", src, q ? "round trip mismatch" : SDL_GetError());
+        free(q); SDL_FreeSurface(s);
+        return 1;
+    }
+    SDL_FreeSurface(s);
+
+    FILE* f = fopen(dst, "wb");
+    bool ok = f && fwrite(q, 1, n, f) == n;
+    if (f) ok = (fclose(f) == 0) && ok;
+    free(q);
+    if (!ok) { fprintf(stderr, "can't write %s\n", dst); remove(dst); return 1; }
+
+    struct stat st;
+    double src_mb = stat(src, &st) == 0 ? st.st_size / (1024.0 * 1024.0) : 0.0;
+    printf("%-48s %7.2f MB -> %7.2f MB\n", dst, src_mb, n / (1024.0 * 1024.0));
+    *in_mb += src_mb; *out_mb += n / (1024.0 * 1024.0);
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    bool force = false;
+    int first = 1;
+    if (argc > 1 && strcmp(argv[1], "--force") == 0) { force = true; first = 2; }
+    if (first >= argc) {
+        fprintf(stderr, "usage: %s [--force] <file.png> [file.png...]\n", argv[0]);
+        return 1;
+    }
+    if ((IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG) == 0) { fprintf(stderr, "IMG_Init: %s\n", IMG_GetError()); return 1; }
+
+    int failed = 0;
+    double in_mb = 0.0, out_mb = 0.0;
+    for (int i = first; i < argc; ++i) failed += convert(argv[i], force, &in_mb, &out_mb);
+    if (out_mb > 0.0) printf("total %.2f MB PNG -> %.2f MB QOI\n", in_mb, out_mb);
+
+    IMG_Quit();
+    return failed ? 1 : 0;
+}
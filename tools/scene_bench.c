@@ -0,0 +1,138 @@
+// Замір розбору сюжету в 1/2/4/8 потоків.
+//   hydrangea_scenebench [story.json]        — свій файл
+//   hydrangea_scenebench --gen <MB>          — синтетичний сюжет (типово 50 МБ)
+// Кожен прогін розбирає свіжу копію буфера; результат порівнюється з однопотоковим.
+
+#include "scenes.h"
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RUNS 3
+
+typedef struct { char* p; size_t n, cap; } Buf;
+
+static void put(Buf* b, const char* s) {
+    size_t n = strlen(s);
+    if (b->n + n + 1 > b->cap) {
+        b->cap = (b->n + n + 1) * 2;
+        b->p = (char*)realloc(b->p, b->cap);
+        if (!b->p) { fprintf(stderr, "out of memory\n"); exit(1); }
+    }
+    memcpy(b->p + b->n, s, n + 1);
+    b->n += n;
+}
+
+// схожий на справжній сюжет: репліки з екрануванням, вибори з ефектами й прапорцями, перевірки
+static char* gen_story(size_t mb, size_t* out_n) {
+    Buf b = {0};
+    char tmp[1024];
+    Uint32 seed = 12345;
+    put(&b, "{\n  \"start\": \"s0\",\n  \"scenes\": [\n");
+    for (int i = 0; b.n < mb * 1024 * 1024; ++i) {
+        if (i) put(&b, ",\n");
+        seed = seed * 1664525u + 1013904223u;
+        int n = 0;
+        n += snprintf(tmp + n, sizeof(tmp) - n,
+            "    { \"id\": \"s%d\", \"speaker\": \"str:speaker_%u\",\n"
+            "      \"text\": \"Line %d: \\\"quoted\\\" \\u0442\\u0435\\u043a\\u0441\\u0442 with a tab\\tand more words to read.\",\n"
+            "      \"background\": \"backgrounds/bg_%u.png\", \"auto_time\": 0,\n"
+            "      \"vfx\": { \"grain\": 0.2, \"shake\": [120, 0.5] },\n      \"choices\": [\n",
+            i, seed % 16, i, seed % 40);
+        for (int c = 0; c < 3; ++c) {
+            n += snprintf(tmp + n, sizeof(tmp) - n,
+                "        { \"text\": \"Choice %d\", \"effects\": { \"clarity\": %d, \"anxiety\": %d }, \"next\": \"s%u\", \"flags+\": [\"f%d\"] }%s\n",
+                c, c - 1, 2 - c, (seed >> (c * 5)) % (Uint32)(i + 1), c, c < 2 ? "," : "");
+        }
+        n += snprintf(tmp + n, sizeof(tmp) - n,
+            "      ],\n      \"checks\": [ { \"if\": { \"anxiety\": \">=70\", \"flag\": \"f1\" }, \"goto\": \"s%d\" } ] }",
+            i / 2);
+        put(&b, tmp);
+    }
+    put(&b, "\n  ]\n}\n");
+    *out_n = b.n;
+    return b.p;
+}
+
+static char* read_all(const char* path, size_t* size) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    long n = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char* buf = (char*)malloc(n > 0 ? (size_t)n + 1 : 1);
+    if (buf && n > 0 && fread(buf, 1, (size_t)n, f) != (size_t)n) { free(buf); buf = NULL; }
+    fclose(f);
+    if (buf) buf[n > 0 ? n : 0] = '\0';
+    *size = n > 0 ? (size_t)n : 0;
+    return buf;
+}
+
+static void free_story(Scene* s, int n, StrIndex* ix) {
+    for (int i = 0; i < n; ++i) scene_free_content(&s[i]);
+    free(s);
+    strindex_free(ix);
+}
+
+static bool same_story(const Scene* a, int na, int sa, const Scene* b, int nb, int sb) {
+    if (na != nb || sa != sb) return false;
+    for (int i = 0; i < na; ++i) {
+        const Scene* x = &a[i];
+        const Scene* y = &b[i];
+        if (strcmp(x->id, y->id) != 0 || x->src_hash != y->src_hash || x->auto_next != y->auto_next) return false;
+        for (int c = 0; c < x->num_choices; ++c) if (x->choices[c].next != y->choices[c].next) return false;
+        for (int k = 0; k < x->checks_count; ++k) if (x->checks[k].goto_index != y->checks[k].goto_index) return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    size_t size = 0, gen_mb = 50;
+    const char* path = NULL;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--gen") == 0 && i + 1 < argc) gen_mb = (size_t)atoi(argv[++i]);
+        else path = argv[i];
+    }
+    char* src = path ? read_all(path, &size) : gen_story(gen_mb ? gen_mb : 1, &size);
+    if (!src) { fprintf(stderr, "can't read %s\n", path); return 1; }
+    char* work = (char*)malloc(size + 1);
+    if (!work) return 1;
+
+    Lang lang;
+    memset(&lang, 0, sizeof(lang)); // без каталогу "str:" падають на ключ — пошук той самий
+
+    Scene* ref = NULL;
+    int ref_n = 0, ref_start = -1;
+    StrIndex ref_ix = {0};
+    const int threads[] = { 1, 2, 4, 8 };
+    double base = 0.0;
+    bool all_same = true;
+
+    printf("story: %.1f MB, %d CPUs\n", size / (1024.0 * 1024.0), SDL_GetCPUCount());
+    printf("threads   best ms   speedup\n");
+    for (int t = 0; t < (int)(sizeof(threads) / sizeof(threads[0])); ++t) {
+        scenes_set_threads(threads[t]);
+        double best = 1e30;
+        for (int run = 0; run < RUNS; ++run) {
+            memcpy(work, src, size + 1); // розбір змінює буфер на місці
+            Scene* s; int n, start; StrIndex ix;
+            Uint64 t0 = SDL_GetPerformanceCounter();
+            bool ok = scenes_parse_buffer(work, size, path ? path : "generated", &lang, &s, &n, &start, &ix);
+            double ms = (double)(SDL_GetPerformanceCounter() - t0) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+            if (!ok) { fprintf(stderr, "parse failed\n"); return 1; }
+            if (ms < best) best = ms;
+            if (!ref) { ref = s; ref_n = n; ref_start = start; ref_ix = ix; continue; }
+            if (!same_story(ref, ref_n, ref_start, s, n, start)) all_same = false;
+            free_story(s, n, &ix);
+        }
+        if (t == 0) base = best;
+        printf("%7d %9.1f %8.2fx\n", threads[t], best, base / best);
+    }
+    printf("scenes: %d, identical to 1 thread: %s\n", ref_n, all_same ? "yes" : "NO");
+
+    free_story(ref, ref_n, &ref_ix);
+    free(work);
+    free(src);
+    return all_same ? 0 : 1;
+}
@@ -0,0 +1,141 @@
+// Замір CPU-композитингу (swcomp) проти програмного рендерера SDL.
+//   hydrangea_swcompbench [W H]    — розмір кадру (типово 1920x1080)
+// Заливка (червоний тон VFX), fade (чорний), розтягування світу 0.75 -> кадр.
+// Усі набори ядер порівнюються побайтно зі скалярним; заливка — ще й із SDL.
+
+#include "swcomp.h"
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RUNS 7
+
+typedef struct { const char* name; double fill, fade, scale; } Row;
+
+static double now_ms(void) {
+    return (double)SDL_GetPerformanceCounter() * 1000.0 / (double)SDL_GetPerformanceFrequency();
+}
+
+// однаковий вихідний кадр для кожного прогону: шум, щоб не було «легких» значень
+static void noise(SDL_Surface* s, Uint32 seed) {
+    for (int y = 0; y < s->h; ++y) {
+        Uint32* p = (Uint32*)((Uint8*)s->pixels + (size_t)y * s->pitch);
+        for (int x = 0; x < s->w; ++x) { seed = seed * 1664525u + 1013904223u; p[x] = seed | 0xFF000000u; }
+    }
+}
+
+static int max_diff(const SDL_Surface* a, const SDL_Surface* b) {
+    int m = 0;
+    for (int y = 0; y < a->h; ++y) {
+        const Uint8* pa = (const Uint8*)a->pixels + (size_t)y * a->pitch;
+        const Uint8* pb = (const Uint8*)b->pixels + (size_t)y * b->pitch;
+        for (int i = 0; i < a->w * 4; ++i) m = SDL_max(m, abs(pa[i] - pb[i]));
+    }
+    return m;
+}
+
+static void sdl_fill(SDL_Renderer* r, SDL_Color c) {
+    SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(r, c.r, c.g, c.b, c.a);
+    SDL_RenderFillRect(r, NULL);
+    SDL_RenderFlush(r);
+}
+
+static double best_of(void (*fn)(void*), void* ud, SDL_Surface* frame) {
+    double best = 1e9;
+    for (int i = 0; i < RUNS; ++i) {
+        noise(frame, 7);
+        double t = now_ms();
+        fn(ud);
+        best = SDL_min(best, now_ms() - t);
+    }
+    return best;
+}
+
+typedef struct { SDL_Renderer* r; SDL_Surface* frame; SDL_Surface* small; SDL_Texture* small_tex;
+                 SDL_Color c; const SwcKernels* k; } Ctx;
+
+static void run_sdl_fill(void* ud)  { Ctx* x = (Ctx*)ud; sdl_fill(x->r, x->c); }
+static void run_swc_fill(void* ud)  { Ctx* x = (Ctx*)ud; swc_fill(x->frame, NULL, x->c, x->k); }
+static void run_sdl_copy(void* ud)  { Ctx* x = (Ctx*)ud; SDL_RenderCopy(x->r, x->small_tex, NULL, NULL); SDL_RenderFlush(x->r); }
+static void run_sdl_soft(void* ud)  { Ctx* x = (Ctx*)ud; SDL_SoftStretchLinear(x->small, NULL, x->frame, NULL); }
+static void run_swc_scale(void* ud) { Ctx* x = (Ctx*)ud; swc_scale(x->small, NULL, x->frame, NULL, x->k); }
+
+int main(int argc, char** argv) {
+    int w = 1920, h = 1080;
+    if (argc >= 3) { w = atoi(argv[1]); h = atoi(argv[2]); }
+    if (w < 16 || h < 16) { fprintf(stderr, "bad size %dx%d\n", w, h); return 1; }
+    if (SDL_Init(0) != 0) { fprintf(stderr, "SDL_Init: %s\n", SDL_GetError()); return 1; }
+    SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "linear");
+
+    const Uint32 fmt = SDL_PIXELFORMAT_ARGB8888;
+    const int sw = (int)(w * 0.75f + 0.5f), sh = (int)(h * 0.75f + 0.5f);
+    SDL_Surface* frame = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, fmt);
+    SDL_Surface* ref   = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, fmt);
+    SDL_Surface* out   = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, fmt);
+    SDL_Surface* small = SDL_CreateRGBSurfaceWithFormat(0, sw, sh, 32, fmt);
+    SDL_Renderer* r = frame ? SDL_CreateSoftwareRenderer(frame) : NULL;
+    if (!ref || !out || !small || !r) { fprintf(stderr, "setup failed: %s\n", SDL_GetError()); return 1; }
+    noise(small, 99);
+    SDL_Texture* small_tex = SDL_CreateTextureFromSurface(r, small);
+
+    const SDL_Color tint = { 150, 10, 20, 96 }, fade = { 0, 0, 0, 128 };
+    Ctx x = { r, frame, small, small_tex, tint, NULL };
+
+    printf("frame %dx%d, world %dx%d, best of %d runs (ms)\n", w, h, sw, sh, RUNS);
+    printf("%-22s %8s %8s %8s\n", "", "fill", "fade", "scale");
+
+    Row sdl = { "SDL software", 0, 0, 0 };
+    x.c = tint; sdl.fill = best_of(run_sdl_fill, &x, frame);
+    x.c = fade; sdl.fade = best_of(run_sdl_fill, &x, frame);
+    sdl.scale = small_tex ? best_of(run_sdl_copy, &x, frame) : 0.0;
+    printf("%-22s %8.2f %8.2f %8.2f\n", "SDL RenderFill/Copy", sdl.fill, sdl.fade, sdl.scale);
+    double soft = best_of(run_sdl_soft, &x, frame);
+    printf("%-22s %8s %8s %8.2f\n", "SDL_SoftStretchLinear", "-", "-", soft);
+
+    // еталони: заливка SDL і скалярне розтягування
+    SwcKernels scalar;
+    swc_kernels(SWC_SCALAR, &scalar);
+    noise(frame, 7); sdl_fill(r, tint); SDL_BlitSurface(frame, NULL, ref, NULL);
+    noise(frame, 7); swc_fill(frame, NULL, tint, &scalar);
+    int fill_vs_sdl = max_diff(frame, ref);
+    SDL_SoftStretchLinear(small, NULL, ref, NULL);
+    swc_scale(small, NULL, out, NULL, &scalar);
+    int scale_vs_sdl = max_diff(out, ref);
+
+    bool all_exact = true;
+    for (int kind = 0; kind < SWC_KIND_COUNT; ++kind) {
+        SwcKernels k;
+        if (!swc_kernels((SwcKind)kind, &k)) continue;
+        x.k = &k;
+        Row row = { k.name, 0, 0, 0 };
+        x.c = tint; row.fill  = best_of(run_swc_fill, &x, frame);
+        x.c = fade; row.fade  = best_of(run_swc_fill, &x, frame);
+        row.scale = best_of(run_swc_scale, &x, frame);
+        printf("%-22s %8.2f %8.2f %8.2f   (x%.1f / x%.1f / x%.1f vs SDL)\n", row.name, row.fill, row.fade, row.scale,
+               sdl.fill / row.fill, sdl.fade / row.fade, (sdl.scale > 0 ? sdl.scale : soft) / row.scale);
+
+        // той самий вхід -> ті самі байти, що й скалярне ядро
+        noise(frame, 7); swc_fill(frame, NULL, tint, &scalar); SDL_BlitSurface(frame, NULL, ref, NULL);
+        noise(frame, 7); swc_fill(frame, NULL, tint, &k);
+        int d_fill = max_diff(frame, ref);
+        swc_scale(small, NULL, ref, NULL, &scalar);
+        swc_scale(small, NULL, frame, NULL, &k);
+        int d_scale = max_diff(frame, ref);
+        if (d_fill || d_scale) {
+            all_exact = false;
+            printf("  %s differs from scalar: fill %d, scale %d\n", k.name, d_fill, d_scale);
+        }
+    }
+    printf("fill vs SDL blend: max diff %d (expected 0)\n", fill_vs_sdl);
+    printf("scale vs SDL_SoftStretchLinear: max diff %d\n", scale_vs_sdl);
+    printf("kernels identical to scalar: %s\n", all_exact ? "yes" : "NO");
+
+    swc_shutdown();
+    if (small_tex) SDL_DestroyTexture(small_tex);
+    SDL_DestroyRenderer(r);
+    SDL_FreeSurface(small); SDL_FreeSurface(out); SDL_FreeSurface(ref); SDL_FreeSurface(frame);
+    SDL_Quit();
+    return (fill_vs_sdl == 0 && all_exact) ? 0 : 1;
+}